@@ -0,0 +1,175 @@
+/* Filename: blobStore.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <list>
+#include <map>
+
+#define BLOB_CHUNK_SIZE (65536)
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Blob_Store {
+
+        /**
+         * @brief The ways an upload of a blob can end.
+        */
+        enum UploadResult {
+            JBU_STORED,    // The blob was stored, or an identical upload stored it first
+            JBU_CORRUPTED, // The bytes received do not match the size or the digest of the blob
+            JBU_NO_ROOM,   // The blobs in use by running jobs leave no room for the blob in the budget
+            JBU_FAILED     // The client went away or the blob could not be written
+        };
+
+        /**
+         * @brief A blob of the store, which is named by the digest of its contents.
+        */
+        typedef struct Application_Blob {
+
+            unsigned long size;                         // The size of the blob in bytes
+            unsigned int references;                    // The running jobs that have the blob in their working directory
+            std::list<std::string>::iterator position;  // The position of the blob in the least recently used order
+
+        } Blob;
+
+        /**
+         * @brief Public Static class that keeps the blobs that the clients upload for their jobs, so that the
+         * same reference files are sent to the server once instead of with every job. A blob is a read-only
+         * file of the blob directory named by its SHA-256 digest. A client asks whether the server has a blob
+         * with 'have <digest>', and 'upload' sends only a blob the server does not have, which the server
+         * hashes as it arrives and stores only if it matches its digest.
+         *
+         * A job issued with '--blobs name=digest,...' runs in a working directory of its own, where every
+         * blob it names is a private copy with the given name. A running job holds a reference to each of
+         * its blobs, and its working directory is removed when it ends. The blobs take at most the blob budget
+         * of the server on disk, and a blob that does not fit evicts the least recently used blobs that no
+         * running job refers to. The blob directory outlives the server, so the blobs are uploaded only once.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Store {
+
+        private:
+
+            static std::map<std::string, Blob> blobs;                              // The stored blobs by their digest
+            static std::list<std::string> recentlyUsed;                            // The digests of the blobs, the most recently used first
+            static unsigned long storedBytes;                                      // The bytes the blobs take
+            static std::map<std::string, std::map<std::string, std::string>> pins; // The blobs of every running job by their file name, by its job ID
+            static unsigned long nextUpload;                                       // Tells apart the files of uploads that are still in progress
+
+            /**
+             * @brief Returns the path of the file of a blob.
+             *
+             * @param digest the digest of the blob
+             *
+             * @return the path of the blob
+            */
+            static std::string getBlobPath(const std::string& digest);
+
+            /**
+             * @brief Returns the path of the working directory of a job.
+             *
+             * @param jobID the job ID of the job
+             *
+             * @return the path of the working directory
+            */
+            static std::string getWorkDirectory(const std::string& jobID);
+
+            /**
+             * @brief Adds a blob to the index of the store as the most recently used one. The caller must
+             * hold the blob mutex of the server.
+             *
+             * @param digest the digest of the blob
+             * @param size the size of the blob
+            */
+            static void add(const std::string& digest, const unsigned long size);
+
+            /**
+             * @brief Makes room for a blob of the given size in the budget, evicting the least recently used
+             * blobs that no running job refers to. Nothing is evicted if the blob would not fit anyway. The
+             * caller must hold the blob mutex of the server.
+             *
+             * @param size the size of the blob
+             *
+             * @return true if the blob fits, false otherwise
+            */
+            static bool makeRoom(const unsigned long size);
+
+        public:
+
+            /**
+             * @brief Creates the blob directory, or indexes the blobs that a previous run of the server left
+             * in it, and drops the unfinished uploads and working directories it left.
+             *
+             * @return true if the store is ready, false otherwise
+            */
+            static bool load(void);
+
+            /**
+             * @brief Returns whether the server has a blob, which counts as a use of the blob.
+             *
+             * @param digest the digest of the blob
+             *
+             * @return true if the blob is stored, false otherwise
+            */
+            static bool has(const std::string& digest);
+
+            /**
+             * @brief Returns whether a blob of the given size can ever be stored.
+             *
+             * @param size the size of the blob
+             *
+             * @return true if the blob fits in the budget, false otherwise
+            */
+            static bool canStore(const unsigned long size);
+
+            /**
+             * @brief Receives a blob that a client uploads on its socket, as data frames ended by an empty
+             * frame, and stores it if it matches its size and digest.
+             *
+             * @param socketID the socket of the client
+             * @param digest the digest of the blob
+             * @param size the size of the blob
+             *
+             * @return how the upload ended
+            */
+            static UploadResult upload(const int socketID, const std::string& digest, const unsigned long size);
+
+            /**
+             * @brief Creates the working directory of a job and copies every blob of the job into it. The job
+             * holds a reference to each of its blobs until it is released.
+             *
+             * @param jobID the job ID of the job
+             * @param links the digests of the blobs of the job, by the file names they get
+             * @param directory the path of the working directory
+             * @param missing the digest of a blob that is not stored, if there is one
+             *
+             * @return true if the working directory is ready, false otherwise
+            */
+            static bool acquire(const std::string& jobID, const std::map<std::string, std::string>& links, std::string& directory, std::string& missing);
+
+            /**
+             * @brief Removes the working directory of a job that has ended and drops its references to its
+             * blobs. A job that holds no blobs is ignored.
+             *
+             * @param jobID the job ID of the job
+            */
+            static void release(const std::string& jobID);
+
+            /**
+             * @brief Returns the number of the stored blobs, the bytes they take and how many of them are
+             * used by running jobs.
+             *
+             * @param count the number of blobs
+             * @param bytes the bytes the blobs take
+             * @param inUse the number of blobs used by running jobs
+            */
+            static void getStats(unsigned long& count, unsigned long& bytes, unsigned long& inUse);
+
+        };
+
+    }
+
+}
@@ -4,6 +4,9 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <map>
+#include <ctime>
 
 namespace Application_Job_Commander_Client {
 
@@ -18,15 +21,57 @@ namespace Application_Job_Commander_Client {
         typedef enum Application_Client_Command_Mode {
             
             JECC_ISSUE_JOB,       // Stands for 'issueJob <job>' command
+            JECC_ISSUE_JOB_ARRAY, // Stands for 'issueJobArray <job> <first>..<last>' command
             JECC_SET_CONCURRENCY, // Stands for 'setConcurrency <N>' command
             JECC_STOP,            // Stands for 'stop <jobID>' command
             JECC_POLL,            // Stands for 'stop [running, queued]' command
+            JECC_STATS,           // Stands for 'stats' command
+            JECC_RESULT,          // Stands for 'result <jobID>' command
+            JECC_WATCH,           // Stands for 'watch [all, tag <tag>, <jobID>,<jobID>...]' command
+            JECC_HAVE,            // Stands for 'have <digest>' command
+            JECC_UPLOAD,          // Stands for 'upload <digest> <size>' command, which the client sends for 'upload <file>'
             JECC_EXIT,            // Stands for 'exit' command, in order to terminate the server
 
             JECC_INVALID // Stands for invalid command mode
         
         } CC_Mode;
 
+        /**
+         * @brief Public struct that holds the options a client can give to a job on submission, in the
+         * form of '--option value' pairs placed before the actual job, e.g. 'issueJob --cpus 4 make -j4'.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        typedef struct Application_Client_Command_Job_Options {
+
+            unsigned int cpus;                     // The number of CPUs the job requests (--cpus)
+            unsigned long memory;                  // The amount of memory in MB the job requests (--mem)
+            unsigned int priority;                 // The priority of the job, higher values are more urgent (--priority)
+            std::vector<std::string> dependencies; // The job IDs that must succeed before the job runs (--after)
+            time_t startTime;                      // The time the job should run at, 0 to run it now (--at)
+            unsigned long period;                  // The period in seconds of a recurring job, 0 to run it once (--every)
+            bool streamOutput;                     // Whether the output is streamed while the job runs (--output stream)
+            unsigned long wallLimit;               // The seconds the job can run for, 0 for the default of the server (--timeout)
+            unsigned long cpuLimit;                // The CPU seconds the job can use, 0 for the default of the server (--cpu-limit)
+            unsigned long memoryLimit;             // The address space in MB the job can use, 0 for the default of the server (--mem-limit)
+            unsigned long outputLimit;             // The bytes of output the job can write, 0 for the default of the server (--output-limit)
+            bool cacheable;                        // Whether the output of the job can be reused by a job with the same arguments (--cacheable yes)
+            bool cacheInputs;                      // Whether a reused output is dropped when a file named by the arguments changes (--cacheable inputs)
+            bool coalesce;                         // Whether the job shares the output of an identical job in flight (--coalesce yes)
+            bool detach;                           // Whether the client leaves right away and fetches the result later (--detach yes)
+            std::string tag;                       // The tag of the job, that clients can watch the ends of the jobs by (--tag)
+            unsigned long headLines;               // The number of first lines of the output that are sent, 0 for all (--head)
+            unsigned long tailLines;               // The number of last lines of the output that are sent, 0 for all (--tail)
+            std::string lineFilter;                // The string the sent lines of the output contain, empty for all (--grep, --grep-regex)
+            bool filterIsRegex;                    // Whether the line filter is an extended regular expression (--grep-regex)
+            unsigned long maxBytes;                // The number of bytes of the output that are sent at most, 0 for all (--max-bytes)
+            bool compress;                         // Whether the client can decompress the output, so it may be sent compressed (--compress yes)
+            bool cancelOnDisconnect;               // Whether the job is stopped even while running, if its client goes away (--on-disconnect cancel|keep)
+            std::string input;                     // Where the standard input of the job is streamed from, empty for none (--input)
+            std::map<std::string, std::string> blobs; // The digests of the blobs in the working directory of the job, by their file names (--blobs)
+
+        } JobOptions;
+
         /**
          * @brief Public struct that represents the client command job triplate, which holds the appropriate
          * data for a job. The jobID, the full job and the connection socket ID.
@@ -35,9 +80,14 @@ namespace Application_Job_Commander_Client {
         */
         typedef struct Application_Client_Command_Job_Triplate {
 
-            std::string jobID; // The job ID of the client command job
-            std::string job;   // The actual job of the client command
-            int socketID;      // The socket ID on which the connection was occured
+            std::string jobID;       // The job ID of the client command job
+            std::string job;         // The actual job of the client command
+            int socketID;            // The socket ID on which the connection was occured
+            JobOptions options;      // The options given to the job on submission
+            bool isArray;            // Whether the triplate is a job array, expanded one task at a time by the workers
+            unsigned long arrayNext; // The index of the next task of the job array
+            unsigned long arrayLast; // The index of the last task of the job array
+            time_t submitTime;       // The time the job was submitted at
 
         } JobTriplate;
 
@@ -55,6 +105,29 @@ namespace Application_Job_Commander_Client {
 */
 Application_Job_Commander_Client::Application_Client_Commands::CC_Mode getClientCommandMode(const std::string command);
 
+/**
+ * @brief Strips the leading '--option value' pairs from the given job string and stores them in the
+ * given job options. Parsing stops at the first word that is not an option, which is the executable
+ * of the job. Options that are not given keep their default values.
+ * 
+ * @param job the job string, which contains only the actual command after the call
+ * @param options the options of the job
+ * 
+ * @return true if every option was valid, false otherwise
+*/
+bool parseJobOptions(std::string& job, Application_Job_Commander_Client::Application_Client_Commands::JobOptions& options);
+
+/**
+ * @brief Strips the index range '<first>..<last>' from the end of the given job array string.
+ * 
+ * @param job the job array string, which contains only the job template after the call
+ * @param first the first index of the range
+ * @param last the last index of the range
+ * 
+ * @return true if the range was valid, false otherwise
+*/
+bool parseJobArrayRange(std::string& job, unsigned long& first, unsigned long& last);
+
 /**
  * @brief Overloading operator << function that is being used to print a specific client command job
  * triplate to the tty.
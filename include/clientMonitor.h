@@ -0,0 +1,105 @@
+/* Filename: clientMonitor.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <pthread.h>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Client_Monitor {
+
+        /**
+         * @brief The job a watched client connection waits for.
+        */
+        typedef struct Application_Watched_Job {
+
+            std::string jobID;  // The job ID of the job, or of the job array
+            bool cancelRunning; // Whether the job is stopped even while running, if its client goes away
+            unsigned long outputs; // The outputs the client still waits for, one for every task of a job array, 0 for a recurring job
+
+        } WatchedJob;
+
+        /**
+         * @brief Public Static class that watches the connections of the clients that wait for their jobs,
+         * and drops the work of a client that goes away. A client that is killed while its job waits would
+         * otherwise have the job run anyway, only for its output to be written to a dead socket.
+         *
+         * The monitor thread waits for the hangup of every watched socket (EPOLLRDHUP), or for an error on it
+         * (EPOLLHUP, EPOLLERR). The job of a client that hangs up is removed from wherever it waits, like a
+         * stopped job, so that it never takes a slot. A job that is already running keeps running, unless it
+         * was issued with '--on-disconnect cancel', in which case it is stopped along with every running task
+         * of a job array. A socket is no longer watched once its client has got the last output it waits for,
+         * as there is nothing left to drop after that.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Monitor {
+
+        private:
+
+            static int epollFD;
+            static std::map<int, WatchedJob> clients; // The watched connections, by their socket
+            static bool stopping;                     // True once the monitor must stop
+            static pthread_t monitorThread;
+
+            /**
+             * @brief Drops the work of a client that has gone away. Its job is removed if it has not
+             * started running yet, and its running job or tasks are stopped if they were issued with
+             * the cancel on disconnect policy.
+             *
+             * @param socketID the socket of the client
+             * @param watched the job the client was waiting for
+            */
+            static void dropAbandonedJob(const int socketID, const WatchedJob& watched);
+
+            /**
+             * @brief Monitor Thread function. It waits for the watched clients to hang up and drops
+             * their work, until it is stopped.
+             *
+             * @param arg unused
+             *
+             * @return anything
+            */
+            static void* MonitorThread(void* arg);
+
+        public:
+
+            /**
+             * @brief Creates the monitor thread.
+             *
+             * @return true if the monitor was started successfully, false otherwise
+            */
+            static bool start(void);
+
+            /**
+             * @brief Stops the monitor thread.
+            */
+            static void stop(void);
+
+            /**
+             * @brief Starts watching the connection of a client that waits for a job that has just
+             * been submitted.
+             *
+             * @param socketID the socket of the client
+             * @param jobID the job ID of the job
+             * @param cancelRunning whether the job is stopped even while running, if the client goes away
+             * @param outputs the outputs the client waits for, one for every task of a job array, 0 for a recurring job
+            */
+            static void watch(const int socketID, const std::string& jobID, const bool cancelRunning, const unsigned long outputs);
+
+            /**
+             * @brief Counts the end of a job, or of a task of a job array, towards the outputs its client
+             * waits for, and stops watching the connection of the client once it has got the last one.
+             *
+             * @param jobID the job ID of the job, or of the task of a job array
+            */
+            static void release(const std::string& jobID);
+
+        };
+
+    }
+
+}
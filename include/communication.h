@@ -21,6 +21,28 @@ namespace Application_Client_Server_Communication {
         */
         bool receiveIssueJobResponse(const int socketID, std::string& serverResponse);
 
+        /**
+         * @brief Handles receiving the output of a job issued with '--output stream'. The output
+         * arrives as a start marker, data frames that are printed as soon as they arrive, an empty
+         * frame and an end marker.
+         * 
+         * @param socketID the id of the socket used for communication
+         * 
+         * @return true if the whole output was received successfully, false otherwise 
+        */
+        bool receiveStreamedJobOutput(const int socketID);
+
+        /**
+         * @brief Handles receiving the completion events of a 'watch' command. The confirmation of
+         * the server and every message of events are printed as soon as they arrive, until the watch
+         * ends, the server terminates or rejects the watch.
+         * 
+         * @param socketID the id of the socket used for communication
+         * 
+         * @return true if the watch ended normally, false otherwise 
+        */
+        bool receiveWatchEvents(const int socketID);
+
         /**
          * @brief Handles to receive the server response, in case the client command to the server
          * was to set the concurrency. Then the corresponding response of the server has to be a message
@@ -57,6 +79,44 @@ namespace Application_Client_Server_Communication {
         */
         bool receiveStopResponse(const int socketID, std::string& serverResponse);
 
+        /**
+         * @brief Handles to receive the server response, in case the client command to the server
+         * was to get the stats of the server. Then the corresponding response of the server has to be
+         * a message with a report of the server.
+         * 
+         * @param socketID the id of the socket used for communication
+         * @param serverResponse the response of the server
+         * 
+         * @return true if the response was received successfully, false otherwise 
+        */
+        bool receiveStatsResponse(const int socketID, std::string& serverResponse);
+
+        /**
+         * @brief Handles to receive the server response, in case the client command to the server
+         * was to get the result of a detached job. Then the corresponding response of the server has
+         * to be the output of the job along with its exit code and timings, or a message saying the
+         * job has not finished yet or its result was not found.
+         * 
+         * @param socketID the id of the socket used for communication
+         * @param serverResponse the response of the server
+         * 
+         * @return true if the response was received successfully, false otherwise 
+        */
+        bool receiveResultResponse(const int socketID, std::string& serverResponse);
+
+        /**
+         * @brief Handles to receive the server response, in case the client command to the server
+         * was to check for or upload a blob. Then the corresponding response of the server has to be
+         * a message saying whether the server has the blob, is ready to receive it or has stored it,
+         * or why the upload was rejected.
+         * 
+         * @param socketID the id of the socket used for communication
+         * @param serverResponse the response of the server
+         * 
+         * @return true if the response was received successfully, false otherwise 
+        */
+        bool receiveBlobResponse(const int socketID, std::string& serverResponse);
+
         /**
          * @brief Handles to receive the server response, in case the client command to the server
          * was to exit. Then the corresponding response of the server has to be a message
@@ -0,0 +1,142 @@
+/* Filename: completionEvents.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <sys/types.h>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Completion_Events {
+
+        /**
+         * @brief The jobs a watching client is subscribed to.
+        */
+        typedef enum Application_Watch_Kind {
+            CEW_ALL,  // Every job ('watch all')
+            CEW_TAG,  // The jobs issued with a specific tag ('watch tag <tag>')
+            CEW_JOBS  // A set of jobs and job arrays ('watch <jobID>,<jobID>...')
+        } WatchKind;
+
+        /**
+         * @brief The end of a job, as it is pushed to the watching clients.
+        */
+        typedef struct Application_Completion_Event {
+
+            std::string jobID;  // The job ID of the job, or of the task of a job array
+            std::string tag;    // The tag the job was issued with, empty if it has none
+            bool ran;           // Whether the job ran, false if it was removed or canceled before it could run
+            bool succeeded;     // Whether the job finished successfully
+            int exitCode;       // The exit code of the job, or -1 if it is unknown
+            time_t runtime;     // The seconds the job ran for
+            ssize_t outputSize; // The bytes of output of the job, or -1 if it was streamed
+
+        } CompletionEvent;
+
+        /**
+         * @brief A client connection subscribed to the completion events of some jobs.
+        */
+        typedef struct Application_Subscription {
+
+            int socketID;                    // The socket of the client
+            WatchKind kind;                  // Which jobs the client watches
+            std::string tag;                 // The tag of the watched jobs, if the kind is CEW_TAG
+            std::vector<std::string> jobIDs; // The watched jobs, if the kind is CEW_JOBS
+
+        } Subscription;
+
+        /**
+         * @brief Public Static class that pushes the completion events of the jobs to the clients that
+         * watch them. A client issues 'watch' once, and its connection stays subscribed to the events of
+         * the jobs it watches, instead of keeping a blocked connection per job or polling the server.
+         *
+         * The ends of the jobs are queued and the publisher thread sends them, so a finishing job never
+         * waits for a slow client. Every event is a single line, and the events that are queued together,
+         * such as the ends of jobs that finish at once, are sent to a client as a single message. A watch
+         * on a set of jobs ends on its own once all of them have finished, and every watch ends when the
+         * server terminates or the client goes away.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Publisher {
+
+        private:
+
+            static std::vector<Subscription> subscriptions; // The watching clients
+            static std::vector<CompletionEvent> pending;     // The events that have not been sent yet
+            static bool stopping;                            // True once the publisher must stop
+            static pthread_t publisherThread;
+
+            /**
+             * @brief Returns whether the given event is one of the events the given client watches.
+             * A task of a job array belongs to the job array.
+             *
+             * @param subscription the subscription of the client
+             * @param event the completion event
+             *
+             * @return true if the client watches the event, false otherwise
+            */
+            static bool matches(const Subscription& subscription, const CompletionEvent& event);
+
+            /**
+             * @brief Returns whether every job of a watch on a set of jobs has finished. The caller must
+             * hold the events mutex of the server.
+             *
+             * @param subscription the subscription of the client
+             *
+             * @return true if the watch has ended, false otherwise
+            */
+            static bool hasEnded(const Subscription& subscription);
+
+            /**
+             * @brief Publisher Thread function. It sends the queued events to the clients that watch them,
+             * until it is stopped.
+             *
+             * @param arg unused
+             *
+             * @return anything
+            */
+            static void* PublisherThread(void* arg);
+
+        public:
+
+            /**
+             * @brief Creates the publisher thread.
+             *
+             * @return true if the publisher was started successfully, false otherwise
+            */
+            static bool start(void);
+
+            /**
+             * @brief Stops the publisher thread, once the queued events have been sent, and ends every watch.
+            */
+            static void stop(void);
+
+            /**
+             * @brief Subscribes a client to the completion events of the given jobs and confirms it to the
+             * client. Every job of a watch on a set of jobs must have been submitted, and the ones that have
+             * already finished are reported right away.
+             *
+             * @param subscription the subscription of the client
+             * @param unknownID the first job ID that was never submitted, if any
+             *
+             * @return true if the client was subscribed, false if a job ID is unknown
+            */
+            static bool subscribe(const Subscription& subscription, std::string& unknownID);
+
+            /**
+             * @brief Queues the completion event of a job that has ended. It must be called once the end of
+             * the job has been recorded in the dependency graph.
+             *
+             * @param event the completion event
+            */
+            static void publish(const CompletionEvent& event);
+
+        };
+
+    }
+
+}
@@ -33,9 +33,10 @@ namespace Application_Job_Executor_Server {
             static unsigned int jobsEntered;
 
             /**
-             * @brief Handles the issueJob client command. It receives the full command of the
-             * client, determines what the bash job is and puts it to the common queue buffer
-             * to be executed later on by a worker thread.
+             * @brief Handles the issueJob and issueJobArray client commands. It receives the full
+             * command of the client, determines what the bash job is and puts it to the common queue
+             * buffer to be executed later on by a worker thread. A job array takes a single position
+             * in the buffer, no matter how many tasks it has.
              * 
              * @return true, if the process was successfull, false otherwise
             */
@@ -51,16 +52,63 @@ namespace Application_Job_Executor_Server {
 
             /**
              * @brief Handles the poll client command. It iterates through the waiting buffer
-             * queue, and sends each individual job triplate back to the client.
+             * queue, and sends each individual job triplate back to the client. With 'poll running'
+             * it sends the running jobs instead, along with how long they have been running.
              * 
              * @return true, if the process was successfull, false otherwise
             */
             bool sendWaitingJobsToClient(void);
 
+            /**
+             * @brief Handles the stats client command. It sends back a report of the server with its
+             * running and queued jobs, the hit rate of the executable cache of the launcher, the
+             * hit rate and the size of the result cache, the coalescing ratio of the identical jobs
+             * and the size of the blob store.
+             * 
+             * @return true, if the process was successfull, false otherwise
+            */
+            bool sendServerStatsToClient(void);
+
+            /**
+             * @brief Handles the result client command. It sends back the output of a detached job along
+             * with its exit code and how long it waited and ran, or why it did not run, as many times as
+             * it is asked for until the result expires or is evicted.
+             * 
+             * @return true, if the process was successfull, false otherwise
+            */
+            bool sendJobResultToClient(void);
+
+            /**
+             * @brief Handles the watch client command. It subscribes the connection of the client to the
+             * completion events of every job, of the jobs with a tag, or of a set of jobs, and hands the
+             * connection over to the publisher, which pushes the events to it as the jobs end.
+             * 
+             * @return true, if the process was successfull, false otherwise
+            */
+            bool subscribeClientToEvents(void);
+
+            /**
+             * @brief Handles the have client command. It tells the client whether the blob store of the
+             * server has a blob, so that the client uploads only the blobs the server does not have.
+             * 
+             * @return true, if the process was successfull, false otherwise
+            */
+            bool checkClientBlob(void);
+
+            /**
+             * @brief Handles the upload client command. It tells the client to send a blob the server does
+             * not have and fits in the blob budget, receives it and tells the client whether it was stored.
+             * 
+             * @return true, if the process was successfull, false otherwise
+            */
+            bool storeClientBlob(void);
+
             /**
              * @brief Handles the stop client command. It itrates through the waiting buffer
              * queue, until it finds the job specified to be removed from the buffer, according
-             * to its job ID.
+             * to its job ID. Jobs blocked on their dependencies and delayed or recurring jobs can
+             * be stopped as well, and the jobs depending on a stopped job are canceled. A running job
+             * is sent SIGTERM, and SIGKILL if it has not exited after the grace period of the server.
              * 
              * @return true, if the process was successfull, false otherwise
             */
@@ -78,6 +126,31 @@ namespace Application_Job_Executor_Server {
 
             static bool shouldStop;
 
+            /**
+             * @brief Removes a job that has not started running yet from wherever it waits, the waiting buffer
+             * queue, the blocked jobs of the dependency graph, the timer wheel or the jobs attached to an identical
+             * coalescing job. When a queued coalescing job is removed the first job attached to it is queued in its
+             * place. The client of the job is sent the given notification, and the jobs depending on it are canceled.
+             * 
+             * @param jobID the job ID of the job to remove
+             * @param notification the message the client of the job is sent
+             * 
+             * @return true if the job was found and removed, false otherwise
+            */
+            static bool removeWaitingJob(const std::string jobID, const std::string notification);
+
+            /**
+             * @brief Stops a running job. The whole process group of the job is sent
+             * SIGTERM, and a suspended job is continued so that it can handle it. The slot, the CPUs and the cores
+             * of the job are given back right away, so that a waiting job can start, and the supervisor kills the job
+             * if it is still running after the grace period of the server.
+             * 
+             * @param jobID the job ID of the job to stop
+             * 
+             * @return true if the job was running and has been stopped, false otherwise
+            */
+            static bool stopRunningJob(const std::string jobID);
+
             /**
              * @brief Constructor of the Controller Thread. It stores the socket of the client
              * that is being used for communication with the client.
@@ -0,0 +1,172 @@
+/* Filename: cpuPlacement.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sched.h>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Cpu_Placement {
+
+        /**
+         * @brief The policies the jobs are placed on the cores of the machine by.
+        */
+        enum Policy {
+            CPL_NONE,    // The jobs are not placed, so they float across all the cores
+            CPL_COMPACT, // The jobs are packed on the least busy cores with the lowest numbers, filling one NUMA node before the next
+            CPL_SPREAD,  // The cores of the jobs are spread across the NUMA nodes, so that every node is equally busy
+            CPL_NUMA     // Every job is kept inside a single NUMA node, so that its memory stays local to its cores
+        };
+
+        /**
+         * @brief A core of the machine the jobs can be placed on.
+        */
+        typedef struct Application_Core {
+
+            int cpu;           // The number of the core
+            int node;          // The NUMA node of the core
+            unsigned int load; // The number of running jobs placed on the core
+
+        } Core;
+
+        /**
+         * @brief Public Static class that places the jobs on the cores of the machine. Every job that is
+         * launched is given a set of cores, as many as the CPUs it has reserved, and the launcher restricts
+         * the job to them with sched_setaffinity() before its exec(). The engine counts the running jobs
+         * placed on every core, so that concurrent jobs are given different cores while there are idle ones.
+         *
+         * The cores are the ones the server itself is allowed to run on, and their NUMA nodes are read from
+         * /sys/devices/system/node. Memory is allocated on the node of the core that first touches it, so
+         * a job that is kept inside a node also gets its memory from it. The methods of this class are not
+         * synchronized, so the caller must hold the worker mutex of the server.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Engine {
+
+        private:
+
+            static Policy policy;            // The placement policy of the server
+            static std::vector<Core> cores;  // The cores the jobs can be placed on, by number
+            static int nodes;                // The number of NUMA nodes of the cores
+
+            /**
+             * @brief Reads the NUMA node of every core from /sys/devices/system/node. Every core is on
+             * node 0 if the machine does not report its nodes.
+            */
+            static void readNodes(void);
+
+            /**
+             * @brief Selects the given number of cores, packed on the least busy cores with the lowest numbers.
+             *
+             * @param count the number of cores to select
+             * @param selected the cores that were selected
+            */
+            static void placeCompact(const unsigned int count, std::vector<int>& selected);
+
+            /**
+             * @brief Selects the given number of cores, one at a time from the least busy node.
+             *
+             * @param count the number of cores to select
+             * @param selected the cores that were selected
+            */
+            static void placeSpread(const unsigned int count, std::vector<int>& selected);
+
+            /**
+             * @brief Selects the given number of cores inside the NUMA node whose least busy cores are the
+             * least busy. Among equally busy nodes the one with the fewest idle cores is chosen, so that whole
+             * nodes are left for bigger jobs. A job that does not fit in any node is placed compactly.
+             *
+             * @param count the number of cores to select
+             * @param selected the cores that were selected
+            */
+            static void placeNuma(const unsigned int count, std::vector<int>& selected);
+
+        public:
+
+            /**
+             * @brief Initializes the placement engine with the given policy and finds the cores the jobs
+             * can be placed on. It must be called before any thread of the server is created.
+             *
+             * @param policyName the name of the placement policy, none, compact, spread or numa
+             *
+             * @return true if the policy is known, false otherwise
+            */
+            static bool init(const std::string& policyName);
+
+            /**
+             * @brief Returns whether the jobs are placed on cores.
+             *
+             * @return true if a placement policy is set, false otherwise
+            */
+            static bool isEnabled(void);
+
+            /**
+             * @brief Places a job that is about to be launched on the given number of cores, according to the
+             * placement policy, and marks them busy. A job asking for more CPUs than there are cores gets all
+             * of them. Nothing is placed if placement is disabled.
+             *
+             * @param cpus the number of CPUs the job has reserved
+             * @param selected the cores the job was placed on
+            */
+            static void place(const unsigned int cpus, std::vector<int>& selected);
+
+            /**
+             * @brief Marks the cores of a job busy again, when the job is resumed on them.
+             *
+             * @param selected the cores of the job
+            */
+            static void claim(const std::vector<int>& selected);
+
+            /**
+             * @brief Marks the cores of a job free, when the job finishes or stops using them.
+             *
+             * @param selected the cores of the job
+            */
+            static void release(const std::vector<int>& selected);
+
+            /**
+             * @brief Returns whether no running job is placed on any of the given cores.
+             *
+             * @param selected the cores of the job
+             *
+             * @return true if all the cores are free, false otherwise
+            */
+            static bool isFree(const std::vector<int>& selected);
+
+            /**
+             * @brief Moves every thread of every process of a job that is already running to the given
+             * cores, when the job has to continue on other cores than the ones it was launched on.
+             *
+             * @param processGroup the process group of the job
+             * @param selected the new cores of the job
+             *
+             * @return true if the job was moved, false otherwise
+            */
+            static bool movePlacedJob(const pid_t processGroup, const std::vector<int>& selected);
+
+            /**
+             * @brief Fills the CPU set the launcher restricts a job to with the given cores.
+             *
+             * @param selected the cores of the job
+             * @param set the CPU set of the cores, empty if there are none
+            */
+            static void getCpuSet(const std::vector<int>& selected, cpu_set_t& set);
+
+            /**
+             * @brief Formats the given cores as a list of numbers and ranges, e.g. '0-3,8'.
+             *
+             * @param selected the cores of the job
+             *
+             * @return the formatted cores
+            */
+            static std::string format(const std::vector<int>& selected);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,141 @@
+/* Filename: dependencyGraph.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "clientCommands.h"
+
+/* Namespace Alias */
+namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Job_Dependencies {
+
+        /**
+         * @brief Enumeration that contains all the possible states of a job inside the dependency graph.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        typedef enum Application_Job_Dependency_State {
+
+            JDS_PENDING,   // The job has been submitted but has not finished yet
+            JDS_SUCCEEDED, // The job has finished successfully
+            JDS_FAILED     // The job has failed, or it was stopped or canceled before it could run
+
+        } State;
+
+        /**
+         * @brief Enumeration that contains all the possible results of adding a new job to the dependency graph.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        typedef enum Application_Job_Dependency_Admission {
+
+            JDA_READY,   // Every dependency has succeeded, so the job can be placed in the waiting buffer
+            JDA_BLOCKED, // The job waits in the blocked set until its dependencies succeed
+            JDA_FAILED,  // A dependency has already failed, so the job will never run
+            JDA_UNKNOWN  // A dependency refers to a job ID that was never submitted
+
+        } Admission;
+
+        /**
+         * @brief Public struct that represents a job whose dependencies have not all finished yet.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        typedef struct Application_Blocked_Job {
+
+            CC::JobTriplate triplate;  // The triplate of the blocked job
+            unsigned int pendingCount; // The number of dependencies that have not finished yet
+
+        } BlockedJob;
+
+        /**
+         * @brief Public Static class that represents the dependency graph of the jobs submitted with
+         * the '--after' option. Jobs with unfinished dependencies stay in a blocked set, and the edges
+         * from every job to the jobs depending on it are indexed, so that the end of a job releases or
+         * cancels its dependents in time proportional to their number. The methods of this class are
+         * synchronized with the dependencies mutex of the server.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Graph {
+
+        private:
+
+            static std::map<std::string, State> states;                        // The state of every submitted job
+            static std::map<std::string, std::vector<std::string>> dependents; // The jobs depending on every job
+            static std::map<std::string, BlockedJob> blocked;                  // The blocked jobs by job ID
+            static std::map<std::string, unsigned long> arrayTasks;            // The unfinished tasks of every job array
+
+            /**
+             * @brief Marks the given job as failed and cancels every blocked job depending on it,
+             * recursively. The caller must hold the dependencies mutex of the server.
+             * 
+             * @param jobID the job ID of the failed job
+             * @param canceled the triplates of the blocked jobs that were canceled
+            */
+            static void failJob(const std::string jobID, std::vector<CC::JobTriplate>& canceled);
+
+        public:
+
+            /**
+             * @brief Adds a newly submitted job to the dependency graph and determines whether it can
+             * run right away. If it has to wait for its dependencies, it is placed in the blocked set.
+             * 
+             * @param triplate the triplate of the new job
+             * 
+             * @return the admission result of the job
+            */
+            static Admission addJob(const CC::JobTriplate& triplate);
+
+            /**
+             * @brief Records the end of a job. If the job succeeded, its blocked dependents whose last
+             * dependency it was are released, otherwise all its blocked dependents are canceled. The end
+             * of a task 'job_N[i]' counts towards its job array, which succeeds when all of its tasks
+             * have succeeded and fails with its first failed task.
+             * 
+             * @param taskID the job ID of the finished job, or of the finished task of a job array
+             * @param succeeded whether the job finished successfully
+             * @param released the triplates of the jobs that can now be placed in the waiting buffer
+             * @param canceled the triplates of the blocked jobs that were canceled
+            */
+            static void finishJob(const std::string taskID, const bool succeeded, std::vector<CC::JobTriplate>& released, std::vector<CC::JobTriplate>& canceled);
+
+            /**
+             * @brief Searches for the blocked job with the specific job ID and if it is found, it
+             * removes it from the blocked set.
+             * 
+             * @param jobID the job ID of the job to remove
+             * @param triplate the triplate that has been removed
+             * 
+             * @return true if the job ID was found, false otherwise
+            */
+            static bool removeBlockedJob(const std::string jobID, CC::JobTriplate& triplate);
+
+            /**
+             * @brief Removes every job of the blocked set.
+             * 
+             * @param triplates the triplates of the jobs that were removed
+            */
+            static void removeAllBlockedJobs(std::vector<CC::JobTriplate>& triplates);
+
+            /**
+             * @brief Returns the state of the job with the specific job ID.
+             * 
+             * @param jobID the job ID of the job
+             * @param state the state of the job
+             * 
+             * @return true if the job ID was ever submitted, false otherwise
+            */
+            static bool getState(const std::string jobID, State& state);
+
+        };
+
+    }
+
+}
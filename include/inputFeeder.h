@@ -0,0 +1,120 @@
+/* Filename: inputFeeder.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <pthread.h>
+#include <sys/types.h>
+
+#define INPUT_CHUNK_SIZE (65536)
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Input_Feeder {
+
+        /**
+         * @brief An input that a client streams to the standard input of its running job.
+        */
+        typedef struct Application_Input_Feed {
+
+            std::string jobID;
+            int pipeFD;             // The write end of the input pipe of the job, -1 once the job has closed it
+            ssize_t frameLeft;      // The bytes of the current data frame that are still to be moved, 0 between frames
+            bool waitingForPipe;    // True while the pipe is full, so the socket is not read until the job catches up
+            unsigned long fed;      // The bytes of input moved to the job so far
+
+        } Feed;
+
+        /**
+         * @brief Public Static class that feeds the inputs of the jobs issued with '--input'. The standard
+         * input of such a job is a pipe, and the feeder thread moves what the client sends on its socket
+         * into the pipe with splice(), so the input never touches the disk or a buffer of the server.
+         *
+         * The client sends its input right after the submission response, as a number of data frames and
+         * an empty frame, where every frame is a size and that many bytes, like every other message. The
+         * pipe closes at the empty frame, so the job sees the end of its input. A pipe holds only a little
+         * data, and while it is full the socket is not read, so a job that reads slowly holds back its client
+         * through the flow control of the connection instead of having its input piled up in the server.
+         * The rest of the input of a job that closes its standard input early is read and dropped.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Feeder {
+
+        private:
+
+            static int epollFD;
+            static std::map<int, Feed> feeds; // The inputs by the socket of their client
+            static bool stopping;
+            static pthread_t feederThread;
+
+            /**
+             * @brief Moves the next frame header or chunk of input of the given feed from its client to
+             * its job, or ends the input once the empty frame arrives or the client has gone away.
+             *
+             * @param socketID the socket of the client of the feed
+             * @param hangUp true if the client has closed its end of the connection
+             *
+             * @return true if the input continues, false if it has ended
+            */
+            static bool feedChunk(const int socketID, const bool hangUp);
+
+            /**
+             * @brief Stops reading the socket of the given feed until its job has read from its full pipe,
+             * or starts reading it again once it has.
+             *
+             * @param socketID the socket of the client of the feed
+             * @param waitForPipe true to wait for the pipe, false to go back to the socket
+            */
+            static void switchWaiting(const int socketID, const bool waitForPipe);
+
+            /**
+             * @brief Ends the given feed. The pipe is closed, so the job sees the end of its input.
+             *
+             * @param socketID the socket of the client of the feed
+            */
+            static void endFeed(const int socketID);
+
+            /**
+             * @brief Feeder Thread function. It waits for input on every socket and room in every full
+             * pipe, and moves the input to the jobs, until it is stopped.
+             *
+             * @param arg unused
+             *
+             * @return anything
+            */
+            static void* FeederThread(void* arg);
+
+        public:
+
+            /**
+             * @brief Creates the feeder thread.
+             *
+             * @return true if the feeder was started successfully, false otherwise
+            */
+            static bool start(void);
+
+            /**
+             * @brief Stops the feeder thread and closes the pipes of the inputs that have not ended.
+            */
+            static void stop(void);
+
+            /**
+             * @brief Starts feeding the input that the client of a job sends to the write end of the
+             * input pipe of the job, which is closed when the input ends.
+             *
+             * @param pipeFD the write end of the input pipe of the job
+             * @param socketID the socket of the client
+             * @param jobID the job ID of the job
+             *
+             * @return true if the feed was started, false otherwise
+            */
+            static bool feed(const int pipeFD, const int socketID, const std::string& jobID);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,113 @@
+/* Filename: jobCoalescing.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "clientCommands.h"
+
+namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Job_Coalescing {
+
+        /**
+         * @brief A job issued with '--coalesce yes' that is queued or running, along with the identical
+         * jobs that wait for its output instead of running themselves.
+        */
+        typedef struct Application_In_Flight_Job {
+
+            std::string leaderID;                // The job ID of the job that actually runs
+            std::vector<CC::JobTriplate> waiters; // The identical jobs that get the output of the leader
+
+        } InFlightJob;
+
+        /**
+         * @brief Public Static class that coalesces identical jobs. A job issued with '--coalesce yes' whose
+         * arguments match a coalescing job that is already queued or running does not enter the waiting
+         * buffer queue. It is attached to that job as a waiter instead, and when the job finishes its output
+         * is sent to the client of every waiter as well, under the job ID of the waiter. So a burst of the
+         * same command takes a single position in the queue, a single slot and a single process.
+         *
+         * The arguments are normalized the same way as for the result cache. A waiter can be stopped on its
+         * own, and when a queued leader is stopped its first waiter takes its place in the queue.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Coalescer {
+
+        private:
+
+            static std::map<std::string, InFlightJob> jobs; // The coalescing jobs in flight, by their normalized arguments
+            static unsigned long submissions;               // The coalescing jobs that have been submitted
+            static unsigned long coalesced;                 // The coalescing jobs that were attached to an identical job
+
+            /**
+             * @brief Returns the normalized arguments of the given job, that identify it among the jobs in flight.
+             *
+             * @param job the job string
+             *
+             * @return the normalized arguments
+            */
+            static std::string getKey(const std::string& job);
+
+        public:
+
+            /**
+             * @brief Attaches a newly submitted job to an identical job in flight. If there is none, the
+             * job becomes the job in flight that later identical jobs are attached to.
+             *
+             * @param triplate the triplate of the submitted job
+             * @param leaderID the job ID of the job it was attached to
+             *
+             * @return true if the job was attached as a waiter, false if it must run itself
+            */
+            static bool attach(const CC::JobTriplate& triplate, std::string& leaderID);
+
+            /**
+             * @brief Removes a job in flight that has finished, or that will never run, and returns the jobs
+             * waiting for its output.
+             *
+             * @param leader the triplate of the job in flight
+             * @param waiters the jobs that were waiting for its output
+            */
+            static void detach(const CC::JobTriplate& leader, std::vector<CC::JobTriplate>& waiters);
+
+            /**
+             * @brief Hands a queued job in flight that was stopped over to its first waiter, which has to take
+             * its place in the queue. The job in flight is removed if nobody waits for it.
+             *
+             * @param leader the triplate of the stopped job
+             * @param successor the waiter that becomes the job in flight
+             *
+             * @return true if a waiter took over, false otherwise
+            */
+            static bool handOver(const CC::JobTriplate& leader, CC::JobTriplate& successor);
+
+            /**
+             * @brief Removes a waiter with the given job ID, when it is stopped.
+             *
+             * @param jobID the job ID of the waiter
+             * @param triplate the triplate of the waiter that was removed
+             *
+             * @return true if the waiter was found, false otherwise
+            */
+            static bool removeWaiter(const std::string& jobID, CC::JobTriplate& triplate);
+
+            /**
+             * @brief Returns how many coalescing jobs have been submitted, and how many of them were attached
+             * to an identical job.
+             *
+             * @param submitted the coalescing jobs that have been submitted
+             * @param attached the coalescing jobs that were attached to an identical job
+            */
+            static void getStats(unsigned long& submitted, unsigned long& attached);
+
+        };
+
+    }
+
+}
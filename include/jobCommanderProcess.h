@@ -35,6 +35,27 @@ namespace Application_Job_Commander_Client {
 
         static pid_t processID; // Process ID
 
+        static int input_FD; // The file the input of the job or the uploaded blob is streamed from, -1 if there is none
+
+        /**
+         * @brief Streams the input of the job to the server after the job has been submitted, or the blob
+         * once the server is ready for it, as data frames ended by an empty frame. Sending stops early once
+         * the server answers, since then the job has either finished without reading the rest of its input
+         * or will never run, or the blob has been rejected.
+         * 
+         * @return true if the whole input was sent, false otherwise
+        */
+        static bool sendJobInput(void);
+
+        /**
+         * @brief Opens the file of an upload command and hashes it, so that the command tells the server
+         * the digest and the size of the blob instead of the name of the file. The file is read again from
+         * the start if the server does not have the blob.
+         * 
+         * @return true if the file was opened and hashed successfully, false otherwise
+         */
+        static bool openBlob(void);
+
     public:
 
         /**
@@ -48,6 +69,17 @@ namespace Application_Job_Commander_Client {
         */
         static void init(const std::string serverName, const port_num_t portNum, const std::string command);
 
+        /**
+         * @brief Opens the input of the job, if the user gave one to an issueJob command. The input is
+         * a local file, or the standard input of the client for '-', and it is streamed once the job is
+         * submitted, so the command only tells the server that the input follows. The file of an upload
+         * command is opened and hashed instead, so the command tells the server the digest and the size
+         * of the blob, and the blob is streamed only if the server does not have it.
+         * 
+         * @return true if there is no input or it was opened successfully, false otherwise
+        */
+        static bool openJobInput(void);
+
         /**
          * @brief Receives the IP address of the server, according to its machine name that is
          * located to.
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <iostream>
+#include <string>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include <pthread.h>
@@ -12,6 +13,46 @@ typedef unsigned int port_num_t;
 
 namespace Application_Job_Executor_Server {
 
+    /**
+     * @brief Public struct that holds the optional settings of the server, given as '--option value'
+     * pairs after the required command line arguments of the server.
+     * 
+     * @author Antonis Zikas sdi2100038
+    */
+    typedef struct Application_Server_Options {
+
+        unsigned int cpus;           // The number of CPUs available to the jobs (--cpus)
+        unsigned long memory;        // The amount of memory in MB available to the jobs (--mem)
+        unsigned int maxPreemptions; // The maximum number of times a single job can be preempted (--max-preemptions)
+
+        std::string pluginDirectory; // The directory plugin jobs are loaded from, plugin jobs are disabled if empty (--plugin-dir)
+        unsigned int pluginSlots;    // The number of plugin jobs that can run at the same time (--plugin-slots)
+        unsigned int pluginTimeout;  // The number of seconds after which a plugin call times out (--plugin-timeout)
+
+        unsigned long outputMemory;  // The amount of memory in MB the outputs of the running jobs can take, before they go to disk (--output-memory)
+
+        unsigned long jobWallLimit;   // The seconds a job can run for, 0 for no limit (--job-timeout)
+        unsigned long jobCpuLimit;    // The CPU seconds a job can use, 0 for no limit (--job-cpu-limit)
+        unsigned long jobMemoryLimit; // The address space in MB a job can use, 0 for no limit (--job-mem-limit)
+        unsigned long jobOutputLimit; // The bytes of output a job can write, 0 for no limit (--job-output-limit)
+        unsigned int stopGrace;       // The seconds a stopped running job has to exit after SIGTERM, before it is killed (--stop-grace)
+
+        std::string placement;        // The policy the jobs are placed on cores by, none, compact, spread or numa (--placement)
+
+        unsigned long resultCacheMemory; // The amount of memory in MB the outputs of the cacheable jobs can take, 0 to disable the cache (--result-cache)
+        unsigned long resultTimeToLive;  // The seconds a cached output is reused for, 0 to keep it until it is evicted (--result-ttl)
+
+        unsigned long detachedMemory;     // The amount of memory in MB the results of the detached jobs can take (--detached-memory)
+        unsigned long detachedTimeToLive; // The seconds the result of a detached job is kept for, 0 to keep it until it is evicted (--detached-ttl)
+
+        unsigned long compressThreshold;  // The size in bytes an output must reach to be sent compressed, 0 to never compress (--compress-threshold)
+        unsigned long sendTimeout;        // The seconds a client can take no bytes of its output for, before it is dropped, 0 for no limit (--send-timeout)
+
+        std::string blobDirectory;        // The directory the blobs uploaded by the clients are stored in (--blob-dir)
+        unsigned long blobBudget;         // The amount of disk space in MB the blobs can take, 0 to disable the blob store (--blob-budget)
+
+    } Options;
+
     /**
      * @brief Public class that represents a Job Executor Server Process. It contains all
      * the basic and appropriate data of the server, port number, buffer size, thread pool size 
@@ -27,6 +68,7 @@ namespace Application_Job_Executor_Server {
         static unsigned int bufferSize;     // The size of the buffer
         static unsigned int threadPoolSize; // the size of the thread pool
         static unsigned int concurrency;    // The concurrency level of the server (how many jobs can run at the same time)
+        static Options options;             // The optional settings of the server
 
         static int server_fd;               // The server file descriptor, result from listen()
         static struct sockaddr_in address;  //  The address of the server
@@ -56,6 +98,18 @@ namespace Application_Job_Executor_Server {
         */
         static void* WorkerThread(void* socket_desc);
 
+        /**
+         * @brief Timer Thread function of the server. It advances the timer wheel once every tick and
+         * places the delayed and recurring jobs that became due in the waiting buffer queue. On every
+         * tick it also checks the deadlines of the running plugin calls and the wall time limits of
+         * the running jobs.
+         * 
+         * @param arg unused
+         * 
+         * @return anything
+        */
+        static void* TimerThread(void* arg);
+
     public:
         
         /* Supporting flags */
@@ -68,12 +122,30 @@ namespace Application_Job_Executor_Server {
         static pthread_mutex_t mutex_jobInsertion;   // Used for jobs insertions in the queue
         static pthread_mutex_t mutex_serverContinue; // Used for server termination
         static pthread_mutex_t mutex_allJobsDone;    // Used to determin when all jobs are done
+        static pthread_mutex_t mutex_dependencies;   // Used for the dependency graph of the jobs
+        static pthread_mutex_t mutex_timers;         // Used for the timer wheel of the delayed and recurring jobs
+        static pthread_mutex_t mutex_launcher;       // Used for the replies of the launcher process
+        static pthread_mutex_t mutex_plugins;        // Used for the loaded plugins and the running plugin calls
+        static pthread_mutex_t mutex_supervisor;     // Used for the running jobs watched by the supervisor
+        static pthread_mutex_t mutex_streams;        // Used for the outputs being streamed to the clients
+        static pthread_mutex_t mutex_outputs;        // Used for the outputs of the running jobs kept in memory
+        static pthread_mutex_t mutex_results;        // Used for the cached outputs of the cacheable jobs
+        static pthread_mutex_t mutex_coalescing;     // Used for the coalescing jobs in flight and their waiters
+        static pthread_mutex_t mutex_detached;       // Used for the results of the detached jobs
+        static pthread_mutex_t mutex_events;         // Used for the completion events and the watching clients
+        static pthread_mutex_t mutex_sender;         // Used for the messages waiting to be sent to the clients
+        static pthread_mutex_t mutex_clients;        // Used for the client connections watched for hangups
+        static pthread_mutex_t mutex_inputs;         // Used for the inputs being fed to the jobs
+        static pthread_mutex_t mutex_blobs;          // Used for the blobs of the blob store and the jobs using them
 
         /* Condition Variables */
         static pthread_cond_t condVar_controller;     // Used for the controller thread synchronization
         static pthread_cond_t condVar_worker;         // Used for the worker thread synchronization
         static pthread_cond_t condVar_serverContinue; // Used for the server termination synchronization
         static pthread_cond_t condVar_allJobsDone;    // Used to determin when all jobs are done
+        static pthread_cond_t condVar_launcher;       // Used to wait for the replies of the launcher process
+        static pthread_cond_t condVar_supervisor;     // Used to wake up the supervisor when a job exits
+        static pthread_cond_t condVar_events;         // Used to wake up the publisher when a job ends
 
         /**
          * @brief Initializer of the Job Executor Server Process. Works like a constructor and initializes 
@@ -82,8 +154,9 @@ namespace Application_Job_Executor_Server {
          * @param portNum the port number of the server
          * @param bufferSize the size of the buffer
          * @param threadPoolSize the size of the thread pool
+         * @param options the optional settings of the server
         */
-        static void init(const port_num_t portNum, const unsigned int bufferSize, const unsigned int threadPoolSize);
+        static void init(const port_num_t portNum, const unsigned int bufferSize, const unsigned int threadPoolSize, const Options& options);
 
         /**
          * @brief Destroyer of the Job Executor Server Process. Works like a destructor and deletes any memory 
@@ -113,11 +186,34 @@ namespace Application_Job_Executor_Server {
         */
         static unsigned int getConcurrency(void);
         
+        /**
+         * @brief Returns the optional settings of the server.
+         * 
+         * @return the options of the server
+        */
+        static const Options& getOptions(void);
+
         /**
          * @brief Increases the amount of running jobs by one.
         */
         static void increaseRunningJobs(void);
 
+        /**
+         * @brief Decreases the amount of running jobs by one.
+        */
+        static void decreaseRunningJobs(void);
+
+        /**
+         * @brief Records the end of a job in the dependency graph. The jobs that were waiting only for
+         * this job are placed in the waiting buffer queue, and if the job failed, the clients of the jobs
+         * depending on it are notified that their jobs were canceled. Either way, the client of the job
+         * is no longer watched once it has got every output it waits for.
+         * 
+         * @param jobID the job ID of the job that ended
+         * @param succeeded whether the job finished successfully
+        */
+        static void completeJob(const std::string jobID, const bool succeeded);
+
         /**
          * @brief Sets the concurrency of the server (how many jobs can run at the same time)
          * 
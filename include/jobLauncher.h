@@ -0,0 +1,224 @@
+/* Filename: jobLauncher.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/types.h>
+
+#define MAX_LAUNCH_REQUEST_SIZE (65536)
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Job_Launcher {
+
+        /**
+         * @brief The types of the replies of the launcher process.
+        */
+        enum ReplyType {
+            JLR_SPAWNED, // The job was launched, or it could not be launched
+            JLR_EXITED   // A job that was launched has finished
+        };
+
+        /**
+         * @brief How the launcher process found the executable of a job.
+        */
+        enum ExecutableLookup {
+            JLX_DIRECT,  // The executable was given as a path, or it was not found
+            JLX_CACHED,  // The executable was found in the executable cache
+            JLX_RESOLVED // The executable was searched in $PATH and added to the executable cache
+        };
+
+        /**
+         * @brief An executable of the executable cache, with the identity of its file when it was resolved.
+        */
+        typedef struct Application_Resolved_Executable {
+
+            std::string path;          // The full path of the executable
+            dev_t device;              // The device of the file
+            ino_t inode;               // The inode of the file
+            struct timespec modified;  // The last modification time of the file
+
+        } ResolvedExecutable;
+
+        /**
+         * @brief The resource limits of a job, where 0 stands for no limit. The wall time and the output
+         * are enforced by the supervisor of the running jobs and the rest by the kernel.
+        */
+        typedef struct Application_Job_Limits {
+
+            unsigned long wallSeconds;   // The seconds the job can run for
+            unsigned long cpuSeconds;    // The CPU seconds the job can use
+            unsigned long addressSpace;  // The address space in MB the job can use
+            unsigned long outputBytes;   // The bytes of output the job can write
+
+        } Limits;
+
+        /**
+         * @brief A launch request sent to the launcher process. The job string follows the header
+         * in the same packet and the output file descriptor of the job travels with it, followed by
+         * the input pipe of the job and its working directory if it has them.
+        */
+        struct Request {
+            unsigned long tag; // Identifies the reply to the worker thread that sent the request
+            Limits limits;     // The resource limits of the job
+            cpu_set_t cpus;    // The cores the job is placed on, empty if it can run on any core
+            bool hasInput;     // Whether the input pipe of the job travels with the request
+            bool hasDirectory; // Whether the working directory of the job travels with the request
+        };
+
+        /**
+         * @brief A reply of the launcher process.
+        */
+        struct Reply {
+            ReplyType type;
+            unsigned long tag; // The tag of the request for a spawned reply
+            pid_t pid;         // The process ID of the job, or -1 if it was not launched
+            int value;         // The error of the launch for a spawned reply, or the wait status for an exited reply
+            ExecutableLookup lookup; // How the executable was found for a spawned reply
+            unsigned long cpuSeconds; // The CPU seconds the job used for an exited reply
+        };
+
+        /**
+         * @brief Public Static class that launches the processes of the jobs. Jobs are not launched by
+         * the server itself, since forking a big multithreaded process gets slower as it grows and is
+         * unsafe once threads exist. Instead a small single-threaded launcher process is forked when the
+         * server starts, before any thread is created. The worker threads send it the job and its output
+         * file descriptor over a socket pair, and it launches the job with posix_spawn() and reports back
+         * the process ID of the job and later its exit status. A reply thread of the server receives those
+         * reports and hands them to the worker threads and to the supervisor of the running jobs.
+         * 
+         * The launcher process keeps a cache of the executables it has found in $PATH, so that a command
+         * that runs again is not searched with a failing exec() for every directory before its own. An
+         * entry is used only while its file still has the same inode and modification time.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Launcher {
+
+        private:
+
+            static int launcherSocket;   // The server end of the socket pair to the launcher process
+            static pid_t launcherPID;    // The process ID of the launcher process
+            static pthread_t replyThread;
+            static bool launcherAlive;   // False once the launcher process has gone away
+            static unsigned long nextTag;
+
+            static std::map<unsigned long, Reply> spawnedReplies; // Spawned replies not yet taken by their worker
+            static unsigned long cacheHits;                       // The launches that found their executable in the cache
+            static unsigned long cacheMisses;                     // The launches that had to search $PATH for their executable
+
+            static std::map<std::string, ResolvedExecutable> executables; // The executable cache of the launcher process, by command name
+
+            /**
+             * @brief Finds the full path of the given executable. A name that contains a slash is used as it
+             * is, otherwise the cached path is used as long as its file has not changed, or $PATH is searched
+             * and the path that is found is cached.
+             * 
+             * @param name the executable of the job
+             * @param path the full path of the executable
+             * 
+             * @return how the executable was found
+            */
+            static ExecutableLookup resolveExecutable(const std::string& name, std::string& path);
+
+            /**
+             * @brief Splits the given job string into the arguments of its executable.
+             * 
+             * @param job the job string
+             * @param arguments the arguments of the job, where the first one is the executable
+            */
+            static void getJobArguments(const std::string& job, std::vector<std::string>& arguments);
+
+            /**
+             * @brief Launches the given job with posix_spawn() in a new process, which is the leader of
+             * its own process group and whose standard output is the given file descriptor. The executable
+             * is launched by its full path, which is found through the executable cache. A job with
+             * resource limits or placed on cores is forked by the launcher instead, which sets them before
+             * the exec(). A job with input reads it from the given pipe as its standard input. A job with
+             * a working directory of its own is forked as well, since it has to change to it before the exec().
+             * 
+             * @param job the job string
+             * @param outputFD the file descriptor of the output file of the job
+             * @param inputFD the file descriptor of the input pipe of the job, -1 if it has no input
+             * @param directoryFD the file descriptor of the working directory of the job, -1 to run it in the directory of the server
+             * @param limits the resource limits of the job
+             * @param cpus the cores the job is placed on, empty if it can run on any core
+             * @param pid the process ID of the new process
+             * @param lookup how the executable of the job was found
+             * 
+             * @return zero if the job was launched successfully, the error number otherwise
+            */
+            static int spawnJobProcess(const std::string& job, const int outputFD, const int inputFD, const int directoryFD, const Limits& limits, const cpu_set_t& cpus, pid_t& pid, ExecutableLookup& lookup);
+
+            /**
+             * @brief The main loop of the launcher process. It launches the jobs it is asked to and
+             * reports every job that finishes, until the server closes its end of the socket pair.
+             * 
+             * @param socketFD the launcher end of the socket pair
+            */
+            static void runLauncherProcess(const int socketFD);
+
+            /**
+             * @brief Reply Thread function of the server. It receives the replies of the launcher
+             * process, wakes up the worker threads waiting for them and reports the exits of the
+             * jobs to the supervisor.
+             * 
+             * @param arg unused
+             * 
+             * @return anything
+            */
+            static void* ReplyThread(void* arg);
+
+        public:
+
+            /**
+             * @brief Forks the launcher process and creates the reply thread. It must be called before
+             * any other thread of the server is created.
+             * 
+             * @return true if the launcher was started successfully, false otherwise
+            */
+            static bool start(void);
+
+            /**
+             * @brief Stops the launcher process and the reply thread.
+            */
+            static void stop(void);
+
+            /**
+             * @brief Launches the given job through the launcher process. Its standard output is
+             * redirected to the given file descriptor, its standard input to the given input pipe
+             * and its working directory to the given directory if it has them, all of which the
+             * caller still has to close.
+             * 
+             * @param job the job string
+             * @param outputFD the file descriptor that becomes the standard output of the job
+             * @param inputFD the file descriptor that becomes the standard input of the job, -1 to keep the inherited one
+             * @param directoryFD the file descriptor of the working directory of the job, -1 to keep the inherited one
+             * @param limits the resource limits of the job
+             * @param cpus the cores the job is placed on, empty if it can run on any core
+             * @param pid the process ID of the new process
+             * 
+             * @return true if the job was launched successfully, false otherwise
+            */
+            static bool spawnJob(const std::string& job, const int outputFD, const int inputFD, const int directoryFD, const Limits& limits, const cpu_set_t& cpus, pid_t& pid);
+
+            /**
+             * @brief Returns how many launches found their executable in the executable cache and how
+             * many had to search $PATH for it.
+             * 
+             * @param hits the launches that found their executable in the cache
+             * @param misses the launches that searched $PATH
+            */
+            static void getCacheStats(unsigned long& hits, unsigned long& misses);
+
+        };
+
+    }
+
+}
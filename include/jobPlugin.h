@@ -0,0 +1,40 @@
+/* Filename: jobPlugin.h */
+
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @brief The interface between the server and the plugin jobs, issued as
+ * '@plugin:<library>:<entry> args...'. The library is loaded once from the plugin
+ * directory of the server and the entry is called on a worker thread, as
+ * 
+ *     int entry(int argc, char* argv[], JobPluginOutput* output);
+ * 
+ * where argv[0] is the name of the entry. The entry returns zero on success and
+ * writes its output through the given output. Plugins run inside the server, so
+ * they must be trusted, and a plugin that runs past its timeout is expected to
+ * notice it, either through the return value of write() or the timedOut flag,
+ * and return.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct JobPluginOutput {
+
+    void* context; // Passed back to write()
+
+    // Appends data to the output of the job, returns zero on success or -1 once the call has timed out
+    int (*write)(void* context, const char* data, size_t size);
+
+    const volatile int* timedOut; // Becomes non zero when the call has run past its timeout
+
+} JobPluginOutput;
+
+typedef int (*JobPluginEntry)(int argc, char* argv[], JobPluginOutput* output);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,109 @@
+/* Filename: jobResults.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <list>
+#include <map>
+#include <set>
+#include <ctime>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Job_Results {
+
+        /**
+         * @brief The states the result of a detached job can be in.
+        */
+        enum ResultState {
+            JRS_UNKNOWN,  // No detached job has this job ID, or its result has expired or been evicted
+            JRS_PENDING,  // The detached job has not finished yet
+            JRS_FINISHED  // The result of the detached job is kept in the store
+        };
+
+        /**
+         * @brief The result of a detached job, kept until its client fetches it.
+        */
+        typedef struct Application_Job_Result {
+
+            bool ran;               // Whether the job ran, false if it was removed or canceled before it could run
+            int exitCode;           // The exit code of the job, 128 plus the signal for a killed job, or -1 if it is unknown
+            std::string output;     // The output of the job
+            std::string note;       // The note after the output, or why the job did not run
+            time_t submitted;       // The time the job was submitted at
+            time_t started;         // The time the job started running at
+            time_t finished;        // The time the job finished at
+            std::list<std::string>::iterator position; // The position of the result in the least recently used order
+
+        } JobResult;
+
+        /**
+         * @brief Public Static class that keeps the results of the jobs issued with '--detach yes'. The
+         * client of a detached job does not wait for it: it gets the job ID right away and disconnects, and
+         * the server closes its socket. The output of the job, its exit code and its timings are kept here
+         * when it finishes, and the 'result <jobID>' command fetches them later, as many times as needed.
+         *
+         * The results take at most the detached results budget of the server, and the least recently used
+         * ones are dropped first to make room. A result is dropped once it is older than the time to live
+         * of the server as well.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Store {
+
+        private:
+
+            static std::set<std::string> pending;          // The detached jobs that have not finished yet
+            static std::map<std::string, JobResult> results; // The results of the detached jobs by job ID
+            static std::list<std::string> recentlyUsed;    // The job IDs of the results, the most recently used first
+            static unsigned long storedBytes;              // The bytes the results take
+
+            /**
+             * @brief Drops the result of the given job. The caller must hold the detached results mutex of the server.
+             *
+             * @param jobID the job ID of the result
+            */
+            static void drop(const std::string& jobID);
+
+        public:
+
+            /**
+             * @brief Records a detached job that has been submitted, so that its result is known to be on its way.
+             *
+             * @param jobID the job ID of the detached job
+            */
+            static void expect(const std::string& jobID);
+
+            /**
+             * @brief Keeps the result of a detached job that has finished, dropping the least recently used
+             * results if there is no room for it. A result bigger than the whole budget keeps only its note.
+             *
+             * @param jobID the job ID of the detached job
+             * @param result the result of the job
+            */
+            static void keep(const std::string& jobID, JobResult result);
+
+            /**
+             * @brief Keeps the result of a detached job that will never run, if it has not finished yet.
+             *
+             * @param jobID the job ID of the detached job
+             * @param reason why the job did not run
+            */
+            static void discard(const std::string& jobID, const std::string& reason);
+
+            /**
+             * @brief Fetches the result of a detached job. A result that has expired is dropped.
+             *
+             * @param jobID the job ID of the detached job
+             * @param result the result of the job, if it has finished
+             *
+             * @return the state of the result
+            */
+            static ResultState fetch(const std::string& jobID, JobResult& result);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,202 @@
+/* Filename: jobSupervisor.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <pthread.h>
+#include <sys/types.h>
+#include "clientCommands.h"
+#include "outputCapture.h"
+#include "jobLauncher.h"
+
+namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Job_Supervisor {
+
+        /**
+         * @brief The resource limit a job was stopped by, or the stop of a client.
+        */
+        typedef enum Application_Job_Limit {
+            JL_NONE,      // The job did not hit any limit
+            JL_WALL_TIME, // The job ran for longer than its wall time limit and was killed
+            JL_CPU_TIME,  // The job used more CPU time than its limit
+            JL_MEMORY,    // The job failed while its address space was limited, most likely because of the limit
+            JL_OUTPUT,    // The job wrote more output than its limit
+            JL_CANCELED   // The job was stopped by a client while it was running
+        } JobLimit;
+
+        /**
+         * @brief A launched job that the supervisor waits for.
+        */
+        typedef struct Application_Supervised_Job {
+
+            CC::JobTriplate triplate;
+            Application_Output_Capture::CapturedOutput output; // The captured output of the job, with a file descriptor of -1 if it is streamed
+            Application_Job_Launcher::Limits limits;           // The resource limits of the job
+            struct timespec deadline;                          // The time the job is killed at, if it has a wall time limit
+            bool suspended;                                    // Whether the job is suspended by the scheduler, which stops its wall time
+            struct timespec suspendedAt;                       // The time the job was suspended at
+            JobLimit limitHit;                                 // The limit the job was stopped by, known once it has exited
+            int exitCode;                                      // The exit code of the job, 128 plus the signal if it was killed, known once it has exited
+
+        } SupervisedJob;
+
+        /**
+         * @brief An exit of a job reported by the launcher process.
+        */
+        typedef struct Application_Job_Exit {
+
+            pid_t pid;                // The process ID of the job
+            int status;               // The wait status of the job
+            unsigned long cpuSeconds; // The CPU seconds the job used
+
+        } JobExit;
+
+        /**
+         * @brief Public Static class that supervises the running jobs. A worker thread only launches a
+         * job and hands it over to the supervisor, so a job does not pin a worker thread while it runs
+         * and the number of running jobs is not limited by the thread pool. The launcher process reaps
+         * the jobs and reports their exit statuses, and the supervisor thread finishes every job that
+         * has exited: it sends its output to its client, gives back its slot and its resources and
+         * releases or cancels the jobs depending on it.
+         * 
+         * The supervisor also enforces the wall time and the output limits of the jobs, and kills the process
+         * group of a job that runs past its deadline or writes past its output limit, recording the limit it
+         * enforced. When a job exits, that limit is reported along with the output, and otherwise the
+         * supervisor finds out which of the limits the kernel enforces the job was stopped by, if any.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Supervisor {
+
+        private:
+
+            static std::map<pid_t, SupervisedJob> jobs;       // The supervised jobs by process ID
+            static std::vector<JobExit> exits;                 // The reported exits, not yet handled
+            static std::map<std::string, JobLimit> enforced;   // The limits the supervisor has stopped jobs for, by job ID
+            static bool launcherGone;                          // True once the launcher process has gone away
+            static bool stopping;                              // True once the supervisor must stop
+            static pthread_t supervisorThread;
+
+            /**
+             * @brief Supervisor Thread function. It finishes the supervised jobs as their exits are
+             * reported, until the supervisor is stopped.
+             * 
+             * @param arg unused
+             * 
+             * @return anything
+            */
+            static void* SupervisorThread(void* arg);
+
+        public:
+
+            /**
+             * @brief Creates the supervisor thread.
+             * 
+             * @return true if the supervisor was started successfully, false otherwise
+            */
+            static bool start(void);
+
+            /**
+             * @brief Stops the supervisor thread. It must be called only when no job runs.
+            */
+            static void stop(void);
+
+            /**
+             * @brief Starts supervising a job that has been launched.
+             * 
+             * @param pid the process ID of the job
+             * @param triplate the triplate of the job
+             * @param output the captured output of the job, with a file descriptor of -1 if it is streamed
+             * @param limits the resource limits of the job
+            */
+            static void watch(const pid_t pid, const CC::JobTriplate& triplate, const Application_Output_Capture::CapturedOutput& output, const Application_Job_Launcher::Limits& limits);
+
+            /**
+             * @brief Kills every supervised job that has run past the deadline of its wall time limit or
+             * whose captured output has grown past its output limit, and every canceled job that has
+             * outlived its grace period. It is called on every tick of the timer thread.
+            */
+            static void checkDeadlines(void);
+
+            /**
+             * @brief Stops or restarts the wall time of a job while the scheduler suspends it, so
+             * that the time it spends suspended does not count towards its wall time limit.
+             * 
+             * @param pid the process ID of the job
+             * @param suspended whether the job is suspended or resumed
+            */
+            static void setSuspended(const pid_t pid, const bool suspended);
+
+            /**
+             * @brief Kills a job for going past one of its limits, and records the limit so that it is
+             * reported when the job exits. It may be called before the job is watched.
+             * 
+             * @param processGroup the process group of the job
+             * @param jobID the job ID of the job
+             * @param limit the limit the job went past
+            */
+            static void enforceLimit(const pid_t processGroup, const std::string& jobID, const JobLimit limit);
+
+            /**
+             * @brief Returns the resource limits of the given job. A limit that is not given to the
+             * job gets the default of the server.
+             * 
+             * @param triplate the triplate of the job
+             * 
+             * @return the resource limits of the job
+            */
+            static Application_Job_Launcher::Limits getJobLimits(const CC::JobTriplate& triplate);
+
+            /**
+             * @brief Reports that a job has exited. The exit may be reported before the job is watched.
+             * 
+             * @param pid the process ID of the job
+             * @param status the wait status of the job
+             * @param cpuSeconds the CPU seconds the job used
+            */
+            static void notifyExit(const pid_t pid, const int status, const unsigned long cpuSeconds);
+
+            /**
+             * @brief Reports that the launcher process has gone away, so no more exits will be reported
+             * and every supervised job is finished as failed.
+            */
+            static void notifyLauncherGone(void);
+
+            /**
+             * @brief Finishes a job. It sends the output of the job to its client, gives back its slot,
+             * its resources and its blobs and releases or cancels the jobs depending on it. The output of a cacheable
+             * job that succeeded is stored in the result cache, and the output of a coalescing job is sent
+             * to the identical jobs waiting for it as well, which end the same way. The output of a detached
+             * job is kept until its client fetches it, instead. The end of every job is published to the
+             * clients that watch it.
+             * 
+             * @param triplate the triplate of the job
+             * @param succeeded whether the job finished successfully
+             * @param limitHit the resource limit the job was stopped by
+             * @param exitCode the exit code of the job, or -1 if it is unknown
+             * @param output the output of the job, or nullptr if it has already been streamed
+             * @param outputSize the size of the output
+            */
+            static void finishJob(const CC::JobTriplate& triplate, const bool succeeded, const JobLimit limitHit, const int exitCode, const char* output, const ssize_t outputSize);
+
+            /**
+             * @brief Finishes a cacheable job whose output was found in the result cache, without running it.
+             * It sends the cached output to its client, or keeps it for a detached job, and releases the jobs
+ * depending on it.
+             * 
+             * @param triplate the triplate of the job
+             * @param output the cached output of the job
+            */
+            static void finishCachedJob(const CC::JobTriplate& triplate, const std::string& output);
+
+        };
+
+    }
+
+}
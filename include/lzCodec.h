@@ -0,0 +1,86 @@
+/* Filename: lzCodec.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <stddef.h>
+
+namespace Application_Job_Commander_Client {
+
+    namespace Application_Lz_Codec {
+
+        /**
+         * @brief Public Static class that compresses the outputs of the jobs sent by the server, and
+         * decompresses them on the client. It is a byte oriented LZ77 codec in the spirit of LZ4: the
+         * output is a series of sequences, each made of a token, the literal bytes that are copied as they
+         * are and the offset and the length of a match against the last 64 KB that were written. It needs
+         * no dictionary and no entropy coding, so it is fast on both ends and does well on the repetitive
+         * text that most jobs print.
+         *
+         * A compressed message starts with a marker that a plain message of the server never starts with,
+         * followed by the size of the original message and the compressed bytes, so the client can tell
+         * the two apart without any other change in the protocol.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Codec {
+
+        private:
+
+            /**
+             * @brief Compresses the given bytes.
+             *
+             * @param input the bytes to compress
+             * @param inputSize the number of bytes
+             * @param compressed the compressed bytes, appended to what it already holds
+            */
+            static void compress(const char* input, const size_t inputSize, std::string& compressed);
+
+            /**
+             * @brief Decompresses the given bytes, checking that they are well formed.
+             *
+             * @param input the compressed bytes
+             * @param inputSize the number of compressed bytes
+             * @param originalSize the size of the original bytes
+             * @param output the original bytes
+             *
+             * @return true if the bytes were decompressed, false if they are corrupted
+            */
+            static bool decompress(const char* input, const size_t inputSize, const size_t originalSize, std::string& output);
+
+        public:
+
+            /**
+             * @brief Compresses a message into a compressed message, if it gets any smaller.
+             *
+             * @param message the message to compress
+             * @param compressed the compressed message
+             *
+             * @return true if the message was compressed, false if it does not get smaller
+            */
+            static bool pack(const std::string& message, std::string& compressed);
+
+            /**
+             * @brief Returns whether the given message is a compressed message.
+             *
+             * @param message the message received
+             *
+             * @return true if the message is compressed, false otherwise
+            */
+            static bool isPacked(const std::string& message);
+
+            /**
+             * @brief Replaces a compressed message with the original message.
+             *
+             * @param message the compressed message, which becomes the original message
+             *
+             * @return true if the message was decompressed, false if it is corrupted
+            */
+            static bool unpack(std::string& message);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,90 @@
+/* Filename: outputCapture.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <set>
+#include <sys/types.h>
+
+#define OUTPUT_DIRECTORY "temp"
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Output_Capture {
+
+        /**
+         * @brief The captured output of a running job. It is either an anonymous file in memory,
+         * or a file of the temporary directory if there was no room in memory for it.
+        */
+        typedef struct Application_Captured_Output {
+
+            int fd;               // The file descriptor the job writes its output to
+            std::string filePath; // The path of the file on disk, empty if the output is kept in memory
+
+        } CapturedOutput;
+
+        /**
+         * @brief Public Static class that captures the outputs of the jobs whose output is sent back
+         * when they end. The standard output of such a job is a file created with memfd_create(), so
+         * the output never touches the disk and no file has to be named, opened again and deleted.
+         * When it ends, the file is mapped in the memory of the server and sent to the client from there.
+         *
+         * The outputs kept in memory are limited by the output memory budget of the server. A job that
+         * is launched while the outputs of the running jobs already take the whole budget writes its
+         * output to a file of the temporary directory instead, which is sent the same way.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Capture {
+
+        private:
+
+            static std::set<int> memoryOutputs; // The file descriptors of the outputs kept in memory
+
+            /**
+             * @brief Returns the number of bytes the outputs kept in memory take at the moment.
+             * The caller must hold the outputs mutex of the server.
+             *
+             * @return the bytes of the outputs in memory
+            */
+            static unsigned long getMemoryInUse(void);
+
+        public:
+
+            /**
+             * @brief Creates the file that captures the output of a job. It is kept in memory if the
+             * output memory budget of the server allows it, otherwise it is a file on disk.
+             *
+             * @param jobID the ID of the job
+             * @param output the captured output that was created
+             *
+             * @return true if the output file was created successfully, false otherwise
+            */
+            static bool open(const std::string& jobID, CapturedOutput& output);
+
+            /**
+             * @brief Maps the captured output of a job that has ended in the memory of the server.
+             *
+             * @param output the captured output
+             * @param size the size of the output
+             *
+             * @return the contents of the output, an empty string if there are none, nullptr if an error occurred
+            */
+            static const char* map(const CapturedOutput& output, ssize_t& size);
+
+            /**
+             * @brief Releases the captured output of a job. It unmaps and closes the output file, and
+             * deletes it if it is on disk.
+             *
+             * @param output the captured output
+             * @param contents the contents returned by map(), or nullptr if it was not mapped
+             * @param size the size of the output
+            */
+            static void close(const CapturedOutput& output, const char* contents, const ssize_t size);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,67 @@
+/* Filename: outputReducers.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <sys/types.h>
+#include "clientCommands.h"
+
+namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Output_Reducers {
+
+        /**
+         * @brief Public Static class that reduces the output of a job on the server, before it is sent to
+         * its client, according to the reducers the job was issued with. A job can keep only its lines that
+         * contain a fixed string ('--grep') or match an extended regular expression ('--grep-regex'), then
+         * only the first ('--head') or the last ('--tail') lines of those, and finally at most a number of
+         * bytes ('--max-bytes'). So the network and the memory of the client scale with what the client
+         * needs, and not with what the job prints.
+         *
+         * The output of a finished job lies in memory as a whole, so the lines are found in place: the head
+         * and the filter walk it forwards and the tail walks it backwards from its end, and only the lines
+         * that are kept are copied.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Reducer {
+
+        public:
+
+            /**
+             * @brief Returns whether the given job was issued with any output reducer.
+             *
+             * @param options the options of the job
+             *
+             * @return true if the output of the job is reduced, false otherwise
+            */
+            static bool isEnabled(const CC::JobOptions& options);
+
+            /**
+             * @brief Returns whether the output reducers of the given job can be applied. The head and the
+             * tail can not be combined, and the regular expression of the filter must be valid.
+             *
+             * @param options the options of the job
+             *
+             * @return true if the reducers are valid, false otherwise
+            */
+            static bool isValid(const CC::JobOptions& options);
+
+            /**
+             * @brief Applies the output reducers of a job to its output.
+             *
+             * @param options the options of the job
+             * @param output the output of the job
+             * @param outputSize the size of the output
+             * @param reduced the reduced output
+            */
+            static void reduce(const CC::JobOptions& options, const char* output, const ssize_t outputSize, std::string& reduced);
+
+        };
+
+    }
+
+}
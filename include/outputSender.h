@@ -0,0 +1,128 @@
+/* Filename: outputSender.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Output_Sender {
+
+        /**
+         * @brief A client connection with messages that have not been sent yet.
+        */
+        typedef struct Application_Connection {
+
+            std::string pending;  // The bytes that have not been sent yet
+            size_t sent;          // The bytes of the pending bytes that have already been sent
+            time_t lastProgress;  // The last time the client took any bytes
+
+        } Connection;
+
+        /**
+         * @brief Public Static class that sends the outputs of the jobs, and the notifications about
+         * their jobs, to the clients that wait for them. A thread that finishes a job hands the message
+         * over and goes on right away, instead of waiting until a slow or stalled client takes it.
+         *
+         * A message is sent right away as long as the client takes it without blocking, so a fast client
+         * gets its output straight from where it lies in memory. Whatever the client does not take is kept
+         * in the buffer of its connection, after any message that is already waiting there, and the sender
+         * thread sends it once the socket of the client can take more. A client that takes no bytes for
+         * longer than the send timeout of the server is dropped along with its buffer, and a client that
+         * has gone away never raises SIGPIPE in the server.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Sender {
+
+        private:
+
+            static int epollFD;
+            static int wakeFD;                                // Wakes up the sender thread, when it must stop
+            static std::map<int, Connection> connections;     // The connections with pending bytes, by their socket
+            static bool stopping;                             // True once the sender must stop
+            static pthread_t senderThread;
+
+            /**
+             * @brief Sends as many of the pending bytes of a connection as its client takes without
+             * blocking. The caller must hold the sender mutex of the server.
+             *
+             * @param socketID the socket of the client
+             * @param connection the connection of the client
+             *
+             * @return true if the connection is still usable, false if the client has gone away
+            */
+            static bool flush(const int socketID, Connection& connection);
+
+            /**
+             * @brief Stops sending to a connection and drops its pending bytes. The caller must hold
+             * the sender mutex of the server.
+             *
+             * @param socketID the socket of the client
+            */
+            static void drop(const int socketID);
+
+            /**
+             * @brief Sender Thread function. It sends the pending bytes of every connection as its client
+             * can take them and drops the clients that take too long, until it is stopped and every
+             * connection has been flushed.
+             *
+             * @param arg unused
+             *
+             * @return anything
+            */
+            static void* SenderThread(void* arg);
+
+        public:
+
+            /**
+             * @brief Creates the sender thread.
+             *
+             * @return true if the sender was started successfully, false otherwise
+            */
+            static bool start(void);
+
+            /**
+             * @brief Stops the sender thread, once every connection has been flushed or dropped.
+            */
+            static void stop(void);
+
+            /**
+             * @brief Sends a message made of the given parts to a client, without blocking. Whatever the
+             * client does not take right away is sent by the sender thread, after the messages that are
+             * already waiting for the same client.
+             *
+             * @param socketID the socket of the client
+             * @param parts the parts of the message, in order
+             * @param partCount the number of parts
+            */
+            static void send(const int socketID, const struct iovec* parts, const int partCount);
+
+            /**
+             * @brief Sends a single message, its size and then its bytes, to a client, without blocking.
+             *
+             * @param socketID the socket of the client
+             * @param message the message to send
+            */
+            static void sendMessage(const int socketID, const std::string& message);
+
+            /**
+             * @brief Returns the bytes that are still waiting to be sent to a client.
+             *
+             * @param socketID the socket of the client
+             *
+             * @return the bytes that the client has not taken yet
+            */
+            static size_t backlog(const int socketID);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,140 @@
+/* Filename: outputStreamer.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <pthread.h>
+#include <sys/types.h>
+
+#define STREAM_CHUNK_SIZE (65536)
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Output_Streamer {
+
+        /**
+         * @brief An output of a running job that is being streamed to its client.
+        */
+        typedef struct Application_Output_Stream {
+
+            int socketID;      // The socket of the client
+            std::string jobID;
+            bool broken;       // True once the client can not be reached, the rest of the output is dropped
+            pid_t processGroup;        // The process group of the job
+            unsigned long outputLimit; // The bytes of output the job can write, 0 for no limit
+            unsigned long sent;        // The bytes of output sent so far
+            bool truncated;            // True once the job has gone past its output limit, the rest of the output is dropped
+            bool parked;               // True while the client has not taken the previous chunks, the pipe is not read meanwhile
+
+        } Stream;
+
+        /**
+         * @brief Public Static class that streams the outputs of the jobs issued with '--output stream'.
+         * The standard output of such a job is a pipe instead of a file, and the streamer thread hands
+         * whatever the job writes over to the sender, a chunk at a time, while the job runs, so the output
+         * never touches the disk and the client sees it right away.
+         *
+         * The streamer never blocks on a client. A client that has not taken the previous chunk of its
+         * stream yet gets no more, and its pipe is not read until its socket can take more, so a slow
+         * client only slows down the jobs it streams, that block once their pipe is full.
+         * 
+         * A streamed output is sent as a start marker message, a number of data frames and an empty
+         * frame, followed by an end marker message. Every frame is a size and that many bytes, like
+         * every other message of the server.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Streamer {
+
+        private:
+
+            static int epollFD;
+            static std::map<int, Stream> streams; // The streams by the read end of their pipe
+            static bool stopping;
+            static pthread_t streamerThread;
+
+            /**
+             * @brief Moves the next chunk of the given stream to its client, or ends the stream if the
+             * job has closed its output and everything has been sent.
+             * 
+             * @param pipeFD the read end of the pipe of the stream
+             * @param hangUp true if the job has closed its end of the pipe
+             * 
+             * @return true if the stream continues, false if it has ended
+            */
+            static bool forwardChunk(const int pipeFD, const bool hangUp);
+
+            /**
+             * @brief Stops reading the pipe of the given stream, until the socket of its client can
+             * take more. The caller must hold the streams mutex of the server.
+             * 
+             * @param pipeFD the read end of the pipe of the stream
+            */
+            static void park(const int pipeFD);
+
+            /**
+             * @brief Reads the pipes of the streams of a client again, once it has taken what was
+             * sent to it. The caller must hold the streams mutex of the server.
+             * 
+             * @param socketID the socket of the client
+             * @param hangUp true if the client can not be reached anymore
+            */
+            static void resume(const int socketID, const bool hangUp);
+
+            /**
+             * @brief Streamer Thread function. It waits for output on every stream and forwards it,
+             * until it is stopped and every stream has ended.
+             * 
+             * @param arg unused
+             * 
+             * @return anything
+            */
+            static void* StreamerThread(void* arg);
+
+        public:
+
+            /**
+             * @brief Creates the streamer thread.
+             * 
+             * @return true if the streamer was started successfully, false otherwise
+            */
+            static bool start(void);
+
+            /**
+             * @brief Stops the streamer thread, once every stream has ended.
+            */
+            static void stop(void);
+
+            /**
+             * @brief Starts streaming the output of a job from the read end of its pipe to its client.
+             * The start marker is sent right away and the pipe is closed when the stream ends. A job
+             * that writes more than its output limit is stopped by the supervisor, like a job whose output is captured.
+             * 
+             * @param pipeFD the read end of the pipe of the job
+             * @param socketID the socket of the client
+             * @param jobID the job ID of the job
+             * @param processGroup the process group of the job
+             * @param outputLimit the bytes of output the job can write, 0 for no limit
+             * 
+             * @return true if the stream was started, false otherwise
+            */
+            static bool stream(const int pipeFD, const int socketID, const std::string& jobID, const pid_t processGroup, const unsigned long outputLimit);
+
+            /**
+             * @brief Sends a whole output, that is already known, in the format of a stream. It is
+             * used for streamed jobs that did not run as a process.
+             * 
+             * @param socketID the socket of the client
+             * @param jobID the job ID of the job
+             * @param output the output of the job
+             * @param outputSize the size of the output
+            */
+            static void sendWholeOutput(const int socketID, const std::string& jobID, const char* output, const ssize_t outputSize);
+
+        };
+
+    }
+
+}
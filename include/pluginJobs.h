@@ -0,0 +1,147 @@
+/* Filename: pluginJobs.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+#include <ctime>
+#include "clientCommands.h"
+#include "jobPlugin.h"
+
+#define PLUGIN_JOB_PREFIX "@plugin:"
+
+namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Plugin_Jobs {
+
+        /**
+         * @brief A plugin call that is currently running on a worker thread.
+        */
+        typedef struct Application_Plugin_Call {
+
+            std::string jobID;
+            std::string output;      // The output written by the plugin so far
+            struct timespec deadline; // The monotonic time after which the call has timed out
+            volatile int timedOut;
+
+        } Call;
+
+        /**
+         * @brief Public Static class that runs plugin jobs, issued as '@plugin:<library>:<entry> args...'.
+         * For tiny jobs the launch of a process costs more than the work itself, so a plugin job is a
+         * function of a shared library that is called directly on a worker thread. Every library is
+         * loaded with dlopen() once and stays cached, and so does every entry looked up in it. Plugin
+         * jobs have their own concurrency pool, so they neither take the slots nor the resources of
+         * the process jobs, and every call is watched against a timeout.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Registry {
+
+        private:
+
+            static std::map<std::string, void*> libraries;          // The loaded libraries by name
+            static std::map<std::string, JobPluginEntry> entries;   // The entries by '<library>:<entry>'
+            static std::set<Call*> calls;                           // The calls currently running
+
+            static unsigned int runningCalls; // The number of plugin slots in use
+
+            /**
+             * @brief Splits the given plugin job string into its library, its entry and its arguments.
+             * 
+             * @param job the plugin job string
+             * @param library the name of the library
+             * @param entry the name of the entry
+             * @param arguments the arguments of the entry, where the first one is the entry itself
+             * 
+             * @return true if the job string was valid, false otherwise
+            */
+            static bool parsePluginJob(const std::string& job, std::string& library, std::string& entry, std::vector<std::string>& arguments);
+
+            /**
+             * @brief Returns the entry with the given name of the given library, loading the library and
+             * looking up the entry only the first time they are needed.
+             * 
+             * @param library the name of the library
+             * @param entry the name of the entry
+             * 
+             * @return the entry if it was found, nullptr otherwise
+            */
+            static JobPluginEntry getEntry(const std::string& library, const std::string& entry);
+
+        public:
+
+            /**
+             * @brief Checks if the given job string is a plugin job.
+             * 
+             * @param job the job string
+             * 
+             * @return true if it is a plugin job, false otherwise
+            */
+            static bool isPluginJob(const std::string& job);
+
+            /**
+             * @brief Checks if the given plugin job can be accepted, meaning that plugin jobs are enabled
+             * on the server and that the job string is well formed.
+             * 
+             * @param job the plugin job string
+             * 
+             * @return true if the plugin job is valid, false otherwise
+            */
+            static bool isValidPluginJob(const std::string& job);
+
+            /**
+             * @brief Checks if a plugin slot is free. The caller must hold the worker mutex of the server.
+             * 
+             * @return true if a plugin job can start, false otherwise
+            */
+            static bool hasFreeSlot(void);
+
+            /**
+             * @brief Takes a plugin slot. The caller must hold the worker mutex of the server.
+            */
+            static void reserveSlot(void);
+
+            /**
+             * @brief Gives back a plugin slot. The caller must hold the worker mutex of the server.
+            */
+            static void releaseSlot(void);
+
+            /**
+             * @brief Returns the number of plugin slots in use.
+             * 
+             * @return the number of running plugin jobs
+            */
+            static unsigned int getRunningCalls(void);
+
+            /**
+             * @brief Runs the given plugin job on the calling thread.
+             * 
+             * @param triplate the triplate of the plugin job
+             * @param output the output of the job
+             * 
+             * @return true if the entry returned zero in time, false otherwise
+            */
+            static bool runPluginJob(const CC::JobTriplate& triplate, std::string& output);
+
+            /**
+             * @brief Marks every running call that has run past its deadline as timed out. It is
+             * called on every tick of the timer thread of the server.
+            */
+            static void checkDeadlines(void);
+
+            /**
+             * @brief Unloads every loaded library. It must be called only when no plugin job runs.
+            */
+            static void unloadAll(void);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,96 @@
+/* Filename: resourcePool.h */
+
+#pragma once
+
+#include <iostream>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Resource_Pool {
+
+        /**
+         * @brief Public Static class that represents the resources (CPUs and memory) of the machine
+         * the server is running on. Every job reserves the resources it requested before it starts
+         * running and gives them back when it finishes, so that jobs are packed on the machine without
+         * oversubscribing it. The methods of this class are not synchronized, so the caller must hold
+         * the worker mutex of the server.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Pool {
+
+        private:
+
+            static unsigned int totalCpus;    // The number of CPUs available to the jobs
+            static unsigned long totalMemory; // The amount of memory in MB available to the jobs
+
+            static unsigned int usedCpus;    // The number of CPUs currently reserved by running jobs
+            static unsigned long usedMemory; // The amount of memory in MB currently reserved by running jobs
+
+        public:
+
+            /**
+             * @brief Initializes the capacity of the resource pool.
+             * 
+             * @param cpus the number of CPUs available to the jobs
+             * @param memory the amount of memory in MB available to the jobs
+            */
+            static void init(const unsigned int cpus, const unsigned long memory);
+
+            /**
+             * @brief Returns the number of CPUs that are not reserved by any job.
+             * 
+             * @return the number of free CPUs
+            */
+            static unsigned int getFreeCpus(void);
+
+            /**
+             * @brief Returns the amount of memory in MB that is not reserved by any job.
+             * 
+             * @return the amount of free memory
+            */
+            static unsigned long getFreeMemory(void);
+
+            /**
+             * @brief Returns whether a request of the given resources fits in the free resources
+             * of the pool at this moment.
+             * 
+             * @param cpus the number of CPUs requested
+             * @param memory the amount of memory in MB requested
+             * 
+             * @return true if the request fits, false otherwise
+            */
+            static bool fits(const unsigned int cpus, const unsigned long memory);
+
+            /**
+             * @brief Returns whether a request of the given resources could ever fit in the pool,
+             * that is whether it fits when the pool is completely free.
+             * 
+             * @param cpus the number of CPUs requested
+             * @param memory the amount of memory in MB requested
+             * 
+             * @return true if the request can be satisfied, false otherwise
+            */
+            static bool canEverFit(const unsigned int cpus, const unsigned long memory);
+
+            /**
+             * @brief Reserves the given resources for a job that is about to start running.
+             * 
+             * @param cpus the number of CPUs to reserve
+             * @param memory the amount of memory in MB to reserve
+            */
+            static void reserve(const unsigned int cpus, const unsigned long memory);
+
+            /**
+             * @brief Gives back the given resources of a job that has finished running.
+             * 
+             * @param cpus the number of CPUs to release
+             * @param memory the amount of memory in MB to release
+            */
+            static void release(const unsigned int cpus, const unsigned long memory);
+
+        };
+
+    }
+
+}
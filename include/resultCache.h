@@ -0,0 +1,144 @@
+/* Filename: resultCache.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <ctime>
+#include <stdint.h>
+#include <sys/types.h>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Result_Cache {
+
+        /**
+         * @brief A file named by the arguments of a cached job, with its identity when the output was stored.
+        */
+        typedef struct Application_Input_File {
+
+            std::string path;          // The path of the file, as it was given to the job
+            dev_t device;              // The device of the file
+            ino_t inode;               // The inode of the file
+            off_t size;                // The size of the file
+            struct timespec modified;  // The last modification time of the file
+
+        } InputFile;
+
+        /**
+         * @brief The stored output of a job, along with what makes it valid.
+        */
+        typedef struct Application_Cached_Result {
+
+            std::string arguments;          // The normalized arguments of the job, to tell apart jobs with the same hash
+            std::string output;             // The output of the job
+            time_t storedAt;                // The time the output was stored at
+            std::vector<InputFile> inputs;  // The input files of the job, empty if the inputs are not checked
+            std::list<uint64_t>::iterator position; // The position of the result in the least recently used order
+
+        } CachedResult;
+
+        /**
+         * @brief Public Static class that memoizes the outputs of the jobs issued with '--cacheable'. Such
+         * a job promises that it always writes the same output for the same arguments, so once it has run
+         * successfully its output is stored under a hash of its arguments, split on whitespace like the
+         * launcher splits them. A later job with the same arguments gets the stored output right away, and
+         * does not take a slot, a worker or a process at all.
+         *
+         * The stored outputs take at most the result cache budget of the server, and the least recently
+         * used ones are dropped first to make room. An output is dropped once it is older than the time to
+         * live of the server as well. A job issued with '--cacheable inputs' also records every argument
+         * that names a file, and its output is only used while those files keep their inode, size and
+         * modification time.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Cache {
+
+        private:
+
+            static std::map<uint64_t, CachedResult> results; // The stored outputs by the hash of their arguments
+            static std::list<uint64_t> recentlyUsed;         // The hashes of the stored outputs, the most recently used first
+            static unsigned long storedBytes;                // The bytes the stored outputs take
+            static unsigned long hits;                       // The cacheable jobs that got a stored output
+            static unsigned long misses;                     // The cacheable jobs that had to run
+
+            /**
+             * @brief Returns the 64-bit FNV-1a hash of the given normalized arguments.
+             *
+             * @param arguments the normalized arguments
+             *
+             * @return the hash of the arguments
+            */
+            static uint64_t hash(const std::string& arguments);
+
+            /**
+             * @brief Returns whether the input files of a stored output are still the same files.
+             *
+             * @param result the stored output
+             *
+             * @return true if every input file is unchanged, false otherwise
+            */
+            static bool inputsUnchanged(const CachedResult& result);
+
+            /**
+             * @brief Drops the stored output with the given hash. The caller must hold the results mutex of the server.
+             *
+             * @param key the hash of the output to drop
+            */
+            static void drop(const uint64_t key);
+
+        public:
+
+            /**
+             * @brief Splits the given job into its arguments and joins them back with a single separator,
+             * so that jobs that differ only in their whitespace get the same result.
+             *
+             * @param job the job string
+             * @param arguments the arguments of the job, where the first one is the executable
+             *
+             * @return the normalized arguments of the job
+            */
+            static std::string normalize(const std::string& job, std::vector<std::string>& arguments);
+
+            /**
+             * @brief Looks up the stored output of the given job. An output that has expired or whose
+             * input files have changed is dropped and not returned.
+             *
+             * @param job the job string
+             * @param output the stored output of the job
+             *
+             * @return true if the output of the job was found, false otherwise
+            */
+            static bool lookup(const std::string& job, std::string& output);
+
+            /**
+             * @brief Stores the output of a cacheable job that has finished successfully. Outputs bigger than the
+             * whole budget are not stored, and neither are outputs of jobs whose input files changed while they ran.
+             *
+             * @param job the job string
+             * @param checkInputs whether the output is only valid while the input files of the job are unchanged
+             * @param startTime the time the job started running at
+             * @param output the output of the job
+             * @param outputSize the size of the output
+            */
+            static void store(const std::string& job, const bool checkInputs, const time_t startTime, const char* output, const ssize_t outputSize);
+
+            /**
+             * @brief Returns the hits and misses of the result cache and the bytes of the stored outputs.
+             *
+             * @param hitCount the cacheable jobs that got a stored output
+             * @param missCount the cacheable jobs that had to run
+             * @param entries the number of stored outputs
+             * @param bytes the bytes the stored outputs take
+            */
+            static void getStats(unsigned long& hitCount, unsigned long& missCount, unsigned long& entries, unsigned long& bytes);
+
+        };
+
+    }
+
+}
@@ -0,0 +1,154 @@
+/* Filename: runningJobsTable.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <vector>
+#include <ctime>
+#include <sys/types.h>
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Running_Jobs {
+
+        /**
+         * @brief Public struct that holds the data of a job that has been started by a worker
+         * thread and has not finished yet.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        typedef struct Application_Running_Job {
+
+            std::string jobID;        // The job ID of the running job
+            std::string job;          // The actual job of the running job
+            pid_t processGroup;       // The process group of the job, equal to the process ID of the job
+            unsigned int priority;    // The priority of the job, higher values are more urgent
+            unsigned int cpus;        // The number of CPUs the job has reserved
+            unsigned long memory;     // The amount of memory in MB the job has reserved
+            bool suspended;           // Whether the job is currently stopped because of preemption
+            unsigned int preemptions; // How many times the job has been preempted
+            time_t startTime;         // The time the job started running at
+            bool canceled;            // Whether the job has been stopped by a client and is being terminated
+            bool killed;              // Whether the canceled job has been killed, after it outlived its grace period
+            struct timespec killDeadline; // The time a canceled job is killed at, if it has not exited by then
+            std::vector<int> cores;       // The cores the job is placed on, empty if it can run on any core
+
+        } RunningJob;
+
+        /**
+         * @brief Public Static class that represents the table of all the jobs that are currently
+         * running or suspended on the server, indexed by their job ID. The methods of this class
+         * are not synchronized, so the caller must hold the worker mutex of the server.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Table {
+
+        private:
+
+            static std::map<std::string, RunningJob> jobs; // The running jobs indexed by job ID
+            static unsigned int suspendedJobs;             // The number of suspended jobs in the table
+            static unsigned int canceledJobs;              // The number of canceled jobs in the table
+
+        public:
+
+            /**
+             * @brief Inserts a job that has just started running to the table.
+             * 
+             * @param job the running job to insert
+            */
+            static void insert(const RunningJob& job);
+
+            /**
+             * @brief Searches for the job with the given job ID and if it is found, it removes it
+             * from the table.
+             * 
+             * @param jobID the job ID of the job to remove
+             * @param job the job that has been removed
+             * 
+             * @return true if the job was found, false otherwise
+            */
+            static bool remove(const std::string jobID, RunningJob& job);
+
+            /**
+             * @brief Searches for the job with the given job ID.
+             * 
+             * @param jobID the job ID of the job to find
+             * 
+             * @return a pointer to the job, nullptr if it is not in the table
+            */
+            static RunningJob* find(const std::string jobID);
+
+            /**
+             * @brief Marks the given job as canceled. A canceled job is no longer suspended, it is never
+             * preempted or resumed, and it is killed if it is still running at the given deadline.
+             * 
+             * @param job the job of the table to mark
+             * @param killDeadline the time the job is killed at
+            */
+            static void setCanceled(RunningJob* job, const struct timespec& killDeadline);
+
+            /**
+             * @brief Returns the process groups of the canceled jobs that have outlived their grace
+             * period and have not been killed yet, and marks them as killed.
+             * 
+             * @param now the current time
+             * @param processGroups the process groups to kill
+            */
+            static void takeOverdueCanceledJobs(const struct timespec& now, std::vector<pid_t>& processGroups);
+
+            /**
+             * @brief Returns a copy of every job of the table.
+             * 
+             * @param jobs the jobs of the table
+            */
+            static void getJobs(std::vector<RunningJob>& jobs);
+
+            /**
+             * @brief Returns the running (not suspended or canceled) job with the lowest priority, that is
+             * lower than the given one and has not reached the maximum number of preemptions.
+             * 
+             * @param priority the priority of the job that needs a slot
+             * @param maxPreemptions the maximum number of times a single job can be preempted
+             * 
+             * @return a pointer to the job to preempt, nullptr if there is no such job
+            */
+            static RunningJob* findPreemptionVictim(const unsigned int priority, const unsigned int maxPreemptions);
+
+            /**
+             * @brief Returns the suspended job with the highest priority, which is the next one
+             * to be resumed.
+             * 
+             * @return a pointer to the job to resume, nullptr if no job is suspended
+            */
+            static RunningJob* findJobToResume(void);
+
+            /**
+             * @brief Marks the given job as suspended or not suspended.
+             * 
+             * @param job the job of the table to mark
+             * @param suspended whether the job is now suspended
+            */
+            static void setSuspended(RunningJob* job, const bool suspended);
+
+            /**
+             * @brief Returns the number of suspended jobs in the table.
+             * 
+             * @return the amount of suspended jobs
+            */
+            static unsigned int getSuspendedJobs(void);
+
+            /**
+             * @brief Returns the number of canceled jobs in the table, that have not exited yet.
+             * 
+             * @return the amount of canceled jobs
+            */
+            static unsigned int getCanceledJobs(void);
+
+        };
+
+    }
+
+}
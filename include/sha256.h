@@ -0,0 +1,86 @@
+/* Filename: sha256.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Application_Job_Commander_Client {
+
+    namespace Application_Sha256 {
+
+        /**
+         * @brief The state of a digest that is being computed over data that arrives in pieces.
+        */
+        typedef struct Application_Sha256_Context {
+
+            uint32_t state[8];        // The hash of the blocks processed so far
+            uint64_t length;          // The number of bytes given so far
+            unsigned char block[64];  // The bytes of the block that is not full yet
+            size_t blockSize;         // The number of bytes in the block
+
+        } Context;
+
+        /**
+         * @brief Public Static class that computes SHA-256 digests, which name the blobs of the blob store
+         * of the server. The client hashes a file before it uploads it and the server hashes the upload as
+         * it arrives, so a blob is only ever stored under the digest of its contents. The digests are the
+         * same as those printed by sha256sum, so a user can name a blob without asking the server.
+         *
+         * @author Antonis Zikas sdi2100038
+        */
+        class Digest {
+
+        private:
+
+            /**
+             * @brief Mixes a full block of 64 bytes into the state of the given digest.
+             *
+             * @param context the digest
+             * @param block the block
+            */
+            static void transform(Context& context, const unsigned char* block);
+
+        public:
+
+            /**
+             * @brief Starts a new digest.
+             *
+             * @param context the digest
+            */
+            static void init(Context& context);
+
+            /**
+             * @brief Adds the given bytes to the given digest.
+             *
+             * @param context the digest
+             * @param data the bytes
+             * @param size the number of bytes
+            */
+            static void update(Context& context, const char* data, size_t size);
+
+            /**
+             * @brief Ends the given digest.
+             *
+             * @param context the digest
+             *
+             * @return the digest as 64 lowercase hexadecimal digits
+            */
+            static std::string finish(Context& context);
+
+            /**
+             * @brief Returns whether the given string is a digest, 64 lowercase hexadecimal digits.
+             *
+             * @param digest the string
+             *
+             * @return true if the string is a digest, false otherwise
+            */
+            static bool isValid(const std::string& digest);
+
+        };
+
+    }
+
+}
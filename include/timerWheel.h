@@ -0,0 +1,108 @@
+/* Filename: timerWheel.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include "clientCommands.h"
+
+/* Namespace Alias */
+namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+
+#define TIMER_TICK_MILLISECONDS (100) // The duration of a single tick of the timer wheel
+
+#define TIMER_WHEEL_LEVELS    (4)                           // The number of levels of the timer wheel
+#define TIMER_WHEEL_SLOT_BITS (6)                           // The bits of the expiry tick that index a level
+#define TIMER_WHEEL_SLOTS     (1 << TIMER_WHEEL_SLOT_BITS)  // The number of slots of every level
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_SLOTS - 1)       // The mask of a slot index
+
+namespace Application_Job_Executor_Server {
+
+    namespace Application_Timer_Wheel {
+
+        /**
+         * @brief Public struct that represents a delayed or recurring job waiting in the timer wheel.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        typedef struct Application_Timer_Entry {
+
+            CC::JobTriplate triplate;  // The triplate of the scheduled job
+            unsigned long expiry;      // The tick on which the job is due
+            unsigned long periodTicks; // The period of a recurring job in ticks, 0 for a job that runs once
+            unsigned long firings;     // How many times the job has been due so far
+            bool canceled;             // Whether the job was stopped, so that it is dropped from its slot
+
+        } Entry;
+
+        /**
+         * @brief Public Static class that represents a hierarchical timing wheel holding the jobs
+         * submitted with the '--at' and '--every' options. Every level has a fixed number of slots,
+         * and each slot of a level spans a whole turn of the level below it. On every tick the due
+         * slot of the lowest level is emptied and, whenever a level completes a turn, the next slot
+         * of the level above is cascaded down, so every job costs O(1) per tick it is touched. The
+         * methods of this class are synchronized with the timers mutex of the server.
+         * 
+         * @author Antonis Zikas sdi2100038
+        */
+        class Wheel {
+
+        private:
+
+            static std::vector<Entry*> slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS]; // The slots of every level
+            static std::map<std::string, Entry*> entries;                           // The scheduled jobs by job ID
+            static unsigned long currentTick;                                       // The tick the wheel has reached
+
+            /**
+             * @brief Places the given entry in the slot of the level that matches its distance from
+             * the current tick. The caller must hold the timers mutex of the server.
+             * 
+             * @param entry the entry to place
+            */
+            static void place(Entry* entry);
+
+        public:
+
+            /**
+             * @brief Schedules a new job according to its '--at' and '--every' options. A recurring job
+             * gets a phase inside its period derived from its job ID, so that recurring jobs sharing the
+             * same period are spread over different ticks.
+             * 
+             * @param triplate the triplate of the job to schedule
+            */
+            static void schedule(const CC::JobTriplate& triplate);
+
+            /**
+             * @brief Advances the wheel by a single tick and returns the jobs that became due. A recurring
+             * job is returned as a new job 'job_N@k', where k counts its firings, and it is placed back in
+             * the wheel for its next period.
+             * 
+             * @param dueJobs the triplates of the jobs that are due on this tick
+            */
+            static void advance(std::vector<CC::JobTriplate>& dueJobs);
+
+            /**
+             * @brief Searches for the scheduled job with the specific job ID and if it is found, it
+             * removes it from the wheel.
+             * 
+             * @param jobID the job ID of the job to remove
+             * @param triplate the triplate that has been removed
+             * 
+             * @return true if the job ID was found, false otherwise
+            */
+            static bool cancel(const std::string jobID, CC::JobTriplate& triplate);
+
+            /**
+             * @brief Removes every scheduled job of the wheel.
+             * 
+             * @param triplates the triplates of the jobs that were removed
+            */
+            static void removeAll(std::vector<CC::JobTriplate>& triplates);
+
+        };
+
+    }
+
+}
@@ -28,6 +28,8 @@ namespace Application_Job_Executor_Server {
             static size_t capacity;                     // The maximum size of the buffer queue
             static size_t size;                         // The current size of the buffer queue
             static std::vector<CC::JobTriplate> buffer; // The queue structure
+            static std::string headJobID;               // The most urgent process job that has been skipped because it did not fit
+            static unsigned int headSkips;              // The number of times the head job has been skipped
 
         public:
 
@@ -60,7 +62,16 @@ namespace Application_Job_Executor_Server {
              * 
              * @return true if the insertion was successfull, false otherwise
             */
-            static void insertJobTriplate(const CC::JobTriplate triplate);
+            static bool insertJobTriplate(const CC::JobTriplate triplate);
+
+            /**
+             * @brief Inserts a job triplate to the very end of the waiting buffer queue, even if
+             * the queue is full. It is used for jobs that have already been admitted by a controller
+             * thread, such as jobs released from the dependency graph.
+             * 
+             * @param triplate the triplate to insert
+            */
+            static void appendJobTriplate(const CC::JobTriplate triplate);
 
             /**
              * @brief Removes and returns the job triplate located at the begining of the 
@@ -71,6 +82,37 @@ namespace Application_Job_Executor_Server {
             */
             static CC::JobTriplate getJobTriplate(void);
 
+            /**
+             * @brief Searches the waiting buffer queue for the job triplate with the highest priority
+             * whose requested resources fit in the given free resources, and if it is found, it removes
+             * it from the queue. Among jobs of the same priority the oldest one is selected. Jobs that do
+             * not fit are skipped, so that smaller jobs behind them can fill the machine, but once the most
+             * urgent process job has been skipped too many times no other process job is selected, so
+             * that the resources it needs are freed for it. If the selected triplate is a job array, its
+             * next task is returned and the array is removed only when its last task has been handed out.
+             * 
+             * @param freeCpus the number of free CPUs
+             * @param freeMemory the amount of free memory in MB
+             * @param processSlotFree true if a process job can start
+             * @param pluginSlotFree true if a plugin job can start, plugin jobs need no other resources
+             * @param jobTriplate the triplate that has been removed
+             * 
+             * @return true if a fitting job triplate was found, false otherwise
+            */
+            static bool removeFittingJobTriplate(const unsigned int freeCpus, const unsigned long freeMemory, 
+                const bool processSlotFree, const bool pluginSlotFree, CC::JobTriplate& jobTriplate
+            );
+
+            /**
+             * @brief Returns the job triplate with the highest priority in the waiting buffer queue,
+             * without removing it. Among jobs of the same priority the oldest one is returned.
+             * 
+             * @param jobTriplate the triplate with the highest priority
+             * 
+             * @return true if the queue is not empty, false otherwise
+            */
+            static bool peekHighestPriorityJobTriplate(CC::JobTriplate& jobTriplate);
+
             /**
              * @brief Searches for the job triplate with the specific job ID and if it is
              * found, it removes it from the waiting buffer queue.
@@ -93,7 +135,8 @@ namespace Application_Job_Executor_Server {
             static CC::JobTriplate at(const unsigned int index);
 
             /**
-             * @brief Returns whether the waiting buffer queue is full or not.
+             * @brief Returns whether the waiting buffer queue is full or not. The jobs appended past the
+             * capacity keep it full until enough of them have been taken out.
              * 
              * @return true if the queue is full, false otherwise
             */
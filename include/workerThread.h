@@ -29,50 +29,31 @@ namespace Application_Job_Executor_Server {
             int clientSocket; 
             pid_t childProcessID;       
 
-            /**
-             * @brief Sends the output of the job executed by the thread back to the client.
-             * 
-             * @param output the output of the job
-             * @param outputSize the size of the output
-             * 
-             * @return true if the output was sent successfully, false otherwise
-            */
-            bool sendJobOutputToClient(const char* output, const ssize_t outputSize);
-
-            /**
-             * @brief Creates and returns the reponse of the worker thread to the client according
-             * to the job output. Specifically it reads the output file of the job and adds an extra
-             * text at the beginning and at the end of the message.
-             * 
-             * @param jobOutput the job output stored in the output file
-             * @param jobOutputSize the size of the job output
-             * @param jobID the ID of the current job
-             * @param responseSize the size of the final response
-             * 
-             * @return the full response string of the worker thread.
-            */
-            char* createOutputResponse(const char* jobOutput, const ssize_t jobOutputSize, 
-                const char* jobID, ssize_t& responseSize
-            );
-
         public:
 
             /**
-             * @brief Receives and returns a job from the waiting buffer queue, in order to
-             * be executed. It also initializes the client socket ID from the triplate.
+             * @brief Receives a job from the waiting buffer queue, in order to be executed. A job
+             * is received only if the server has a free concurrency slot and the first job of the
+             * queue whose resources fit in the free resources of the server is selected. The slot
+             * and the resources of that job are reserved right away. It also initializes the client
+             * socket ID from the triplate. The caller must hold the worker mutex of the server.
+             * 
+             * @param triplate the job triplate that was received
              * 
-             * @return the first job triplate of the waiting buffer queue
+             * @return true if a job was received, false otherwise
             */
-            CC::JobTriplate receiveJobFromBuffer(void);
+            bool receiveJobFromBuffer(CC::JobTriplate& triplate);
 
             /**
-             * @brief Receives a job triplate and executes its corresponding job. It creates 
-             * a child process with fork() system call and uses exec() to execute the given
-             * process
+             * @brief Receives a job triplate and dispatches its corresponding job. It launches the
+             * job through the launcher process and hands it over to the supervisor, which finishes
+             * the job when it exits, so the worker thread does not wait for it. The output of a job
+             * issued with '--output stream' is handed over to the streamer as well. A plugin job is
+             * called directly and finished right away.
              * 
              * @param jobTriplate the triplate containing the job to execute
              * 
-             * @return true if the job was executed successfully, false otherwise 
+             * @return true if the job was launched, false otherwise 
             */
             bool executeJob(const CC::JobTriplate jobTriplate);
 
@@ -35,6 +35,7 @@ int main(int argc, char* argv[]) {
 
     Client::Process::init(serverName, portNum, jobCommanderInputCommand);
     
+    if (!Client::Process::openJobInput()) return 7;
     if (!Client::Process::getServerIPAddress()) return 2;
     if (!Client::Process::createSocket()) return 3;
     if (!Client::Process::connectToServer()) return 4;
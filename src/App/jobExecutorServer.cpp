@@ -1,7 +1,11 @@
 /* Filename: jobExecutorServer.cpp */
 
 #include <iostream>
+#include <string>
 #include "../../include/jobExecutorServerProcess.h"
+#include "../../include/jobLauncher.h"
+#include "../../include/cpuPlacement.h"
+#include "../../include/blobStore.h"
 
 #define KNRM  "\x1B[0m"
 #define KRED  "\x1B[31m"
@@ -13,16 +17,19 @@
 #define KWHT  "\x1B[37m"
 
 namespace Server = Application_Job_Executor_Server; // namespace alias
+namespace Launch = Application_Job_Executor_Server::Application_Job_Launcher; // namespace alias
+namespace Placement = Application_Job_Executor_Server::Application_Cpu_Placement; // namespace alias
+namespace Blobs = Application_Job_Executor_Server::Application_Blob_Store; // namespace alias
 
 typedef unsigned int port_num_t;
 
-static bool getCommandLineArguments(int argc, char** argv, port_num_t& portNum, unsigned int& bufferSize, unsigned int& threadPoolSize);
+static bool getCommandLineArguments(int argc, char** argv, port_num_t& portNum, unsigned int& bufferSize, unsigned int& threadPoolSize, Server::Options& options);
 
 /**
  * @brief Main Entry Point of the application server. Here the server is being initialized by typing to the tty
  * the following command:
  * 
- * ./bin/jobExecutorServer [portNum] [bufferSize] [threadPoolSize]
+ * ./bin/jobExecutorServer [portNum] [bufferSize] [threadPoolSize] [--option value ...]
  * 
  * @param argc the number of command line arguments
  * @param argv the actual command line arguments
@@ -37,13 +44,30 @@ int main(int argc, char* argv[]) {
     port_num_t portNum;
     unsigned int bufferSize;
     unsigned int threadPoolSize;
+    Server::Options options;
 
     // Initialize these data according to the command line arguments
-    if (!getCommandLineArguments(argc, argv, portNum, bufferSize, threadPoolSize)) {
+    if (!getCommandLineArguments(argc, argv, portNum, bufferSize, threadPoolSize, options)) {
         return 1;
     }
     
-    Server::Process::init(portNum, bufferSize, threadPoolSize); // Initialize the application server
+    Server::Process::init(portNum, bufferSize, threadPoolSize, options); // Initialize the application server
+
+    // Find the cores the jobs are placed on, according to the placement policy
+    if (!Placement::Engine::init(options.placement)) {
+        std::cout << "Unknown placement policy: " << options.placement << std::endl;
+        return 1;
+    }
+
+    // Index the blobs that the clients uploaded to an earlier run of the server
+    if (!Blobs::Store::load()) {
+        return 1;
+    }
+
+    // Fork the launcher process of the jobs while the server is still single-threaded
+    if (!Launch::Launcher::start()) {
+        return 1;
+    }
 
     // Create a socket for communication and attach it to the server
     Server::Process::createSocket();
@@ -55,7 +79,8 @@ int main(int argc, char* argv[]) {
     std::cout << std::endl << KGRN << "Server is listening on port " << KYEL << portNum << KWHT << "..." << std::endl << std::endl;
     Server::Process::run();
 
-    // After the execution of the server delete it
+    // After the execution of the server stop the launcher process and delete the server
+    Launch::Launcher::stop();
     Server::Process::destroy();
 
     return 0;
@@ -63,22 +88,24 @@ int main(int argc, char* argv[]) {
 
 /**
  * @brief Receives the command line arguments the user has given while running the server, then sets and returns 
- * the basic data of the server, according to those arguents.
+ * the basic data of the server, according to those arguents. Any optional settings follow the required arguments
+ * as '--option value' pairs, and settings that are not given get their default values.
  * 
  * @param argc the number of command line arguments
  * @param argv the actual command line arguments
  * 
- * @param serverName the name of the server
  * @param portNum the port number of the server
- * @param command the full command of the user
+ * @param bufferSize the size of the buffer
+ * @param threadPoolSize the size of the thread pool
+ * @param options the optional settings of the server
  * 
  * @return true if the data initialization was successful, false otherwise
 */
-static bool getCommandLineArguments(int argc, char** argv, port_num_t& portNum, unsigned int& bufferSize, unsigned int& threadPoolSize) {
+static bool getCommandLineArguments(int argc, char** argv, port_num_t& portNum, unsigned int& bufferSize, unsigned int& threadPoolSize, Server::Options& options) {
 
     // Checking for valid number of arguments
-    if (argc != 4) {
-        std::cout << "Usage: " << argv[0] << " [portNum] [bufferSize] [threadPoolSize]" << std::endl;
+    if (argc < 4 || (argc - 4) % 2 != 0) {
+        std::cout << "Usage: " << argv[0] << " [portNum] [bufferSize] [threadPoolSize] [--cpus N] [--mem MB] [--max-preemptions N] [--plugin-dir DIR] [--plugin-slots N] [--plugin-timeout SEC] [--output-memory MB] [--job-timeout SEC] [--job-cpu-limit SEC] [--job-mem-limit MB] [--job-output-limit BYTES] [--stop-grace SEC] [--placement none|compact|spread|numa] [--result-cache MB] [--result-ttl SEC] [--detached-memory MB] [--detached-ttl SEC] [--compress-threshold BYTES] [--send-timeout SEC] [--blob-dir DIR] [--blob-budget MB]" << std::endl;
         return false;
     }
 
@@ -87,6 +114,77 @@ static bool getCommandLineArguments(int argc, char** argv, port_num_t& portNum,
     bufferSize = atoi(argv[2]);
     threadPoolSize = atoi(argv[3]);
 
+    // By default the jobs can use all the CPUs and the physical memory of the machine
+    options.cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    options.memory = (unsigned long)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE) / (1024 * 1024);
+    options.maxPreemptions = 3;
+
+    // Plugin jobs are disabled unless a plugin directory is given
+    options.pluginSlots = 4;
+    options.pluginTimeout = 10;
+
+    // The outputs of the jobs are kept in memory, as long as they take less than this
+    options.outputMemory = 64;
+
+    // The jobs have no limits, unless they are given for every job or for a single job
+    options.jobWallLimit = 0;
+    options.jobCpuLimit = 0;
+    options.jobMemoryLimit = 0;
+    options.jobOutputLimit = 0;
+
+    // A running job that is stopped gets some time to clean up before it is killed
+    options.stopGrace = 5;
+
+    // The jobs float across all the cores, unless a placement policy is given
+    options.placement = "none";
+
+    // The outputs of the cacheable jobs are reused for a while, as long as they fit in the budget
+    options.resultCacheMemory = 32;
+    options.resultTimeToLive = 600;
+    options.detachedMemory = 64;
+    options.detachedTimeToLive = 3600;
+    options.compressThreshold = 4096;
+
+    // A client that takes none of its output for this long is dropped, so that it does not pile up outputs in the server
+    options.sendTimeout = 30;
+
+    // The blobs of the jobs are kept across runs of the server, as long as they fit in the budget
+    options.blobDirectory = "blobs";
+    options.blobBudget = 1024;
+
+    // Assign the optional settings
+    for (int i = 4; i < argc; i += 2) {
+
+        std::string option = argv[i];
+
+        if (option == "--cpus") { options.cpus = atoi(argv[i + 1]); }
+        else if (option == "--mem") { options.memory = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--max-preemptions") { options.maxPreemptions = atoi(argv[i + 1]); }
+        else if (option == "--plugin-dir") { options.pluginDirectory = argv[i + 1]; }
+        else if (option == "--plugin-slots") { options.pluginSlots = atoi(argv[i + 1]); }
+        else if (option == "--plugin-timeout") { options.pluginTimeout = atoi(argv[i + 1]); }
+        else if (option == "--output-memory") { options.outputMemory = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--job-timeout") { options.jobWallLimit = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--job-cpu-limit") { options.jobCpuLimit = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--job-mem-limit") { options.jobMemoryLimit = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--job-output-limit") { options.jobOutputLimit = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--stop-grace") { options.stopGrace = atoi(argv[i + 1]); }
+        else if (option == "--placement") { options.placement = argv[i + 1]; }
+        else if (option == "--result-cache") { options.resultCacheMemory = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--result-ttl") { options.resultTimeToLive = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--detached-memory") { options.detachedMemory = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--detached-ttl") { options.detachedTimeToLive = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--compress-threshold") { options.compressThreshold = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--send-timeout") { options.sendTimeout = strtoul(argv[i + 1], NULL, 10); }
+        else if (option == "--blob-dir") { options.blobDirectory = argv[i + 1]; }
+        else if (option == "--blob-budget") { options.blobBudget = strtoul(argv[i + 1], NULL, 10); }
+        else {
+            std::cout << "Unknown option: " << option << std::endl;
+            return false;
+        }
+
+    }
+
     return true;
 
 }
@@ -1,12 +1,20 @@
 /* Filename: client.cpp */
 
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
 #include "../../include/jobCommanderProcess.h"
 #include "../../include/clientCommands.h"
 #include "../../include/communication.h"
+#include "../../include/common.h"
+#include "../../include/sha256.h"
+
+#define INPUT_FRAME_SIZE (65536)
 
 /* Namespace alias */
 namespace ClientCommunication = Application_Client_Server_Communication::Application_Job_Commander_Client;
 namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+namespace Sha = Application_Job_Commander_Client::Application_Sha256;
 
 /* Declare Static Variables */
 std::string Client::Process::serverName;
@@ -19,6 +27,147 @@ struct sockaddr_in Client::Process::serverAddress;
 
 pid_t Client::Process::processID;
 
+int Client::Process::input_FD = -1;
+
+/**
+ * @brief Supporting function that returns whether the given response of the server to an issueJob
+ * or issueJobArray command means that the job was submitted, so that its output will follow.
+ * 
+ * @param serverResponse the response of the server
+ * 
+ * @return true if the job was submitted, false otherwise
+*/
+static bool isJobSubmitted(const std::string& serverResponse) {
+
+    const std::string submitted = "SUBMITTED";
+
+    return serverResponse.size() >= submitted.size() &&
+        serverResponse.compare(serverResponse.size() - submitted.size(), submitted.size(), submitted) == 0;
+
+}
+
+/**
+ * @brief Supporting function that returns whether the given response of the server to an upload
+ * command means that the server does not have the blob and waits for it.
+ * 
+ * @param serverResponse the response of the server
+ * 
+ * @return true if the blob has to be sent, false otherwise
+*/
+static bool isBlobRequested(const std::string& serverResponse) {
+
+    const std::string ready = "READY";
+
+    return serverResponse.size() >= ready.size() &&
+        serverResponse.compare(serverResponse.size() - ready.size(), ready.size(), ready) == 0;
+
+}
+
+/**
+ * @brief Supporting function that returns whether the user gave the given option to a job, among
+ * the '--option value' pairs placed before the actual job.
+ * 
+ * @param job the job, along with its options
+ * @param option the option to look for
+ * 
+ * @return true if the option was given, false otherwise
+*/
+static bool isOptionGiven(std::string job, const std::string& option) {
+
+    while (job.compare(0, 2, "--") == 0) {
+        if (getFirstWord(job) == option) return true;
+        job = removeFirstWord(removeFirstWord(job));
+    }
+
+    return false;
+
+}
+
+/**
+ * @brief Supporting function that returns the value the user gave to an option of a job, among
+ * the '--option value' pairs placed before the actual job.
+ * 
+ * @param job the job, along with its options
+ * @param option the option to look for
+ * 
+ * @return the value of the option, or an empty string if it was not given
+*/
+static std::string getOptionValue(std::string job, const std::string& option) {
+
+    while (job.compare(0, 2, "--") == 0) {
+        if (getFirstWord(job) == option) return getFirstWord(removeFirstWord(job));
+        job = removeFirstWord(removeFirstWord(job));
+    }
+
+    return "";
+
+}
+
+/**
+ * @brief Supporting function that replaces the value of an option of a job, among the '--option value'
+ * pairs placed before the actual job.
+ * 
+ * @param job the job, along with its options
+ * @param option the option to replace the value of
+ * @param value the new value of the option
+ * 
+ * @return the job with the new value of the option
+*/
+static std::string replaceOptionValue(std::string job, const std::string& option, const std::string& value) {
+
+    std::string options;
+
+    while (job.compare(0, 2, "--") == 0) {
+        std::string name = getFirstWord(job);
+        options += name + " " + (name == option ? value : getFirstWord(removeFirstWord(job))) + " ";
+        job = removeFirstWord(removeFirstWord(job));
+    }
+
+    return options + job;
+
+}
+
+/**
+ * @brief Supporting function that sends some data of the input of a job to the server. The socket is
+ * written only while the server has not answered, so that a server that no longer reads the input can
+ * never leave the client blocked.
+ * 
+ * @param socketID the socket of the connection
+ * @param data the data to send
+ * @param size the size of the data
+ * 
+ * @return true if the data was sent, false if the server answered first or the connection failed
+*/
+static bool sendInputData(const int socketID, const char* data, size_t size) {
+
+    struct pollfd fd = { socketID, POLLIN | POLLOUT, 0 };
+
+    while (size > 0) {
+
+        if (poll(&fd, 1, -1) == -1) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        if (fd.revents & (POLLIN | POLLERR | POLLHUP)) {
+            return false;
+        }
+
+        ssize_t sent = send(socketID, data, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) continue;
+            return false;
+        }
+
+        data += sent;
+        size -= sent;
+
+    }
+
+    return true;
+
+}
+
 /**
  * @brief Initializer of the Job Commander Process. Works like a constructor and initializes 
  * the appropriate data needed for communication with the server, the server name, the port 
@@ -36,6 +185,85 @@ void Client::Process::init(const std::string serverName, const port_num_t portNu
 
 }
 
+/**
+ * @brief Opens the input of the job, if the user gave one to an issueJob command. The input is
+ * a local file, or the standard input of the client for '-', and it is streamed once the job is
+ * submitted, so the command only tells the server that the input follows. The file of an upload
+ * command is opened and hashed instead, so the command tells the server the digest and the size
+ * of the blob, and the blob is streamed only if the server does not have it.
+ * 
+ * @return true if there is no input or it was opened successfully, false otherwise
+*/
+bool Client::Process::openJobInput(void) {
+
+    if (getClientCommandMode(Client::Process::command) == CC::JECC_UPLOAD) {
+        return Client::Process::openBlob();
+    }
+
+    std::string job = removeFirstWord(Client::Process::command);
+    std::string input = getOptionValue(job, "--input");
+
+    if (getClientCommandMode(Client::Process::command) != CC::JECC_ISSUE_JOB || input.empty()) {
+        return true;
+    }
+
+    if (input == "-") {
+        Client::Process::input_FD = STDIN_FILENO;
+    } else if ((Client::Process::input_FD = open(input.c_str(), O_RDONLY | O_CLOEXEC)) == -1) {
+        perror("Error opening job input");
+        return false;
+    }
+
+    Client::Process::command = getFirstWord(Client::Process::command) + " " + replaceOptionValue(job, "--input", "stream");
+
+    return true;
+
+}
+
+/**
+ * @brief Opens the file of an upload command and hashes it, so that the command tells the server
+ * the digest and the size of the blob instead of the name of the file. The file is read again from
+ * the start if the server does not have the blob.
+ * 
+ * @return true if the file was opened and hashed successfully, false otherwise
+*/
+bool Client::Process::openBlob(void) {
+
+    std::string path = removeFirstWord(Client::Process::command);
+
+    if ((Client::Process::input_FD = open(path.c_str(), O_RDONLY | O_CLOEXEC)) == -1) {
+        perror("Error opening blob");
+        return false;
+    }
+
+    Sha::Context context;
+    Sha::Digest::init(context);
+
+    char* buffer = new char[INPUT_FRAME_SIZE];
+    ssize_t bytes;
+
+    while ((bytes = read(Client::Process::input_FD, buffer, INPUT_FRAME_SIZE)) != 0) {
+        if (bytes == -1 && errno == EINTR) continue;
+        if (bytes == -1) break;
+        Sha::Digest::update(context, buffer, bytes);
+    }
+
+    delete[] buffer;
+
+    if (bytes == -1 || lseek(Client::Process::input_FD, 0, SEEK_SET) == -1) {
+        perror("Error reading blob");
+        close(Client::Process::input_FD);
+        return false;
+    }
+
+    // The digest is taken after the size, since finishing the digest pads the data it counts
+    std::string size = std::to_string(context.length);
+    Client::Process::command = "upload " + Sha::Digest::finish(context) + " " + size;
+
+    return true;
+
+}
+
 /**
  * @brief Receives the IP address of the server, according to its machine name that is
  * located to.
@@ -112,7 +340,16 @@ bool Client::Process::connectToServer(void) {
 */
 bool Client::Process::sendCommand(void) {
 
-    const char* message = Client::Process::command.c_str();
+    std::string command = Client::Process::command;
+    CC::CC_Mode mode = getClientCommandMode(command);
+
+    // The client can decompress the outputs of the jobs, so it tells the server it may compress them, unless the user chose
+    // otherwise with '--compress no'. The server still decides which outputs are big enough and shrink enough to be compressed
+    if ((mode == CC::JECC_ISSUE_JOB || mode == CC::JECC_ISSUE_JOB_ARRAY) && !isOptionGiven(removeFirstWord(command), "--compress")) {
+        command = getFirstWord(command) + " --compress yes " + removeFirstWord(command);
+    }
+
+    const char* message = command.c_str();
     ssize_t messageSize = strlen(message);
 
     send(Client::Process::socket_ID, &messageSize, sizeof(ssize_t), 0);
@@ -138,11 +375,53 @@ bool Client::Process::receiveServerResponse(void) {
         ClientCommunication::receiveIssueJobResponse(Client::Process::socket_ID, serverResponse);
         std::cout << serverResponse << std::endl;
 
-        if (serverResponse != "JOB SUBMIT CANCELED BECAUSE OF SERVER TERMINATION") {
-            ClientCommunication::receiveIssueJobResponse(Client::Process::socket_ID, serverResponse);
-            std::cout << serverResponse << std::endl;
+        // The output of the job follows only if the job was actually submitted, after its input if it has one
+        if (isJobSubmitted(serverResponse)) {
+
+            if (Client::Process::input_FD != -1) {
+                Client::Process::sendJobInput();
+            }
+
+            std::string job = removeFirstWord(Client::Process::command);
+            CC::JobOptions options;
+
+            // A recurring job sends a new output on every period, until it is stopped or the server terminates
+            bool valid = parseJobOptions(job, options);
+            bool recurring = valid && options.period > 0;
+
+            if (valid && options.streamOutput) {
+                ClientCommunication::receiveStreamedJobOutput(Client::Process::socket_ID);
+            }
+            else while (ClientCommunication::receiveIssueJobResponse(Client::Process::socket_ID, serverResponse)) {
+                std::cout << serverResponse << std::endl;
+                if (!recurring || serverResponse.compare(0, 5, "-----") != 0) break;
+            }
+
         }
     
+    } else if (mode == CC::JECC_ISSUE_JOB_ARRAY) {
+
+        ClientCommunication::receiveIssueJobResponse(Client::Process::socket_ID, serverResponse);
+        std::cout << serverResponse << std::endl;
+
+        // The outputs of the tasks follow only if the job array was actually submitted
+        std::string job = removeFirstWord(Client::Process::command);
+        unsigned long first, last;
+
+        if (isJobSubmitted(serverResponse) && parseJobArrayRange(job, first, last)) {
+
+            // Receive the output of every task, until a notification says that the remaining tasks will not run
+            for (unsigned long i = first; i <= last; i++) {
+
+                if (!ClientCommunication::receiveIssueJobResponse(Client::Process::socket_ID, serverResponse)) break;
+                std::cout << serverResponse << std::endl;
+
+                if (serverResponse.compare(0, 5, "-----") != 0) break;
+
+            }
+
+        }
+
     } else if (mode == CC::JECC_POLL) {
 
         ClientCommunication::receivePollResponse(Client::Process::socket_ID, serverResponse);
@@ -153,6 +432,34 @@ bool Client::Process::receiveServerResponse(void) {
         ClientCommunication::receiveStopResponse(Client::Process::socket_ID, serverResponse);
         std::cout << serverResponse << std::endl;
 
+    } else if (mode == CC::JECC_STATS) {
+
+        ClientCommunication::receiveStatsResponse(Client::Process::socket_ID, serverResponse);
+        std::cout << serverResponse << std::endl;
+
+    } else if (mode == CC::JECC_WATCH) {
+
+        ClientCommunication::receiveWatchEvents(Client::Process::socket_ID);
+
+    } else if (mode == CC::JECC_RESULT) {
+
+        ClientCommunication::receiveResultResponse(Client::Process::socket_ID, serverResponse);
+        std::cout << serverResponse << std::endl;
+
+    } else if (mode == CC::JECC_HAVE) {
+
+        ClientCommunication::receiveBlobResponse(Client::Process::socket_ID, serverResponse);
+        std::cout << serverResponse << std::endl;
+
+    } else if (mode == CC::JECC_UPLOAD) {
+
+        // The blob is sent only if the server is ready for it, and the server then says whether it was stored
+        if (ClientCommunication::receiveBlobResponse(Client::Process::socket_ID, serverResponse) && isBlobRequested(serverResponse)) {
+            Client::Process::sendJobInput();
+            ClientCommunication::receiveBlobResponse(Client::Process::socket_ID, serverResponse);
+        }
+        std::cout << serverResponse << std::endl;
+
     } else if (mode == CC::JECC_SET_CONCURRENCY) {
 
         ClientCommunication::receiveSetConcurrencyResponse(Client::Process::socket_ID, serverResponse);
@@ -168,3 +475,45 @@ bool Client::Process::receiveServerResponse(void) {
     return true;
     
 }
+
+/**
+ * @brief Streams the input of the job to the server after the job has been submitted, or the blob
+ * once the server is ready for it, as data frames ended by an empty frame. Sending stops early once
+ * the server answers, since then the job has either finished without reading the rest of its input
+ * or will never run, or the blob has been rejected.
+ * 
+ * @return true if the whole input was sent, false otherwise
+*/
+bool Client::Process::sendJobInput(void) {
+
+    // Every frame is read right behind the room for its size, so that the size and the data are sent together
+    char* frame = new char[sizeof(ssize_t) + INPUT_FRAME_SIZE];
+    bool sent = true;
+
+    while (sent) {
+
+        ssize_t bytes = read(Client::Process::input_FD, frame + sizeof(ssize_t), INPUT_FRAME_SIZE);
+
+        if (bytes == -1 && errno == EINTR) continue;
+        if (bytes == -1) {
+            perror("Error reading job input");
+            bytes = 0;
+        }
+
+        // The empty frame ends the input
+        memcpy(frame, &bytes, sizeof(ssize_t));
+        sent = sendInputData(Client::Process::socket_ID, frame, sizeof(ssize_t) + bytes);
+
+        if (bytes == 0) break;
+
+    }
+
+    delete[] frame;
+
+    if (Client::Process::input_FD != STDIN_FILENO) {
+        close(Client::Process::input_FD);
+    }
+
+    return sent;
+
+}
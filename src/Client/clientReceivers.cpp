@@ -3,10 +3,63 @@
 #include <unistd.h>
 #include "../../include/communication.h"
 #include "../../include/clientCommands.h"
+#include "../../include/lzCodec.h"
 
 /* Namespace alias */
 namespace ClientCommunication = Application_Client_Server_Communication::Application_Job_Commander_Client;
 namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+namespace Lz = Application_Job_Commander_Client::Application_Lz_Codec;
+
+/**
+ * @brief Supporting function that reads exactly the given number of bytes from the socket.
+ * 
+ * @param socketID the id of the socket used for communication
+ * @param buffer the buffer to fill
+ * @param size the number of bytes to read
+ * 
+ * @return true if all the bytes were read, false otherwise
+*/
+static bool readExactly(const int socketID, char* buffer, const ssize_t size) {
+
+    ssize_t totalBytesRead = 0;
+    while (totalBytesRead < size) 
+    {
+        ssize_t bytesRead = read(socketID, buffer + totalBytesRead, size - totalBytesRead);
+        
+        if (bytesRead <= 0) {
+            if (bytesRead == -1) perror("Error receiving server response");
+            return false;
+        }
+
+        totalBytesRead += bytesRead;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Supporting function that reads a message of the server, which is its size followed
+ * by its bytes.
+ * 
+ * @param socketID the id of the socket used for communication
+ * @param message the message that was read
+ * 
+ * @return true if the whole message was read, false otherwise
+*/
+static bool readMessage(const int socketID, std::string& message) {
+
+    ssize_t messageSize;
+
+    if (!readExactly(socketID, (char*)&messageSize, sizeof(ssize_t))) {
+        return false;
+    }
+
+    message.resize(messageSize);
+
+    return readExactly(socketID, &message[0], messageSize);
+
+}
 
 /**
  * @brief Handles receiving the server response, in case the client command to the server
@@ -20,50 +73,100 @@ namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
 */
 bool ClientCommunication::receiveIssueJobResponse(const int socketID, std::string& serverResponse) {
 
-    // Create variables that will hold the response and its size
-    ssize_t responseSize;
-    char* response;
-
-    // First read the response size
-    ssize_t bytesRead = read(socketID, &responseSize, sizeof(ssize_t));
-    if (bytesRead == -1) {
-        perror("Error receiving server response size");
+    // A compressed response starts with a null byte, so its whole size is kept. A server that cuts off the
+    // transfer, like the sender stage does for a client that stalls, ends it early, which is reported instead
+    if (!readMessage(socketID, serverResponse)) {
+        std::cerr << "Incomplete server response" << std::endl;
+        serverResponse.clear();
         return false;
-    } 
-    else if (bytesRead != sizeof(ssize_t)) {
-        std::cerr << "Incomplete read of response size" << std::endl;
+    }
+
+    // An output the server compressed is decompressed transparently
+    if (Lz::Codec::isPacked(serverResponse) && !Lz::Codec::unpack(serverResponse)) {
+        std::cerr << "Corrupted compressed server response" << std::endl;
         return false;
     }
 
-    // Allocate memory for the response
-    response = new char[responseSize + 1];
-    if (response == nullptr) {
-        perror("Error allocating memory");
+    return true;
+}
+
+/**
+ * @brief Handles receiving the output of a job issued with '--output stream'. The output
+ * arrives as a start marker, data frames that are printed as soon as they arrive, an empty
+ * frame and an end marker.
+ * 
+ * @param socketID the id of the socket used for communication
+ * 
+ * @return true if the whole output was received successfully, false otherwise 
+*/
+bool ClientCommunication::receiveStreamedJobOutput(const int socketID) {
+
+    std::string marker;
+
+    // The start marker, or a notification that the job will not run
+    if (!ClientCommunication::receiveIssueJobResponse(socketID, marker)) {
         return false;
     }
 
-    // Then read the actual response
-    ssize_t totalBytesRead = 0;
-    while (totalBytesRead < responseSize) 
-    {
-        ssize_t bytesRead = read(socketID, response + totalBytesRead, responseSize - totalBytesRead);
-        
-        if (bytesRead == -1) {
-            perror("Error receiving server response");
-            delete[] response;
+    std::cout << marker << std::endl;
+    if (marker.compare(0, 5, "-----") != 0) {
+        return true;
+    }
+
+    // Print every data frame as it arrives, until the empty frame
+    std::vector<char> chunk;
+    ssize_t chunkSize;
+
+    while (readExactly(socketID, (char*)&chunkSize, sizeof(ssize_t)) && chunkSize > 0) {
+
+        chunk.resize(chunkSize);
+        if (!readExactly(socketID, chunk.data(), chunkSize)) {
             return false;
         }
 
-        totalBytesRead += bytesRead;
+        std::cout.write(chunk.data(), chunkSize);
+        std::cout.flush();
+
     }
 
-    // Initialize the server response
-    response[responseSize] = '\0';
-    serverResponse = response;
+    if (chunkSize != 0 || !ClientCommunication::receiveIssueJobResponse(socketID, marker)) {
+        return false;
+    }
 
-    delete[] response;
+    std::cout << std::endl << marker << std::endl;
 
     return true;
+
+}
+
+/**
+ * @brief Handles receiving the completion events of a 'watch' command. The confirmation of
+ * the server and every message of events are printed as soon as they arrive, until the watch
+ * ends, the server terminates or rejects the watch.
+ * 
+ * @param socketID the id of the socket used for communication
+ * 
+ * @return true if the watch ended normally, false otherwise 
+*/
+bool ClientCommunication::receiveWatchEvents(const int socketID) {
+
+    std::string message;
+
+    while (ClientCommunication::receiveIssueJobResponse(socketID, message)) {
+
+        std::cout << message << std::endl;
+
+        if (message == "WATCH ENDED" || message == "SERVER TERMINATED") {
+            return true;
+        }
+        if (message.compare(0, 14, "WATCH REJECTED") == 0) {
+            return false;
+        }
+
+    }
+
+    return false;
+
 }
 
 /**
@@ -178,6 +281,56 @@ bool ClientCommunication::receiveStopResponse(const int socketID, std::string& s
 
 }
 
+/**
+ * @brief Handles to receive the server response, in case the client command to the server
+ * was to get the stats of the server. Then the corresponding response of the server has to be
+ * a message with a report of the server.
+ * 
+ * @param socketID the id of the socket used for communication
+ * @param serverResponse the response of the server
+ * 
+ * @return true if the response was received successfully, false otherwise 
+*/
+bool ClientCommunication::receiveStatsResponse(const int socketID, std::string& serverResponse) {
+
+    return readMessage(socketID, serverResponse);
+
+}
+
+/**
+ * @brief Handles to receive the server response, in case the client command to the server
+ * was to get the result of a detached job. Then the corresponding response of the server has
+ * to be the output of the job along with its exit code and timings, or a message saying the
+ * job has not finished yet or its result was not found.
+ * 
+ * @param socketID the id of the socket used for communication
+ * @param serverResponse the response of the server
+ * 
+ * @return true if the response was received successfully, false otherwise 
+*/
+bool ClientCommunication::receiveResultResponse(const int socketID, std::string& serverResponse) {
+
+    return readMessage(socketID, serverResponse);
+
+}
+
+/**
+ * @brief Handles to receive the server response, in case the client command to the server
+ * was to check for or upload a blob. Then the corresponding response of the server has to be
+ * a message saying whether the server has the blob, is ready to receive it or has stored it,
+ * or why the upload was rejected.
+ * 
+ * @param socketID the id of the socket used for communication
+ * @param serverResponse the response of the server
+ * 
+ * @return true if the response was received successfully, false otherwise 
+*/
+bool ClientCommunication::receiveBlobResponse(const int socketID, std::string& serverResponse) {
+
+    return readMessage(socketID, serverResponse);
+
+}
+
 /**
  * @brief Handles to receive the server response, in case the client command to the server
  * was to exit. Then the corresponding response of the server has to be a message
@@ -1,9 +1,28 @@
 /* Filename: controllerThread.cpp */
 
+#include <time.h>
+#include <signal.h>
 #include <string.h>
 #include "../../../include/common.h"
 #include "../../../include/controllerThread.h"
 #include "../../../include/waitingBufferQueue.h"
+#include "../../../include/resourcePool.h"
+#include "../../../include/runningJobsTable.h"
+#include "../../../include/dependencyGraph.h"
+#include "../../../include/timerWheel.h"
+#include "../../../include/pluginJobs.h"
+#include "../../../include/jobLauncher.h"
+#include "../../../include/cpuPlacement.h"
+#include "../../../include/resultCache.h"
+#include "../../../include/jobSupervisor.h"
+#include "../../../include/jobCoalescing.h"
+#include "../../../include/jobResults.h"
+#include "../../../include/completionEvents.h"
+#include "../../../include/outputReducers.h"
+#include "../../../include/outputSender.h"
+#include "../../../include/clientMonitor.h"
+#include "../../../include/blobStore.h"
+#include "../../../include/sha256.h"
 
 #define KNRM  "\x1B[0m"
 #define KRED  "\x1B[31m"
@@ -18,11 +37,129 @@
 namespace Server = Application_Job_Executor_Server;
 namespace Controller = Application_Job_Executor_Server::Application_Controller_Thread;
 namespace WaitingBuffer = Application_Job_Executor_Server::Application_Common_Waiting_Buffer;
+namespace Resources = Application_Job_Executor_Server::Application_Resource_Pool;
+namespace RunningJobs = Application_Job_Executor_Server::Application_Running_Jobs;
+namespace Dependencies = Application_Job_Executor_Server::Application_Job_Dependencies;
+namespace Timers = Application_Job_Executor_Server::Application_Timer_Wheel;
+namespace Plugins = Application_Job_Executor_Server::Application_Plugin_Jobs;
+namespace Launch = Application_Job_Executor_Server::Application_Job_Launcher;
+namespace Placement = Application_Job_Executor_Server::Application_Cpu_Placement;
+namespace Results = Application_Job_Executor_Server::Application_Result_Cache;
+namespace Supervision = Application_Job_Executor_Server::Application_Job_Supervisor;
+namespace Coalescing = Application_Job_Executor_Server::Application_Job_Coalescing;
+namespace JobResults = Application_Job_Executor_Server::Application_Job_Results;
+namespace Events = Application_Job_Executor_Server::Application_Completion_Events;
+namespace Reducers = Application_Job_Executor_Server::Application_Output_Reducers;
+namespace Sending = Application_Job_Executor_Server::Application_Output_Sender;
+namespace Monitoring = Application_Job_Executor_Server::Application_Client_Monitor;
+namespace Blobs = Application_Job_Executor_Server::Application_Blob_Store;
+namespace Sha = Application_Job_Commander_Client::Application_Sha256;
 
 /* Static variables initialization */
 unsigned int Controller::Thread::jobsEntered = 0; // Initialize the number of jobs entered
 bool Controller::Thread::shouldStop = false;
 
+/**
+ * @brief Supporting function that sends a message to a client through the given socket. It
+ * first sends the size of the message and then the actual message.
+ * 
+ * @param socketID the socket of the client
+ * @param message the message to send
+*/
+static void sendMessage(const int socketID, const std::string message) {
+
+    ssize_t messageSize = message.size();
+
+    send(socketID, &messageSize, sizeof(ssize_t), 0);
+    send(socketID, message.c_str(), messageSize, 0);
+
+}
+
+/**
+ * @brief Supporting function that tells a client that its job has been submitted. The client of a
+ * detached job does not wait for the output, so its socket is closed right after the response. The
+ * socket of any other client is watched from now on, so that its job is dropped if it goes away,
+ * until it has got every output it waits for.
+ * 
+ * @param socketID the socket of the client
+ * @param description the job ID and the job, as they are shown to the client
+ * @param triplate the triplate of the job
+*/
+static void sendSubmissionResponse(const int socketID, const std::string description, const CC::JobTriplate& triplate) {
+
+    sendMessage(socketID, "JOB <" + description + "> " + (triplate.options.detach ? "DETACHED" : "SUBMITTED"));
+
+    if (triplate.options.detach) {
+        close(socketID);
+    } else {
+        // Every task of a job array sends its own output, and a recurring job has no last one
+        unsigned long outputs = triplate.isArray ? triplate.arrayLast - triplate.arrayNext + 1 : (triplate.options.period != 0 ? 0 : 1);
+        Monitoring::Monitor::watch(socketID, triplate.jobID, triplate.options.cancelOnDisconnect, outputs);
+    }
+
+}
+
+/**
+ * @brief Supporting function that checks that the options of a job can be used together.
+ * 
+ * @param job the job without its options
+ * @param options the options of the job
+ * @param isArray true if the job is a job array
+ * 
+ * @return the reason the options can not be used together, or an empty string if they can
+*/
+static std::string getOptionsConflict(const std::string& job, const CC::JobOptions& options, const bool isArray) {
+
+    // A job that waits for others starts when they end, not at a time of its own
+    if (!options.dependencies.empty() && (options.startTime != 0 || options.period != 0)) {
+        return "--after CAN NOT BE USED WITH --at OR --every";
+    }
+
+    if (!Reducers::Reducer::isValid(options)) {
+        return "OF INVALID OUTPUT REDUCERS";
+    }
+
+    // A streamed output needs the client for itself and never passes through the server whole
+    if (options.streamOutput && (isArray || options.period != 0)) {
+        return "--output stream CAN NOT BE USED WITH A JOB ARRAY OR --every";
+    }
+    if (options.streamOutput && (options.cacheable || options.coalesce)) {
+        return "--output stream CAN NOT BE USED WITH --cacheable OR --coalesce";
+    }
+    if (options.streamOutput && Reducers::Reducer::isEnabled(options)) {
+        return "--output stream CAN NOT BE USED WITH OUTPUT REDUCERS";
+    }
+
+    // A detached job keeps a single result
+    if (options.detach && (options.streamOutput || isArray || options.period != 0)) {
+        return "--detach CAN NOT BE USED WITH --output stream, A JOB ARRAY OR --every";
+    }
+
+    // An input is sent whole, once, by a client that stays connected, before it reads anything
+    if (!options.input.empty() && options.input != "stream") {
+        return "OF INVALID INPUT";
+    }
+    if (!options.input.empty() && options.streamOutput) {
+        return "--input CAN NOT BE USED WITH --output stream";
+    }
+    if (!options.input.empty() && (options.detach || isArray || options.period != 0)) {
+        return "--input CAN NOT BE USED WITH --detach, A JOB ARRAY OR --every";
+    }
+
+    // The output of a job with an input or blobs depends on more than its arguments
+    if ((!options.input.empty() || !options.blobs.empty()) && (options.cacheable || options.coalesce)) {
+        return "--input AND --blobs CAN NOT BE USED WITH --cacheable OR --coalesce";
+    }
+
+    // A plugin job runs inside the server, without a standard input or a working directory
+    if ((!options.input.empty() || !options.blobs.empty()) && Plugins::Registry::isPluginJob(job)) {
+        return "--input AND --blobs CAN NOT BE USED WITH A PLUGIN JOB";
+    }
+
+    return "";
+
+}
+
 /**
  * @brief Constructor of the Controller Thread. It stores the socket of the client
  * that is being used for communication with the client.
@@ -88,9 +225,15 @@ bool Controller::Thread::executeTask(void) {
     switch (this->clientCommandMode) {
 
         case CC::JECC_ISSUE_JOB: this->insertNewJobToBufferQueue(); break;
+        case CC::JECC_ISSUE_JOB_ARRAY: this->insertNewJobToBufferQueue(); break;
         case CC::JECC_SET_CONCURRENCY: this->setServerConcurrencyLevel(); break;
         case CC::JECC_POLL: this->sendWaitingJobsToClient(); break;
         case CC::JECC_STOP: this->removeJobFromBufferQueue(); break;
+        case CC::JECC_STATS: this->sendServerStatsToClient(); break;
+        case CC::JECC_RESULT: this->sendJobResultToClient(); break;
+        case CC::JECC_WATCH: this->subscribeClientToEvents(); break;
+        case CC::JECC_HAVE: this->checkClientBlob(); break;
+        case CC::JECC_UPLOAD: this->storeClientBlob(); break;
         case CC::JECC_EXIT: this->terminateServer(); break;
         default: break;
     
@@ -100,9 +243,10 @@ bool Controller::Thread::executeTask(void) {
 }
 
 /**
- * @brief Handles the issueJob client command. It receives the full command of the
- * client, determines what the bash job is and puts it to the common queue buffer
- * to be executed later on by a worker thread.
+ * @brief Handles the issueJob and issueJobArray client commands. It receives the full
+ * command of the client, determines what the bash job is and puts it to the common queue
+ * buffer to be executed later on by a worker thread. A job array takes a single position
+ * in the buffer, no matter how many tasks it has.
  * 
  * @return true, if the process was successfull, false otherwise
 */
@@ -113,60 +257,199 @@ bool Controller::Thread::insertNewJobToBufferQueue(void) {
     pthread_cond_signal(&Server::Process::condVar_serverContinue);
     pthread_mutex_unlock(&Server::Process::mutex_serverContinue);
 
-    pthread_mutex_lock(&Server::Process::mutex_controller);
+    // Separate the options of the job from the actual job and check that the server can ever run it
+    std::string job = removeFirstWord(this->clientCommand);
+    CC::JobOptions options;
+    bool isArray = this->clientCommandMode == CC::JECC_ISSUE_JOB_ARRAY;
+    unsigned long arrayFirst = 0, arrayLast = 0;
 
-    // If the waiting queue is full, the controller thread must wait until a job is removed
-    while (WaitingBuffer::Queue::isFull()) {
-        
-        pthread_cond_wait(&Server::Process::condVar_controller, &Server::Process::mutex_controller);
+    if (isArray && !parseJobArrayRange(job, arrayFirst, arrayLast)) {
+        sendMessage(this->clientSocket, "JOB ARRAY REJECTED BECAUSE OF INVALID RANGE");
+        return false;
+    }
+    if (!parseJobOptions(job, options)) {
+        sendMessage(this->clientSocket, "JOB REJECTED BECAUSE OF INVALID OPTIONS");
+        return false;
+    }
+    std::string conflict = getOptionsConflict(job, options, isArray);
+    if (!conflict.empty()) {
+        sendMessage(this->clientSocket, "JOB REJECTED BECAUSE " + conflict);
+        return false;
+    }
+    for (std::map<std::string, std::string>::const_iterator it = options.blobs.begin(); it != options.blobs.end(); it++) {
+        if (!Blobs::Store::has(it->second)) {
+            sendMessage(this->clientSocket, "JOB REJECTED BECAUSE OF UNKNOWN BLOB " + it->second);
+            return false;
+        }
+    }
+    if (Plugins::Registry::isPluginJob(job) && !Plugins::Registry::isValidPluginJob(job)) {
+        sendMessage(this->clientSocket, "JOB REJECTED BECAUSE OF INVALID OR DISABLED PLUGIN");
+        return false;
+    }
+    if (!Resources::Pool::canEverFit(options.cpus, options.memory)) {
+        sendMessage(this->clientSocket, "JOB REJECTED BECAUSE ITS RESOURCES EXCEED THE SERVER CAPACITY");
+        return false;
+    }
 
-        // If the server should stop notify the client that the job was not placed in the queue, due to server termination
-        if (Controller::Thread::shouldStop) 
-        {
-            char notificationMessage[] = "JOB SUBMIT CANCELED BECAUSE OF SERVER TERMINATION";
-            ssize_t notificationSize = strlen(notificationMessage);
+    // Initialize the appropriate data for a new job triplate. Nothing is ever sent to the client of a detached job after the submission
+    std::string jobID = "job_" + std::to_string(++Controller::Thread::jobsEntered);
+    int socket_ID = options.detach ? -1 : this->clientSocket;
 
-            send(this->clientSocket, &notificationSize, sizeof(ssize_t), 0);
-            send(this->clientSocket, notificationMessage, notificationSize, 0);
+    // Create the new job triplate of the new command and add it to the dependency graph. A job array
+    // is a single triplate, whose tasks are created by the workers one at a time
+    CC::JobTriplate newJobTriplate = { jobID, job, socket_ID, options, isArray, arrayFirst, arrayLast, time(NULL) };
+    Dependencies::Admission admission = Dependencies::Graph::addJob(newJobTriplate);
 
-            pthread_mutex_unlock(&Server::Process::mutex_controller);
+    if (admission == Dependencies::JDA_UNKNOWN) {
+        sendMessage(this->clientSocket, "JOB REJECTED BECAUSE OF UNKNOWN DEPENDENCY");
+        return false;
+    }
+    if (admission == Dependencies::JDA_FAILED) {
+        sendMessage(this->clientSocket, "JOB CANCELED BECAUSE A DEPENDENCY FAILED");
+        return false;
+    }
 
-            return true;
-        }
-    
+    // The result of a detached job is on its way from now on, however the job ends
+    if (options.detach) {
+        JobResults::Store::expect(jobID);
     }
 
-    pthread_mutex_unlock(&Server::Process::mutex_controller);
+    // A blocked job waits in the dependency graph instead of the queue, until its dependencies succeed
+    if (admission == Dependencies::JDA_BLOCKED) {
 
-    // Initialize the appropriate data for a new job triplate
-    std::string job = removeFirstWord(this->clientCommand);
-    std::string jobID = "job_" + std::to_string(++Controller::Thread::jobsEntered);
-    int socket_ID = this->clientSocket;
+        sendSubmissionResponse(this->clientSocket, jobID + ", " + job + (isArray ? ", " + std::to_string(arrayFirst) + ".." + std::to_string(arrayLast) : ""), newJobTriplate);
 
-    // Create the new job triplate of the new command and insert it to the waiting buffer queue
-    CC::JobTriplate newJobTriplate = { jobID, job, socket_ID };
+        std::cout << "---[" << KCYN << "New Job Submittion" << KWHT << "]--- | ";
+        std::cout << KCYN << "Controller Thread has blocked a new job" << KWHT << " | ";
+        std::cout <<  "Job ID: " << "[" << KGRN << newJobTriplate.jobID << KWHT << "]" << " | ";
+        std::cout <<  "Job command: " << "'" << KBLU << newJobTriplate.job << KWHT << "'" << " | ";
+        std::cout <<  "Waiting for: " << "[" << KYEL << options.dependencies.size() << " jobs" << KWHT << "]";
+        std::cout << std::endl;
 
-    pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
-    WaitingBuffer::Queue::insertJobTriplate(newJobTriplate);
-    pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
+        return true;
+
+    }
+
+    // A delayed or recurring job waits in the timer wheel, which places it in the queue when it is due
+    if (options.startTime != 0 || options.period != 0) {
+
+        Timers::Wheel::schedule(newJobTriplate);
+
+        sendSubmissionResponse(this->clientSocket, jobID + ", " + job, newJobTriplate);
+
+        std::cout << "---[" << KCYN << "New Job Submittion" << KWHT << "]--- | ";
+        std::cout << KCYN << "Controller Thread has scheduled a new job" << KWHT << " | ";
+        std::cout <<  "Job ID: " << "[" << KGRN << newJobTriplate.jobID << KWHT << "]" << " | ";
+        std::cout <<  "Job command: " << "'" << KBLU << newJobTriplate.job << KWHT << "'" << " | ";
+        std::cout <<  "Every: " << "[" << KYEL << options.period << " sec" << KWHT << "]";
+        std::cout << std::endl;
+
+        return true;
+
+    }
+
+    // A cacheable job that has already run with the same arguments gets its output right away, without taking a slot
+    std::string cachedOutput;
+    if (options.cacheable && !isArray && Results::Cache::lookup(job, cachedOutput)) {
+
+        sendSubmissionResponse(this->clientSocket, jobID + ", " + job, newJobTriplate);
+
+        std::cout << "---[" << KCYN << "New Job Submittion" << KWHT << "]--- | ";
+        std::cout << KCYN << "Controller Thread has found a cached job" << KWHT << " | ";
+        std::cout <<  "Job ID: " << "[" << KGRN << newJobTriplate.jobID << KWHT << "]" << " | ";
+        std::cout <<  "Job command: " << "'" << KBLU << newJobTriplate.job << KWHT << "'";
+        std::cout << std::endl;
 
-    // Set up server response for the client
-    std::string serverResponse = "JOB <" + jobID + ", " + job + "> SUBMITTED";
-    const char* response = serverResponse.c_str();
-    ssize_t responseSize = strlen(response);
+        Supervision::Supervisor::finishCachedJob(newJobTriplate, cachedOutput);
+
+        return true;
+
+    }
+
+    // A coalescing job identical to one that is queued or running waits for its output instead of running
+    std::string leaderID;
+    if (options.coalesce && !isArray && Coalescing::Coalescer::attach(newJobTriplate, leaderID)) {
+
+        sendSubmissionResponse(this->clientSocket, jobID + ", " + job, newJobTriplate);
+
+        std::cout << "---[" << KCYN << "New Job Submittion" << KWHT << "]--- | ";
+        std::cout << KCYN << "Controller Thread has coalesced a new job" << KWHT << " | ";
+        std::cout <<  "Job ID: " << "[" << KGRN << newJobTriplate.jobID << KWHT << "]" << " | ";
+        std::cout <<  "Job command: " << "'" << KBLU << newJobTriplate.job << KWHT << "'" << " | ";
+        std::cout <<  "With: " << "[" << KGRN << leaderID << KWHT << "]";
+        std::cout << std::endl;
+
+        return true;
+
+    }
+
+    // The room the controller thread waited for may be taken by another job first, in which case it waits again
+    bool inserted = false;
+    while (!inserted) {
+
+        pthread_mutex_lock(&Server::Process::mutex_controller);
+
+        // If the waiting queue is full, the controller thread must wait until a job is removed
+        while (WaitingBuffer::Queue::isFull()) {
+        
+            pthread_cond_wait(&Server::Process::condVar_controller, &Server::Process::mutex_controller);
+
+            // If the server should stop notify the client that the job was not placed in the queue, due to server termination
+            if (Controller::Thread::shouldStop) 
+            {
+                sendMessage(this->clientSocket, "JOB SUBMIT CANCELED BECAUSE OF SERVER TERMINATION");
+
+                pthread_mutex_unlock(&Server::Process::mutex_controller);
+
+                JobResults::Store::discard(jobID, "JOB SUBMIT CANCELED BECAUSE OF SERVER TERMINATION");
+                Server::Process::completeJob(jobID, false);
+                Events::Publisher::publish({ jobID, options.tag, false, false, -1, 0, 0 });
+
+                // The identical jobs that were attached to the job meanwhile are not placed in the queue either
+                std::vector<CC::JobTriplate> waiters;
+                if (options.coalesce) {
+                    Coalescing::Coalescer::detach(newJobTriplate, waiters);
+                }
+                for (unsigned int i = 0; i < waiters.size(); i++) {
+                    Sending::Sender::sendMessage(waiters[i].socketID, "JOB SUBMIT CANCELED BECAUSE OF SERVER TERMINATION");
+                    JobResults::Store::discard(waiters[i].jobID, "JOB SUBMIT CANCELED BECAUSE OF SERVER TERMINATION");
+                    Server::Process::completeJob(waiters[i].jobID, false);
+                    Events::Publisher::publish({ waiters[i].jobID, waiters[i].options.tag, false, false, -1, 0, 0 });
+                }
+
+                return true;
+            }
+    
+        }
+
+        pthread_mutex_unlock(&Server::Process::mutex_controller);
+
+        // Insert the new job triplate to the waiting buffer queue
+        pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
+        inserted = WaitingBuffer::Queue::insertJobTriplate(newJobTriplate);
+        pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
+
+    }
 
     // Send the response back to the client
-    send(socket_ID, &responseSize, sizeof(ssize_t), 0);
-    send(socket_ID, response, responseSize, 0);
+    sendSubmissionResponse(this->clientSocket, jobID + ", " + job + (isArray ? ", " + std::to_string(arrayFirst) + ".." + std::to_string(arrayLast) : ""), newJobTriplate);
 
     std::cout << "---[" << KCYN << "New Job Submittion" << KWHT << "]--- | ";
     std::cout << KCYN << "Controller Thread has submitted a new job" << KWHT << " | ";
     std::cout <<  "Job ID: " << "[" << KGRN << newJobTriplate.jobID << KWHT << "]" << " | ";
     std::cout <<  "Job command: " << "'" << KBLU << newJobTriplate.job << KWHT << "'" << " | ";
-    std::cout <<  "Socket ID: " << "[" << KRED << newJobTriplate.socketID << KWHT << "]";
+    std::cout <<  "Socket ID: " << "[" << KRED << newJobTriplate.socketID << KWHT << "]" << " | ";
+    std::cout <<  "Resources: " << "[" << KMAG << options.cpus << " CPU, " << options.memory << " MB" << KWHT << "]";
     std::cout << std::endl;
 
-    pthread_cond_signal(&Server::Process::condVar_worker); // Notify that a job has been placed in the queue
+    // Notify that a job has been placed in the queue. The tasks of a job array can be picked by every worker
+    pthread_mutex_lock(&Server::Process::mutex_worker);
+    if (isArray) {
+        pthread_cond_broadcast(&Server::Process::condVar_worker);
+    } else {
+        pthread_cond_signal(&Server::Process::condVar_worker);
+    }
+    pthread_mutex_unlock(&Server::Process::mutex_worker);
 
     return true;
 
@@ -216,7 +499,9 @@ bool Controller::Thread::setServerConcurrencyLevel(void) {
 
 /**
  * @brief Handles the poll client command. It iterates through the waiting buffer
- * queue, and sends each individual job triplate back to the client.
+ * queue, and sends each individual job triplate back to the client. With 'poll running'
+ * it sends the running jobs instead, along with how long they have been running and the
+ * cores they are placed on.
  * 
  * @return true, if the process was successfull, false otherwise
 */
@@ -227,6 +512,34 @@ bool Controller::Thread::sendWaitingJobsToClient(void) {
     pthread_cond_signal(&Server::Process::condVar_serverContinue);
     pthread_mutex_unlock(&Server::Process::mutex_serverContinue);
 
+    // Send the running jobs, in the same format as the waiting ones
+    if (removeFirstWord(this->clientCommand) == "running") {
+
+        std::vector<RunningJobs::RunningJob> jobs;
+
+        pthread_mutex_lock(&Server::Process::mutex_worker);
+        RunningJobs::Table::getJobs(jobs);
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+        ssize_t jobsSize = jobs.size();
+        send(this->clientSocket, &jobsSize, sizeof(ssize_t), 0);
+
+        for (unsigned int i = 0; i < jobs.size(); i++) {
+
+            std::string message = jobs[i].job + ", " + jobs[i].jobID + ", running for " + std::to_string(time(NULL) - jobs[i].startTime) + " sec";
+
+            if (!jobs[i].cores.empty()) message += ", cores " + Placement::Engine::format(jobs[i].cores);
+            if (jobs[i].suspended) message += ", suspended";
+            if (jobs[i].canceled) message += ", stopping";
+
+            sendMessage(this->clientSocket, message);
+
+        }
+
+        return true;
+
+    }
+
     // Select and send the number of jobs waiting to the client, to let it know how manu jobs to receive
     ssize_t bufferSize = WaitingBuffer::Queue::getSize();
     send(this->clientSocket, &bufferSize, sizeof(ssize_t), 0);
@@ -236,6 +549,11 @@ bool Controller::Thread::sendWaitingJobsToClient(void) {
 
         CC::JobTriplate triplate = WaitingBuffer::Queue::at(i);
         std::string currentMessage = triplate.job + ", " + triplate.jobID;
+
+        // Show the tasks of a job array that have not been handed out yet
+        if (triplate.isArray) {
+            currentMessage += "[" + std::to_string(triplate.arrayNext) + ".." + std::to_string(triplate.arrayLast) + "]";
+        }
         
         const char* message = currentMessage.c_str();
         ssize_t messageSize = strlen(message);
@@ -249,17 +567,388 @@ bool Controller::Thread::sendWaitingJobsToClient(void) {
 
 }
 
+/**
+ * @brief Handles the stats client command. It sends back a report of the server with its
+ * running and queued jobs, the hit rate of the executable cache of the launcher, the
+ * hit rate and the size of the result cache, the coalescing ratio of the identical jobs
+ * and the size of the blob store.
+ * 
+ * @return true, if the process was successfull, false otherwise
+*/
+bool Controller::Thread::sendServerStatsToClient(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_serverContinue);
+    Server::Process::continueExecution = true;
+    pthread_cond_signal(&Server::Process::condVar_serverContinue);
+    pthread_mutex_unlock(&Server::Process::mutex_serverContinue);
+
+    unsigned long hits, misses;
+    Launch::Launcher::getCacheStats(hits, misses);
+
+    // The hit rate is given with one decimal digit
+    unsigned long launches = hits + misses;
+    unsigned long hitRate = launches > 0 ? (hits * 1000 + launches / 2) / launches : 0;
+
+    std::string message;
+    message += "RUNNING JOBS: " + std::to_string(Server::Process::getRunningJobs()) + "\n";
+    message += "QUEUED JOBS: " + std::to_string(WaitingBuffer::Queue::getSize()) + "\n";
+    message += "CONCURRENCY: " + std::to_string(Server::Process::getConcurrency()) + "\n";
+    message += "EXECUTABLE CACHE: " + std::to_string(hits) + " HITS, " + std::to_string(misses) + " MISSES, ";
+    message += std::to_string(hitRate / 10) + "." + std::to_string(hitRate % 10) + "% HIT RATE\n";
+
+    unsigned long entries, bytes;
+    Results::Cache::getStats(hits, misses, entries, bytes);
+
+    unsigned long lookups = hits + misses;
+    hitRate = lookups > 0 ? (hits * 1000 + lookups / 2) / lookups : 0;
+
+    message += "RESULT CACHE: " + std::to_string(hits) + " HITS, " + std::to_string(misses) + " MISSES, ";
+    message += std::to_string(hitRate / 10) + "." + std::to_string(hitRate % 10) + "% HIT RATE, ";
+    message += std::to_string(entries) + " OUTPUTS, " + std::to_string(bytes) + " BYTES\n";
+
+    unsigned long submitted, attached;
+    Coalescing::Coalescer::getStats(submitted, attached);
+
+    unsigned long ratio = submitted > 0 ? (attached * 1000 + submitted / 2) / submitted : 0;
+
+    message += "COALESCED JOBS: " + std::to_string(attached) + " OF " + std::to_string(submitted) + ", ";
+    message += std::to_string(ratio / 10) + "." + std::to_string(ratio % 10) + "% COALESCING RATIO\n";
+
+    unsigned long blobs, inUse;
+    Blobs::Store::getStats(blobs, bytes, inUse);
+
+    message += "BLOB STORE: " + std::to_string(blobs) + " BLOBS, " + std::to_string(bytes) + " BYTES, " + std::to_string(inUse) + " IN USE";
+
+    sendMessage(this->clientSocket, message);
+
+    return true;
+
+}
+
+/**
+ * @brief Stops a running job. The whole process group of the job is sent
+ * SIGTERM, and a suspended job is continued so that it can handle it. The slot, the CPUs and the cores
+ * of the job are given back right away, so that a waiting job can start, and the supervisor kills the job
+ * if it is still running after the grace period of the server.
+ * 
+ * @param jobID the job ID of the job to stop
+ * 
+ * @return true if the job was running and has been stopped, false otherwise
+*/
+bool Controller::Thread::stopRunningJob(const std::string jobID) {
+
+    struct timespec killDeadline;
+    clock_gettime(CLOCK_MONOTONIC, &killDeadline);
+    killDeadline.tv_sec += Server::Process::getOptions().stopGrace;
+
+    pthread_mutex_lock(&Server::Process::mutex_worker);
+
+    RunningJobs::RunningJob* job = RunningJobs::Table::find(jobID);
+    if (job == nullptr || job->canceled) {
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+        return false;
+    }
+
+    kill(-job->processGroup, SIGTERM);
+
+    // A suspended job has already given back its slot and its CPUs
+    if (job->suspended) {
+        kill(-job->processGroup, SIGCONT);
+    } else {
+        Server::Process::decreaseRunningJobs();
+        Resources::Pool::release(job->cpus, 0);
+        Placement::Engine::release(job->cores);
+    }
+
+    RunningJobs::Table::setCanceled(job, killDeadline);
+
+    pthread_cond_broadcast(&Server::Process::condVar_worker);
+    pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+    std::cout << "---[" << KRED << "Job  Cancelation" << KWHT << "]--- | ";
+    std::cout << "Job ID: " << "[" << KGRN << jobID << KWHT << "]" << " | ";
+    std::cout << "Grace: " << "[" << KYEL << Server::Process::getOptions().stopGrace << " sec" << KWHT << "]" << std::endl;
+
+    return true;
+
+}
+
+/**
+ * @brief Handles the result client command. It sends back the output of a detached job along
+ * with its exit code and how long it waited and ran, or why it did not run, as many times as
+ * it is asked for until the result expires or is evicted.
+ * 
+ * @return true, if the process was successfull, false otherwise
+*/
+bool Controller::Thread::sendJobResultToClient(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_serverContinue);
+    Server::Process::continueExecution = true;
+    pthread_cond_signal(&Server::Process::condVar_serverContinue);
+    pthread_mutex_unlock(&Server::Process::mutex_serverContinue);
+
+    std::string jobID = removeFirstWord(this->clientCommand);
+    JobResults::JobResult result;
+    JobResults::ResultState state = JobResults::Store::fetch(jobID, result);
+
+    // Build the appropriate response, framed like the output the client would have waited for
+    std::string message;
+
+    if (state == JobResults::JRS_PENDING) {
+        message = "JOB " + jobID + " HAS NOT FINISHED YET";
+    }
+    else if (state == JobResults::JRS_UNKNOWN) {
+        message = "JOB " + jobID + " RESULT NOTFOUND";
+    }
+    else if (!result.ran) {
+        message = result.note;
+    }
+    else {
+
+        message = "-----" + jobID + " output start------\n" + result.output + "\n-----" + jobID + " output end------";
+
+        if (!result.note.empty()) {
+            message += "\n" + result.note;
+        }
+
+        message += "\nJOB " + jobID + (result.exitCode >= 0 ? " EXITED WITH CODE " + std::to_string(result.exitCode) : " ENDED WITHOUT AN EXIT CODE");
+        message += " AFTER WAITING " + std::to_string(result.started - result.submitted) + " SEC AND RUNNING " + std::to_string(result.finished - result.started) + " SEC";
+
+    }
+
+    sendMessage(this->clientSocket, message);
+
+    std::cout << "---[" << KMAG << "Result Retrieval" << KWHT << "]--- | ";
+    std::cout << "Job ID: " << "[" << KGRN << jobID << KWHT << "]" << " | ";
+    std::cout << "State: " << "[" << KYEL << (state == JobResults::JRS_FINISHED ? "FINISHED" : state == JobResults::JRS_PENDING ? "PENDING" : "NOTFOUND") << KWHT << "]" << std::endl;
+
+    return true;
+
+}
+
+/**
+ * @brief Handles the watch client command. It subscribes the connection of the client to the
+ * completion events of every job, of the jobs with a tag, or of a set of jobs, and hands the
+ * connection over to the publisher, which pushes the events to it as the jobs end.
+ * 
+ * @return true, if the process was successfull, false otherwise
+*/
+bool Controller::Thread::subscribeClientToEvents(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_serverContinue);
+    Server::Process::continueExecution = true;
+    pthread_cond_signal(&Server::Process::condVar_serverContinue);
+    pthread_mutex_unlock(&Server::Process::mutex_serverContinue);
+
+    // Determine which jobs the client watches, 'all', 'tag <tag>' or a list of job IDs separated by commas
+    std::string arguments = removeFirstWord(this->clientCommand);
+    Events::Subscription subscription = { this->clientSocket, Events::CEW_JOBS, "", {} };
+
+    if (arguments == "all") {
+        subscription.kind = Events::CEW_ALL;
+    }
+    else if (getFirstWord(arguments) == "tag") {
+        subscription.kind = Events::CEW_TAG;
+        subscription.tag = removeFirstWord(arguments);
+    }
+    else while (!arguments.empty()) {
+        subscription.jobIDs.push_back(getFirstWord(arguments, ','));
+        arguments = removeFirstWord(arguments, ',');
+    }
+
+    if ((subscription.kind == Events::CEW_TAG && subscription.tag.empty()) || (subscription.kind == Events::CEW_JOBS && subscription.jobIDs.empty())) {
+        sendMessage(this->clientSocket, "WATCH REJECTED BECAUSE OF INVALID ARGUMENTS");
+        return false;
+    }
+
+    std::string unknownID;
+    if (!Events::Publisher::subscribe(subscription, unknownID)) {
+        sendMessage(this->clientSocket, "WATCH REJECTED BECAUSE OF UNKNOWN JOB " + unknownID);
+        return false;
+    }
+
+    std::cout << "---[" << KMAG << "Event Subscription" << KWHT << "]--- | ";
+    std::cout << "Socket ID: " << "[" << KRED << this->clientSocket << KWHT << "]" << " | ";
+    std::cout << "Watching: " << "[" << KYEL << (subscription.kind == Events::CEW_ALL ? "all jobs" : subscription.kind == Events::CEW_TAG ? "tag " + subscription.tag : std::to_string(subscription.jobIDs.size()) + " jobs") << KWHT << "]" << std::endl;
+
+    return true;
+
+}
+
+/**
+ * @brief Handles the have client command. It tells the client whether the blob store of the
+ * server has a blob, so that the client uploads only the blobs the server does not have.
+ * 
+ * @return true, if the process was successfull, false otherwise
+*/
+bool Controller::Thread::checkClientBlob(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_serverContinue);
+    Server::Process::continueExecution = true;
+    pthread_cond_signal(&Server::Process::condVar_serverContinue);
+    pthread_mutex_unlock(&Server::Process::mutex_serverContinue);
+
+    std::string digest = removeFirstWord(this->clientCommand);
+
+    if (!Sha::Digest::isValid(digest)) {
+        sendMessage(this->clientSocket, "HAVE REJECTED BECAUSE OF INVALID ARGUMENTS");
+        return false;
+    }
+
+    bool present = Blobs::Store::has(digest);
+    sendMessage(this->clientSocket, "BLOB " + digest + (present ? " PRESENT" : " MISSING"));
+
+    std::cout << "---[" << KMAG << "Blob  Lookup" << KWHT << "]--- | ";
+    std::cout << "Blob: " << "[" << KGRN << digest << KWHT << "]" << " | ";
+    std::cout << "State: " << "[" << KYEL << (present ? "PRESENT" : "MISSING") << KWHT << "]" << std::endl;
+
+    return true;
+
+}
+
+/**
+ * @brief Handles the upload client command. It tells the client to send a blob the server does
+ * not have and fits in the blob budget, receives it and tells the client whether it was stored.
+ * 
+ * @return true, if the process was successfull, false otherwise
+*/
+bool Controller::Thread::storeClientBlob(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_serverContinue);
+    Server::Process::continueExecution = true;
+    pthread_cond_signal(&Server::Process::condVar_serverContinue);
+    pthread_mutex_unlock(&Server::Process::mutex_serverContinue);
+
+    // The client hashes the file first, so the command is 'upload <digest> <size>'
+    std::string arguments = removeFirstWord(this->clientCommand);
+    std::string digest = getFirstWord(arguments);
+    std::string sizeString = removeFirstWord(arguments);
+
+    char* end = nullptr;
+    unsigned long size = sizeString.empty() || sizeString[0] == '-' ? 0 : strtoul(sizeString.c_str(), &end, 10);
+
+    if (!Sha::Digest::isValid(digest) || end == nullptr || *end != '\0') {
+        sendMessage(this->clientSocket, "UPLOAD REJECTED BECAUSE OF INVALID ARGUMENTS");
+        return false;
+    }
+    if (!Blobs::Store::canStore(size)) {
+        sendMessage(this->clientSocket, "UPLOAD REJECTED BECAUSE THE BLOB EXCEEDS THE BLOB BUDGET");
+        return false;
+    }
+
+    // A blob the server already has is never sent again
+    if (Blobs::Store::has(digest)) {
+        sendMessage(this->clientSocket, "BLOB " + digest + " PRESENT");
+        return true;
+    }
+
+    sendMessage(this->clientSocket, "BLOB " + digest + " READY");
+
+    Blobs::UploadResult result = Blobs::Store::upload(this->clientSocket, digest, size);
+
+    std::string state;
+    switch (result) {
+        case Blobs::JBU_STORED: state = "STORED"; break;
+        case Blobs::JBU_CORRUPTED: state = "REJECTED BECAUSE IT DOES NOT MATCH ITS DIGEST"; break;
+        case Blobs::JBU_NO_ROOM: state = "REJECTED BECAUSE THE BLOBS IN USE LEAVE NO ROOM"; break;
+        default: state = "FAILED"; break;
+    }
+
+    sendMessage(this->clientSocket, "BLOB " + digest + " " + state);
+
+    std::cout << "---[" << KMAG << "Blob  Upload" << KWHT << "]--- | ";
+    std::cout << "Blob: " << "[" << KGRN << digest << KWHT << "]" << " | ";
+    std::cout << "Size: " << "[" << KYEL << size << " bytes" << KWHT << "]" << " | ";
+    std::cout << "State: " << "[" << (result == Blobs::JBU_STORED ? KGRN : KRED) << state << KWHT << "]" << std::endl;
+
+    return result == Blobs::JBU_STORED;
+
+}
+
+/**
+ * @brief Removes a job that has not started running yet from wherever it waits, the waiting buffer
+ * queue, the blocked jobs of the dependency graph, the timer wheel or the jobs attached to an identical
+ * coalescing job. When a queued coalescing job is removed the first job attached to it is queued in its
+ * place. The client of the job is sent the given notification, and the jobs depending on it are canceled.
+ * 
+ * @param jobID the job ID of the job to remove
+ * @param notification the message the client of the job is sent
+ * 
+ * @return true if the job was found and removed, false otherwise
+*/
+bool Controller::Thread::removeWaitingJob(const std::string jobID, const std::string notification) {
+
+    CC::JobTriplate triplate;
+
+    // Remove the job from the waiting buffer queue, or from the blocked jobs of the dependency graph
+    pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
+    bool found = WaitingBuffer::Queue::removeJobTriplateByID(jobID, triplate);
+    pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
+
+    if (!found) {
+        found = Dependencies::Graph::removeBlockedJob(jobID, triplate);
+    }
+    if (!found) {
+        found = Timers::Wheel::cancel(jobID, triplate);
+    }
+
+    // A job attached to an identical job only stops waiting for its output
+    if (!found) {
+        found = Coalescing::Coalescer::removeWaiter(jobID, triplate);
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    // The first job attached to a removed coalescing job takes its place in the queue
+    CC::JobTriplate successor;
+    bool handedOver = triplate.options.coalesce && Coalescing::Coalescer::handOver(triplate, successor);
+
+    if (handedOver) {
+
+        // The successor has already been submitted, so it is appended even if another job has taken the room meanwhile
+        pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
+        WaitingBuffer::Queue::appendJobTriplate(successor);
+        pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
+
+        pthread_mutex_lock(&Server::Process::mutex_worker);
+        pthread_cond_signal(&Server::Process::condVar_worker);
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+    }
+
+    pthread_mutex_lock(&Server::Process::mutex_controller);
+
+    pthread_cond_signal(&Server::Process::condVar_controller);
+
+    // Send an appropriate message to the client of the triplate saying that the job has been removed
+    Sending::Sender::sendMessage(triplate.socketID, notification);
+
+    pthread_mutex_unlock(&Server::Process::mutex_controller);
+
+    // A removed job never succeeds, so the jobs depending on it are canceled. The client of a detached job learns it from its result
+    JobResults::Store::discard(jobID, notification);
+    Server::Process::completeJob(jobID, false);
+    Events::Publisher::publish({ jobID, triplate.options.tag, false, false, -1, 0, 0 });
+
+    return true;
+
+}
+
 /**
  * @brief Handles the stop client command. It itrates through the waiting buffer
  * queue, until it finds the job specified to be removed from the buffer, according
- * to its job ID.
+ * to its job ID. Jobs blocked on their dependencies and delayed or recurring jobs can
+ * be stopped as well, and the jobs depending on a stopped job are canceled. A running job
+ * is sent SIGTERM, and SIGKILL if it has not exited after the grace period of the server.
+ * A job attached to an identical coalescing job is detached from it, and when a queued
+ * coalescing job is stopped the first job attached to it is queued in its place.
  * 
  * @return true, if the process was successfull, false otherwise
 */
 bool Controller::Thread::removeJobFromBufferQueue(void) {
 
-    CC::JobTriplate triplate;
-
     pthread_mutex_lock(&Server::Process::mutex_serverContinue);
     Server::Process::continueExecution = true;
     pthread_cond_signal(&Server::Process::condVar_serverContinue);
@@ -269,10 +958,15 @@ bool Controller::Thread::removeJobFromBufferQueue(void) {
     std::string message;
     std::string given_job_ID = removeFirstWord(this->clientCommand);
 
-    bool found = WaitingBuffer::Queue::removeJobTriplateByID(given_job_ID, triplate); // Remove the job
+    bool found = Controller::Thread::removeWaitingJob(given_job_ID, "JOB HAS BEEN REMOVED BEFORE EXECUTION");
+
+    // A job that is already running is terminated instead, and it finishes like any other job when it exits
+    bool running = !found && Controller::Thread::stopRunningJob(given_job_ID);
 
     // Build the appropriate response
-    if (found) { message = "JOB " + given_job_ID + " REMOVED"; } else { message = "JOB " + given_job_ID + " NOTFOUND"; }
+    if (found) { message = "JOB " + given_job_ID + " REMOVED"; }
+    else if (running) { message = "JOB " + given_job_ID + " STOPPED"; }
+    else { message = "JOB " + given_job_ID + " NOTFOUND"; }
 
     const char* serverResponse = message.c_str();
     ssize_t serverResponseSize = strlen(serverResponse);
@@ -281,23 +975,6 @@ bool Controller::Thread::removeJobFromBufferQueue(void) {
     send(this->clientSocket, &serverResponseSize, sizeof(ssize_t), 0);
     send(this->clientSocket, serverResponse, serverResponseSize, 0);
 
-    pthread_mutex_lock(&Server::Process::mutex_controller);
-
-    if (found) {
-
-        pthread_cond_signal(&Server::Process::condVar_controller);
-
-        // Send an appropriate message to the client of the triplate saying that the job has been stopped
-        char notificationMessage[] = "JOB HAS BEEN REMOVED BEFORE EXECUTION";
-        ssize_t notificationSize = strlen(notificationMessage);
-
-        send(triplate.socketID, &notificationSize, sizeof(ssize_t), 0);
-        send(triplate.socketID, notificationMessage, notificationSize, 0);
-    
-    }
-
-    pthread_mutex_unlock(&Server::Process::mutex_controller);
-
     return true;
 
 }
@@ -317,23 +994,37 @@ bool Controller::Thread::terminateServer(void) {
     pthread_cond_broadcast(&Server::Process::condVar_controller);
     pthread_mutex_unlock(&Server::Process::mutex_controller);
 
+    // Remove all the blocked and scheduled jobs first, so that none of them reaches the queue from now on
+    std::vector<CC::JobTriplate> blockedJobs;
+    Dependencies::Graph::removeAllBlockedJobs(blockedJobs);
+
+    Timers::Wheel::removeAll(blockedJobs);
+
+    for (unsigned int i = 0; i < blockedJobs.size(); i++) {
+        Sending::Sender::sendMessage(blockedJobs[i].socketID, "SERVER TERMINATED BEFORE EXECUTION");
+    }
+
     // Remove all the jobs waiting in the buffer queue and notify every client that the server has been terminated
     while (!WaitingBuffer::Queue::isEmpty()) {
 
         CC::JobTriplate triplate = WaitingBuffer::Queue::getJobTriplate();
-        int socketID = triplate.socketID;
 
-        char response[] = "SERVER TERMINATED BEFORE EXECUTION";
-        ssize_t responseSize = strlen(response);
+        Sending::Sender::sendMessage(triplate.socketID, "SERVER TERMINATED BEFORE EXECUTION");
 
-        send(socketID, &responseSize, sizeof(ssize_t), 0);
-        send(socketID, response, responseSize, 0);
+        // The jobs attached to a queued coalescing job will not get any output either
+        std::vector<CC::JobTriplate> waiters;
+        if (triplate.options.coalesce) {
+            Coalescing::Coalescer::detach(triplate, waiters);
+        }
+        for (unsigned int i = 0; i < waiters.size(); i++) {
+            Sending::Sender::sendMessage(waiters[i].socketID, "SERVER TERMINATED BEFORE EXECUTION");
+        }
 
     }
     
-    // Wait until no job is running
+    // Wait until no job is running, suspended or being canceled
     pthread_mutex_lock(&Server::Process::mutex_allJobsDone);
-    while(Server::Process::getRunningJobs() > 0) {
+    while(Server::Process::getRunningJobs() > 0 || RunningJobs::Table::getSuspendedJobs() > 0 || RunningJobs::Table::getCanceledJobs() > 0 || Plugins::Registry::getRunningCalls() > 0) {
         pthread_cond_wait(&Server::Process::condVar_allJobsDone, &Server::Process::mutex_allJobsDone);
     }
     pthread_mutex_unlock(&Server::Process::mutex_allJobsDone);
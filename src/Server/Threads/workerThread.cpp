@@ -1,10 +1,21 @@
 /* Filename: workerThread.cpp */
 
 #include <string.h>
+#include <signal.h>
 #include <sys/wait.h>
 #include "../../../include/workerThread.h"
 #include "../../../include/waitingBufferQueue.h"
 #include "../../../include/jobExecutorServerProcess.h"
+#include "../../../include/resourcePool.h"
+#include "../../../include/runningJobsTable.h"
+#include "../../../include/jobLauncher.h"
+#include "../../../include/pluginJobs.h"
+#include "../../../include/jobSupervisor.h"
+#include "../../../include/outputStreamer.h"
+#include "../../../include/outputCapture.h"
+#include "../../../include/inputFeeder.h"
+#include "../../../include/cpuPlacement.h"
+#include "../../../include/blobStore.h"
 
 #define KNRM  "\x1B[0m"
 #define KRED  "\x1B[31m"
@@ -18,352 +29,336 @@
 #define PIPE_READ_END  (0)
 #define PIPE_WRITE_END (1)
 
-#define MAX_OUTPUT_FILE_PATH (100)
-
 /* namespace alias */
 namespace Server = Application_Job_Executor_Server;
 namespace Worker = Application_Job_Executor_Server::Application_Worker_Thread;
 namespace WaitingBuffer = Application_Job_Executor_Server::Application_Common_Waiting_Buffer;
+namespace Resources = Application_Job_Executor_Server::Application_Resource_Pool;
+namespace RunningJobs = Application_Job_Executor_Server::Application_Running_Jobs;
+namespace Launch = Application_Job_Executor_Server::Application_Job_Launcher;
+namespace Plugins = Application_Job_Executor_Server::Application_Plugin_Jobs;
+namespace Supervision = Application_Job_Executor_Server::Application_Job_Supervisor;
+namespace Streaming = Application_Job_Executor_Server::Application_Output_Streamer;
+namespace Blobs = Application_Job_Executor_Server::Application_Blob_Store;
+namespace Capturing = Application_Job_Executor_Server::Application_Output_Capture;
+namespace Feeding = Application_Job_Executor_Server::Application_Input_Feeder;
+namespace Placement = Application_Job_Executor_Server::Application_Cpu_Placement;
 
 /**
- * @brief Supporting function to send data from the worker thread to its child process
- * using a pipe, and specifically the the path of the file where the output of the job 
- * executing by the worker thread is going to be placed for later use.
- * 
- * @param pipefd the pipe needed for communication with the child process
- * @param message the message to send
- * 
- * @return true if the message was sent successfully, false otherwise
+ * @brief Supporting function that resumes suspended jobs with SIGCONT, as long as there are
+ * free slots and CPUs for them and no job of higher priority is waiting in the buffer queue.
+ * A suspended job keeps its memory reserved, so only its slot and its CPUs are taken back.
+ * It continues on the cores it was placed on if they are still free, and it is placed again
+ * and moved otherwise, since the job that preempted it may have been placed on them.
+ * The caller must hold the worker and the job insertion mutexes of the server.
 */
-static bool sendDataToChildProcess(const int pipefd[2], const char message[MAX_OUTPUT_FILE_PATH]) {
-
-    // First close the read end of the pipe as it is useless for now
-    close(pipefd[PIPE_READ_END]);
-
-    // Then write the message to the write end of the pipe, and after that close it
-    if (write(pipefd[PIPE_WRITE_END], (char*)message, MAX_OUTPUT_FILE_PATH) == -1) {
-        perror("Error sending dat to child process");
-        return false;
-    }
-    
-    close(pipefd[PIPE_WRITE_END]);
+static void resumeSuspendedJobs(void) {
 
-    return true;
-}
-
-/**
- * @brief Supporting function that receives the data sent to the child process by the 
- * parent process through a pipe. Specifically it receives the path of the file to
- * contain the output of the job executed by the worker thread of the server.
- * 
- * @param pipefd the pipe used for communication
- * @param message the message to receive
- * 
- * @return true if the data were received successfully, false otherwise
-*/
-static bool receiveDataFromParentProcess(const int pipefd[2], const char message[MAX_OUTPUT_FILE_PATH]) {
+    RunningJobs::RunningJob* job;
+    CC::JobTriplate waiting;
 
-    // First close the write end as it is useless for now
-    close(pipefd[PIPE_WRITE_END]);
+    while ((job = RunningJobs::Table::findJobToResume()) != nullptr) {
 
-    // Then read the data from read end of the pipe, and after that close the read end
-    if (read(pipefd[PIPE_READ_END], (char*)message, MAX_OUTPUT_FILE_PATH) == -1) {
-        perror("Error receiving data from parent process");
-        return false;
-    }
+        // Stop if there is no room for the job, or a more urgent job is waiting for the room
+        if (Server::Process::getRunningJobs() >= Server::Process::getConcurrency() || !Resources::Pool::fits(job->cpus, 0)) {
+            break;
+        }
+        if (WaitingBuffer::Queue::peekHighestPriorityJobTriplate(waiting) && waiting.options.priority > job->priority) {
+            break;
+        }
 
-    close(pipefd[PIPE_READ_END]);
+        // The job is moved before it continues, so that it never shares its cores with the job that took them
+        if (Placement::Engine::isFree(job->cores)) {
+            Placement::Engine::claim(job->cores);
+        } else {
+            std::vector<int> cores;
+            Placement::Engine::place(job->cpus, cores);
+            Placement::Engine::movePlacedJob(job->processGroup, cores);
+            job->cores = cores;
+        }
 
-    return true;
-}
+        kill(-job->processGroup, SIGCONT);
+        RunningJobs::Table::setSuspended(job, false);
+        Supervision::Supervisor::setSuspended(job->processGroup, false);
 
-/**
- * @brief Supporting function to create the file where the output of the job executed
- * by the worker thread of the server, will be placed for later use.
- * 
- * @param filename the name of the file
- * @param fd the file descriptor of the file
- * 
- * @return true if the file creation was successfull, false otherwise
-*/
-static bool createOutputFile(const char* filename, int& fd) {
+        Server::Process::increaseRunningJobs();
+        Resources::Pool::reserve(job->cpus, 0);
 
-    // Create a temporary directory to store the output of the executing job
-    if (mkdir("temp", 0777) == -1) {
-        if (errno != EEXIST) { 
-            perror("Error creating temporary file"); 
-            return false;
+        std::cout << "---[" << KGRN << "Job  Resumption" << KWHT << "]--- | ";
+        std::cout << "Job ID: " << "[" << KGRN << job->jobID << KWHT << "]";
+        if (!job->cores.empty()) {
+            std::cout << " | " << "Cores: " << "[" << KMAG << Placement::Engine::format(job->cores) << KWHT << "]";
         }
-    }
+        std::cout << std::endl;
 
-    // Create the file to save process id and check for errors
-    if ((fd = open(filename, O_CREAT | O_WRONLY | O_TRUNC, 0777)) == -1) {
-        perror("Failed to create output file");
-        return false;
     }
 
-    return true;
-
 }
 
 /**
- * @brief Supporting function to read a file and store and return its contents and its size.
- * 
- * @param filename the name of the file
- * @param fileSize the size of the file
+ * @brief Supporting function that preempts the running job with the lowest priority with SIGSTOP,
+ * if this gives the room needed for the most urgent job of the buffer queue, that has a higher
+ * priority. The slot and the CPUs of the preempted job are given back, so that the urgent job can
+ * be received right after. The caller must hold the worker and the job insertion mutexes of the server.
  * 
- * @return the contents of the file if the process worked successfully, nullptr otherwise
+ * @return true if a job was preempted, false otherwise
 */
-static char* readFile(const char* filename, ssize_t& fileSize) {
+static bool preemptJobForMostUrgent(void) {
 
-    // Open the file for reading and check if any error occurred
-    int fd = open(filename, O_RDONLY);
-    if (fd == -1) {
-        perror("Error opening the file");
-        return nullptr;
-    }
-
-    // Get the file size
-    struct stat st;
-    if (fstat(fd, &st) == -1) {
-        perror("Error getting filesize");
-        close(fd);
-        return nullptr;
+    // Preempting a process never makes room for a plugin job
+    CC::JobTriplate urgent;
+    if (!WaitingBuffer::Queue::peekHighestPriorityJobTriplate(urgent) || Plugins::Registry::isPluginJob(urgent.job)) {
+        return false;
     }
 
-    ssize_t file_size = st.st_size; // Store the size of the file
-
-    // Allocate memory for the file content
-    char* contents = new char[file_size + 1];
-    if (contents == nullptr) {
-        perror("Error allocating memory");
-        close(fd);
-
-        return nullptr;
+    RunningJobs::RunningJob* victim = RunningJobs::Table::findPreemptionVictim(urgent.options.priority, Server::Process::getOptions().maxPreemptions);
+    if (victim == nullptr) {
+        return false;
     }
 
-    // Read the contents of the file in a loop to ensure all data is read
-    ssize_t total_bytes_read = 0;
-    while (total_bytes_read < file_size) 
-    {
-        ssize_t bytes_read = read(fd, contents + total_bytes_read, file_size - total_bytes_read);
-        
-        if (bytes_read == -1) {
-            perror("Error reading file");
-            delete[] contents;
-            close(fd);
-
-            return nullptr;
-        }
-
-        total_bytes_read += bytes_read;
+    // Preempting the victim must be enough for the urgent job to fit
+    if (Server::Process::getRunningJobs() > Server::Process::getConcurrency()) {
+        return false;
     }
-
-    contents[total_bytes_read] = '\0';
-    close(fd);
-
-    fileSize = total_bytes_read;
-
-    return contents;
-
-}
-
-/**
- * @brief Splits the given string that contaings the command that is about to 
- * be executed, into tokens. Those tokens are the arguments that exec() function 
- * needs to run the executable in the right way. The first argument of those tokens 
- * is the executable itself (its name).
- * 
- * @param job the string containing the full command to run the executable
- * 
- * @return an array of tokens, where each one is a specific argument from the given job string
- */
-static char** getJobArguments(const char* job) {
-
-    // Find the number of arguments of the job
-    unsigned int argumentsCount = 1;
-
-    for (unsigned int i = 0; job[i] != '\0'; i++) {
-        if (job[i] == ' ' && job[i + 1] != ' ') {
-            argumentsCount++;
-        }
+    if (urgent.options.cpus > Resources::Pool::getFreeCpus() + victim->cpus || urgent.options.memory > Resources::Pool::getFreeMemory()) {
+        return false;
     }
 
-    // Store all the arguments
-    char** arguments = new char*[argumentsCount + 1];
-    if (arguments == nullptr) {
-        perror("Error Allocating Memory");
-        return nullptr;
+    if (kill(-victim->processGroup, SIGSTOP) == -1) {
+        perror("Error suspending job");
+        return false;
     }
 
-    arguments[0] = strtok((char*)job, " ");
-    for (unsigned int i = 1; i < argumentsCount; i++) {
-        arguments[i] = strtok(NULL, " ");
-    }
+    RunningJobs::Table::setSuspended(victim, true);
+    Supervision::Supervisor::setSuspended(victim->processGroup, true);
+    Server::Process::decreaseRunningJobs();
+    Resources::Pool::release(victim->cpus, 0);
+    Placement::Engine::release(victim->cores);
 
-    arguments[argumentsCount] = NULL;
+    std::cout << "---[" << KMAG << "Job  Preemption" << KWHT << "]--- | ";
+    std::cout << "Suspended: " << "[" << KRED << victim->jobID << KWHT << "]" << " | ";
+    std::cout << "For: " << "[" << KGRN << urgent.jobID << KWHT << "]" << " | ";
+    std::cout << "Preemptions: " << "[" << victim->preemptions << "/" << Server::Process::getOptions().maxPreemptions << "]" << std::endl;
 
-    return arguments;
+    return true;
 
 }
 
 /**
- * @brief Receives and returns a job from the waiting buffer queue, in order to
- * be executed. It also initializes the client socket ID from the triplate.
+ * @brief Supporting function that gives back the cores of a job that could not be launched.
  * 
- * @return the first job triplate of the waiting buffer queue
+ * @param cores the cores the job was placed on
 */
-CC::JobTriplate Worker::Thread::receiveJobFromBuffer(void) {
+static void releaseCores(const std::vector<int>& cores) {
 
-    // Get the forst job triplate of the buffer queue and return it
-    CC::JobTriplate triplate = WaitingBuffer::Queue::getJobTriplate();
-    this->clientSocket = triplate.socketID;
-    return triplate;
+    pthread_mutex_lock(&Server::Process::mutex_worker);
+    Placement::Engine::release(cores);
+    pthread_mutex_unlock(&Server::Process::mutex_worker);
 
 }
 
 /**
- * @brief Sends the output of the job executed by the thread back to the client.
+ * @brief Receives a job from the waiting buffer queue, in order to be executed. Suspended jobs
+ * are resumed first when there is room for them. Then the most urgent job of the queue whose
+ * resources fit in the free resources of the server is selected, if the server has a free
+ * concurrency slot. If no job fits, a running job of lower priority may be preempted to make
+ * room for the most urgent waiting job. The slot and the resources of the received job are
+ * reserved right away. It also initializes the client socket ID from the triplate. The caller
+ * must hold the worker mutex of the server.
  * 
- * @param output the output of the job
- * @param outputSize the size of the output
+ * @param triplate the job triplate that was received
  * 
- * @return true if the output was sent successfully, false otherwise
+ * @return true if a job was received, false otherwise
 */
-bool Worker::Thread::sendJobOutputToClient(const char* output, const ssize_t outputSize) {
+bool Worker::Thread::receiveJobFromBuffer(CC::JobTriplate& triplate) {
 
-    // Send the size of the output, and then the actual output back to the client
-    send(this->clientSocket, &outputSize, sizeof(ssize_t), 0);
-    send(this->clientSocket, output, outputSize, 0);
+    pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
 
-    return true;
+    resumeSuspendedJobs();
 
-}
+    // Get the most urgent job triplate of the buffer queue that fits in the free slots and resources
+    bool found = WaitingBuffer::Queue::removeFittingJobTriplate(Resources::Pool::getFreeCpus(), Resources::Pool::getFreeMemory(),
+        Server::Process::getRunningJobs() < Server::Process::getConcurrency(), Plugins::Registry::hasFreeSlot(), triplate);
 
-/**
- * @brief Creates and returns the reponse of the worker thread to the client according
- * to the job output. Specifically it reads the output file of the job and adds an extra
- * text at the beginning and at the end of the message.
- * 
- * @param jobOutput the job output stored in the output file
- * @param jobOutputSize the size of the job output
- * @param jobID the ID of the current job
- * @param responseSize the size of the final response
- * 
- * @return the full response string of the worker thread.
-*/
-char* Worker::Thread::createOutputResponse(const char* jobOutput, const ssize_t jobOutputSize, const char* jobID, ssize_t& responseSize) {
+    // Otherwise try to make room for the most urgent job by preempting a less urgent one
+    if (!found && preemptJobForMostUrgent()) {
+        found = WaitingBuffer::Queue::removeFittingJobTriplate(Resources::Pool::getFreeCpus(), Resources::Pool::getFreeMemory(),
+            Server::Process::getRunningJobs() < Server::Process::getConcurrency(), Plugins::Registry::hasFreeSlot(), triplate);
+    }
 
-    char startingText[100], endingText[100];
-    char* finalResponse = new char[jobOutputSize + 200]; // Initialize the final response string
+    pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
 
-    // Add the extra string at the start and at the end
-    sprintf(startingText, "-----%s output start------", jobID);
-    sprintf(endingText, "-----%s output end------", jobID);
-    sprintf(finalResponse, "%s\n%s\n%s", startingText, jobOutput, endingText);
+    if (!found) {
+        return false;
+    }
 
-    responseSize = strlen(finalResponse); // Store the size of the response
+    // Reserve the slot and the resources of the job. A plugin job only takes a slot of the plugin pool
+    if (Plugins::Registry::isPluginJob(triplate.job)) {
+        Plugins::Registry::reserveSlot();
+    } else {
+        Server::Process::increaseRunningJobs();
+        Resources::Pool::reserve(triplate.options.cpus, triplate.options.memory);
+    }
+
+    this->clientSocket = triplate.socketID;
+    return true;
 
-    return finalResponse;
 }
 
 /**
- * @brief Receives a job triplate and executes its corresponding job. It creates 
- * a child process with fork() system call and uses exec() to execute the given
- * process
+ * @brief Receives a job triplate and dispatches its corresponding job. It launches the
+ * job through the launcher process and hands it over to the supervisor, which finishes
+ * the job when it exits, so the worker thread does not wait for it. The job is launched with
+ * its resource limits, and its wall time limit is enforced by the supervisor. It is placed on
+ * cores according to the placement policy of the server. The output of a job
+ * issued with '--output stream' is handed over to the streamer as well, and the standard
+ * input of a job issued with '--input' is a pipe that the feeder fills from the client. A job
+ * issued with '--blobs' runs in a working directory of its own that holds its blobs. A
+ * plugin job is called directly and finished right away.
  * 
  * @param jobTriplate the triplate containing the job to execute
  * 
- * @return true if the job was executed successfully, false otherwise 
+ * @return true if the job was launched, false otherwise 
 */
 bool Worker::Thread::executeJob(const CC::JobTriplate jobTriplate) {
 
-    int pipefd[2];
     pid_t pid;
+    std::vector<int> cores;
+    cpu_set_t cpus;
+
+    // Place the job on the cores that suit the placement policy and are not used by other jobs
+    if (!Plugins::Registry::isPluginJob(jobTriplate.job)) {
+        pthread_mutex_lock(&Server::Process::mutex_worker);
+        Placement::Engine::place(jobTriplate.options.cpus, cores);
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+    }
+    Placement::Engine::getCpuSet(cores, cpus);
 
     std::cout << "---[" << KYEL << "New Job  Execution" << KWHT << "]--- | ";
     std::cout << KYEL << "Worker Thread is executing a job " << KWHT << " | ";
     std::cout <<  "Job ID: " << "[" << KGRN << jobTriplate.jobID << KWHT << "]" << " | ";
     std::cout <<  "Job command: " << "'" << KBLU << jobTriplate.job << KWHT << "'";
+    if (!cores.empty()) {
+        std::cout << " | " << "Cores: " << "[" << KMAG << Placement::Engine::format(cores) << KWHT << "]";
+    }
     std::cout << std::endl;
 
-    // Create the pipe for communication with the child process and check if and error occured
-    if (pipe(pipefd) == -1) {
-        perror("Pipe");
-        return false;
-    }
+    // A plugin job runs right here on the worker thread and writes its output in memory
+    if (Plugins::Registry::isPluginJob(jobTriplate.job)) {
+
+        std::string pluginOutput;
+        bool succeeded = Plugins::Registry::runPluginJob(jobTriplate, pluginOutput);
+
+        Supervision::Supervisor::finishJob(jobTriplate, succeeded, Supervision::JL_NONE, succeeded ? 0 : 1, pluginOutput.c_str(), pluginOutput.size());
+        return true;
 
-    // Create a child process and check if any error occured
-    if ((pid = fork()) == -1) {
-        perror("Error creating child process");
-        return false;
     }
 
-     /* Parent process code */
-    if (pid > 0) {
+    Launch::Limits limits = Supervision::Supervisor::getJobLimits(jobTriplate);
 
-        Server::Process::increaseRunningJobs();
+    // A job with blobs runs in a working directory where its blobs appear as read-only files
+    int directoryFD = -1;
+    if (!jobTriplate.options.blobs.empty()) {
 
-        // Construct the path of the file that will contain the output of the job
-        char jobOutputFilePath[MAX_OUTPUT_FILE_PATH];
-        sprintf(jobOutputFilePath, "temp/%d.output", pid);
+        std::string directory, missing;
+        bool acquired = Blobs::Store::acquire(jobTriplate.jobID, jobTriplate.options.blobs, directory, missing);
 
-        // Send the file path to the child process
-        if (!sendDataToChildProcess(pipefd, jobOutputFilePath)) {
+        if (acquired && (directoryFD = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)) == -1) {
+            perror("Error opening job working directory");
+            acquired = false;
+        }
+
+        if (!acquired) {
+            if (!missing.empty()) {
+                std::cout << "---[" << KRED << "Missing  Blob" << KWHT << "]--- | ";
+                std::cout << "Job ID: " << "[" << KGRN << jobTriplate.jobID << KWHT << "]" << " | ";
+                std::cout << "Blob: " << "[" << KYEL << missing << KWHT << "]" << std::endl;
+            }
+            releaseCores(cores);
+            Supervision::Supervisor::finishJob(jobTriplate, false, Supervision::JL_NONE, 127, "", 0);
             return false;
         }
 
-        wait(NULL); // Wait for child process to finish execution
+    }
 
-        std::cout << "---[ " << KGRN << "Job  Termination" << KWHT << " ]---" << " | ";
-        std::cout << KGRN << jobTriplate.jobID << " was successfully executed!" << KWHT << std::endl;
+    // A streamed job writes to a pipe, which the streamer moves to the client while the job runs
+    if (jobTriplate.options.streamOutput) {
 
-        ssize_t contentsSize;
-        ssize_t responseSize;
-        
-        // Build the output response and send it back to the client
-        char* contents = readFile(jobOutputFilePath, contentsSize);
-        char* outputResponse = this->createOutputResponse(contents, contentsSize, jobTriplate.jobID.c_str(), responseSize);
+        int pipefd[2] = { -1, -1 };
+        bool spawned = pipe2(pipefd, O_CLOEXEC) != -1;
 
-        this->sendJobOutputToClient(outputResponse, responseSize);
+        if (!spawned) {
+            perror("Pipe");
+        } else {
+            spawned = Launch::Launcher::spawnJob(jobTriplate.job, pipefd[PIPE_WRITE_END], -1, directoryFD, limits, cpus, pid);
+            close(pipefd[PIPE_WRITE_END]);
+        }
 
-        delete[] outputResponse;
+        if (directoryFD != -1) {
+            close(directoryFD);
+        }
 
-        // Delete the temporary output file of the current job
-        if (unlink(jobOutputFilePath) != 0) {
-            perror("Error deleting temporary output file");
+        if (!spawned) {
+            if (pipefd[PIPE_READ_END] != -1) close(pipefd[PIPE_READ_END]);
+            releaseCores(cores);
+            Supervision::Supervisor::finishJob(jobTriplate, false, Supervision::JL_NONE, 127, "", 0);
             return false;
         }
-        
+
+        if (!Streaming::Streamer::stream(pipefd[PIPE_READ_END], jobTriplate.socketID, jobTriplate.jobID, pid, limits.outputBytes)) {
+            close(pipefd[PIPE_READ_END]);
+        }
+
+        pthread_mutex_lock(&Server::Process::mutex_worker);
+        RunningJobs::Table::insert({ jobTriplate.jobID, jobTriplate.job, pid, jobTriplate.options.priority, jobTriplate.options.cpus, jobTriplate.options.memory, false, 0, time(NULL), false, false, {}, cores });
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+        Supervision::Supervisor::watch(pid, jobTriplate, { -1, "" }, limits);
+
+        return true;
+
     }
-    
-    /* Child process code */
-    else if (pid == 0) {
 
-        int fd;
-        char jobOutputFilePath[MAX_OUTPUT_FILE_PATH];
+    // Create the file that captures the output of the job, in memory if the output budget allows it
+    Capturing::CapturedOutput output;
+    bool spawned = Capturing::Capture::open(jobTriplate.jobID, output);
 
-        // Receive the file path from the parent process
-        if (!receiveDataFromParentProcess(pipefd, jobOutputFilePath)) {
-            exit(EXIT_FAILURE);
-        }
+    // A job with input reads it from a pipe, which the feeder fills with what its client sends
+    int inputfd[2] = { -1, -1 };
+    if (spawned && !jobTriplate.options.input.empty() && pipe2(inputfd, O_CLOEXEC) == -1) {
+        perror("Pipe");
+        spawned = false;
+        Capturing::Capture::close(output, nullptr, 0);
+    }
 
-        // Create the output file
-        if (!createOutputFile(jobOutputFilePath, fd)) {
-            exit(EXIT_FAILURE);
-        }
+    if (spawned) {
+        spawned = Launch::Launcher::spawnJob(jobTriplate.job, output.fd, inputfd[PIPE_READ_END], directoryFD, limits, cpus, pid);
+        if (!spawned) Capturing::Capture::close(output, nullptr, 0);
+    }
 
-        // Get the job executable and its arguments from the job triplate
-        const char* jobString = jobTriplate.job.c_str();
-        char** jobArguments = getJobArguments(jobString);
-        char* jobExecutable = jobArguments[0];
+    if (directoryFD != -1) {
+        close(directoryFD);
+    }
 
-        // Duplicate the STDOUT file descriptor to the output file and execute the job
-        dup2(fd, STDOUT_FILENO);
-        close(fd);
-        execvp(jobExecutable, jobArguments);
+    if (inputfd[PIPE_READ_END] != -1) {
+        close(inputfd[PIPE_READ_END]);
+    }
+    if (inputfd[PIPE_WRITE_END] != -1 && !(spawned && Feeding::Feeder::feed(inputfd[PIPE_WRITE_END], jobTriplate.socketID, jobTriplate.jobID))) {
+        close(inputfd[PIPE_WRITE_END]);
+    }
 
+    // A job that could not be launched has failed, but its client still gets an (empty) output
+    if (!spawned) {
+        releaseCores(cores);
+        Supervision::Supervisor::finishJob(jobTriplate, false, Supervision::JL_NONE, 127, "", 0);
+        return false;
     }
 
+    pthread_mutex_lock(&Server::Process::mutex_worker);
+    RunningJobs::Table::insert({ jobTriplate.jobID, jobTriplate.job, pid, jobTriplate.options.priority, jobTriplate.options.cpus, jobTriplate.options.memory, false, 0, time(NULL), false, false, {}, cores });
+    pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+    Supervision::Supervisor::watch(pid, jobTriplate, output, limits);
+
     return true;
 }
@@ -0,0 +1,611 @@
+/* Filename: blobStore.cpp */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <vector>
+#include <algorithm>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/fs.h>
+#include "../../include/blobStore.h"
+#include "../../include/sha256.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+#define KNRM  "\x1B[0m"
+#define KRED  "\x1B[31m"
+#define KGRN  "\x1B[32m"
+#define KYEL  "\x1B[33m"
+#define KBLU  "\x1B[34m"
+#define KMAG  "\x1B[35m"
+#define KCYN  "\x1B[36m"
+#define KWHT  "\x1B[37m"
+
+#define WORK_DIRECTORY "work" // The directory of the working directories of the jobs, inside the blob directory
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Blobs = Application_Job_Executor_Server::Application_Blob_Store;
+namespace Sha = Application_Job_Commander_Client::Application_Sha256;
+
+// Initialize the static members
+std::map<std::string, Blobs::Blob> Blobs::Store::blobs;
+std::list<std::string> Blobs::Store::recentlyUsed;
+unsigned long Blobs::Store::storedBytes = 0;
+std::map<std::string, std::map<std::string, std::string>> Blobs::Store::pins;
+unsigned long Blobs::Store::nextUpload = 0;
+
+/**
+ * @brief Supporting function that removes a single entry of a directory tree, for nftw().
+ *
+ * @param path the path of the entry
+ * @param status unused
+ * @param type unused
+ * @param walk unused
+ *
+ * @return zero to keep walking
+*/
+static int removeEntry(const char* path, const struct stat* status, int type, struct FTW* walk) {
+
+    if (remove(path) == -1) {
+        perror("Error removing working directory entry");
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Supporting function that removes a directory along with everything in it.
+ *
+ * @param path the path of the directory
+*/
+static void removeDirectoryTree(const std::string& path) {
+
+    nftw(path.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+
+}
+
+/**
+ * @brief Supporting function that reads exactly the given number of bytes from a socket.
+ *
+ * @param socketID the socket
+ * @param buffer the buffer to fill
+ * @param size the number of bytes to read
+ *
+ * @return true if all the bytes were read, false otherwise
+*/
+static bool readExactly(const int socketID, char* buffer, size_t size) {
+
+    while (size > 0) {
+
+        ssize_t bytes = recv(socketID, buffer, size, 0);
+
+        if (bytes == -1 && errno == EINTR) continue;
+        if (bytes <= 0) return false;
+
+        buffer += bytes;
+        size -= bytes;
+
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Supporting function that writes all the given bytes to a file.
+ *
+ * @param fd the file descriptor of the file
+ * @param data the bytes
+ * @param size the number of bytes
+ *
+ * @return true if all the bytes were written, false otherwise
+*/
+static bool writeAll(const int fd, const char* data, size_t size) {
+
+    while (size > 0) {
+
+        ssize_t bytes = write(fd, data, size);
+
+        if (bytes == -1 && errno == EINTR) continue;
+        if (bytes <= 0) return false;
+
+        data += bytes;
+        size -= bytes;
+
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Supporting function that gives a job a private copy of a blob. The copy shares the blocks of
+ * the blob on file systems that can clone files, and is copied in the kernel otherwise, so it is cheap
+ * either way. A job runs as the same user as the server, so a read-only mode alone could not keep it
+ * from writing to the blob if the copy were a link.
+ *
+ * @param blobPath the path of the blob
+ * @param copyPath the path of the copy
+ *
+ * @return true if the copy was made, false otherwise
+*/
+static bool copyBlob(const std::string& blobPath, const std::string& copyPath) {
+
+    int source = open(blobPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (source == -1) {
+        return false;
+    }
+
+    int copy = open(copyPath.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0444);
+    if (copy == -1) {
+        close(source);
+        return false;
+    }
+
+    bool copied = ioctl(copy, FICLONE, source) != -1;
+
+    // Without cloning the bytes are copied in the kernel, or through a buffer where the kernel can not copy them
+    if (!copied) {
+
+        ssize_t bytes;
+        bool inKernel = true;
+        char buffer[BLOB_CHUNK_SIZE];
+
+        while (true) {
+
+            bytes = inKernel ? copy_file_range(source, NULL, copy, NULL, BLOB_CHUNK_SIZE, 0) : -1;
+
+            if (bytes == -1 && inKernel && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)) {
+                inKernel = false;
+            }
+            if (!inKernel) {
+                bytes = read(source, buffer, BLOB_CHUNK_SIZE);
+                if (bytes > 0 && !writeAll(copy, buffer, bytes)) bytes = -1;
+            }
+
+            if (bytes == -1 && errno == EINTR) continue;
+            if (bytes <= 0) break;
+
+        }
+
+        copied = bytes == 0;
+
+    }
+
+    close(source);
+
+    if (close(copy) == -1 || !copied) {
+        unlink(copyPath.c_str());
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Returns the path of the file of a blob.
+ *
+ * @param digest the digest of the blob
+ *
+ * @return the path of the blob
+*/
+std::string Blobs::Store::getBlobPath(const std::string& digest) {
+
+    return Server::Process::getOptions().blobDirectory + "/" + digest;
+
+}
+
+/**
+ * @brief Returns the path of the working directory of a job.
+ *
+ * @param jobID the job ID of the job
+ *
+ * @return the path of the working directory
+*/
+std::string Blobs::Store::getWorkDirectory(const std::string& jobID) {
+
+    return Server::Process::getOptions().blobDirectory + "/" + WORK_DIRECTORY + "/" + jobID;
+
+}
+
+/**
+ * @brief Adds a blob to the index of the store as the most recently used one. The caller must
+ * hold the blob mutex of the server.
+ *
+ * @param digest the digest of the blob
+ * @param size the size of the blob
+*/
+void Blobs::Store::add(const std::string& digest, const unsigned long size) {
+
+    Blobs::Store::recentlyUsed.push_front(digest);
+    Blobs::Store::blobs[digest] = { size, 0, Blobs::Store::recentlyUsed.begin() };
+    Blobs::Store::storedBytes += size;
+
+}
+
+/**
+ * @brief Makes room for a blob of the given size in the budget, evicting the least recently used
+ * blobs that no running job refers to. Nothing is evicted if the blob would not fit anyway. The
+ * caller must hold the blob mutex of the server.
+ *
+ * @param size the size of the blob
+ *
+ * @return true if the blob fits, false otherwise
+*/
+bool Blobs::Store::makeRoom(const unsigned long size) {
+
+    unsigned long budget = Server::Process::getOptions().blobBudget * 1024 * 1024;
+
+    // Nothing is evicted for a blob that would not fit even after every blob that can go has gone
+    unsigned long pinnedBytes = 0;
+    for (std::map<std::string, Blob>::iterator blob = Blobs::Store::blobs.begin(); blob != Blobs::Store::blobs.end(); blob++) {
+        if (blob->second.references > 0) pinnedBytes += blob->second.size;
+    }
+    if (pinnedBytes + size > budget) {
+        return false;
+    }
+
+    std::list<std::string>::iterator it = Blobs::Store::recentlyUsed.end();
+
+    while (Blobs::Store::storedBytes + size > budget && it != Blobs::Store::recentlyUsed.begin()) {
+
+        --it;
+
+        // A blob in the working directory of a running job stays, however old it is
+        std::map<std::string, Blob>::iterator blob = Blobs::Store::blobs.find(*it);
+        if (blob->second.references > 0) {
+            continue;
+        }
+
+        if (unlink(Blobs::Store::getBlobPath(*it).c_str()) == -1) {
+            perror("Error evicting blob");
+        }
+
+        std::cout << "---[" << KMAG << "Blob Eviction" << KWHT << "]--- | ";
+        std::cout << "Digest: " << "[" << KGRN << *it << KWHT << "]" << " | ";
+        std::cout << "Freed: " << "[" << KYEL << blob->second.size << " bytes" << KWHT << "]" << std::endl;
+
+        Blobs::Store::storedBytes -= blob->second.size;
+        Blobs::Store::blobs.erase(blob);
+        it = Blobs::Store::recentlyUsed.erase(it);
+
+    }
+
+    return Blobs::Store::storedBytes + size <= budget;
+
+}
+
+/**
+ * @brief Creates the blob directory, or indexes the blobs that a previous run of the server left
+ * in it, and drops the unfinished uploads and working directories it left.
+ *
+ * @return true if the store is ready, false otherwise
+*/
+bool Blobs::Store::load(void) {
+
+    const std::string& directoryPath = Server::Process::getOptions().blobDirectory;
+
+    // A zero budget disables the store, which then never touches the blob directory
+    if (Server::Process::getOptions().blobBudget == 0) {
+        return true;
+    }
+
+    if (mkdir(directoryPath.c_str(), 0755) == -1 && errno != EEXIST) {
+        perror("Error creating blob directory");
+        return false;
+    }
+
+    DIR* dir = opendir(directoryPath.c_str());
+    if (dir == nullptr) {
+        perror("Error opening blob directory");
+        return false;
+    }
+
+    // The blobs are indexed from the least recently modified, so the oldest ones are evicted first
+    std::vector<std::pair<time_t, std::pair<std::string, unsigned long>>> found;
+    struct dirent* entry;
+
+    while ((entry = readdir(dir)) != nullptr) {
+
+        std::string entryName = entry->d_name;
+        std::string entryPath = directoryPath + "/" + entryName;
+        struct stat status;
+
+        if (entryName == "." || entryName == ".." || lstat(entryPath.c_str(), &status) == -1) {
+            continue;
+        }
+
+        if (Sha::Digest::isValid(entryName) && S_ISREG(status.st_mode)) {
+            found.push_back({ status.st_mtime, { entryName, status.st_size } });
+        }
+        else if (entryName.find(".part") != std::string::npos && S_ISREG(status.st_mode)) {
+            unlink(entryPath.c_str());
+        }
+
+    }
+
+    closedir(dir);
+
+    std::sort(found.begin(), found.end());
+    for (unsigned int i = 0; i < found.size(); i++) {
+        Blobs::Store::add(found[i].second.first, found[i].second.second);
+    }
+
+    // The working directories of the jobs of a previous run are dropped along with whatever the jobs left in them
+    std::string workPath = directoryPath + "/" + WORK_DIRECTORY;
+    removeDirectoryTree(workPath);
+
+    if (mkdir(workPath.c_str(), 0755) == -1) {
+        perror("Error creating working directories");
+        return false;
+    }
+
+    // The budget may have shrunk since the previous run
+    Blobs::Store::makeRoom(0);
+
+    return true;
+
+}
+
+/**
+ * @brief Returns whether the server has a blob, which counts as a use of the blob.
+ *
+ * @param digest the digest of the blob
+ *
+ * @return true if the blob is stored, false otherwise
+*/
+bool Blobs::Store::has(const std::string& digest) {
+
+    pthread_mutex_lock(&Server::Process::mutex_blobs);
+
+    std::map<std::string, Blob>::iterator it = Blobs::Store::blobs.find(digest);
+    bool found = it != Blobs::Store::blobs.end();
+
+    if (found) {
+        Blobs::Store::recentlyUsed.splice(Blobs::Store::recentlyUsed.begin(), Blobs::Store::recentlyUsed, it->second.position);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_blobs);
+
+    return found;
+
+}
+
+/**
+ * @brief Returns whether a blob of the given size can ever be stored.
+ *
+ * @param size the size of the blob
+ *
+ * @return true if the blob fits in the budget, false otherwise
+*/
+bool Blobs::Store::canStore(const unsigned long size) {
+
+    unsigned long budget = Server::Process::getOptions().blobBudget;
+
+    return budget > 0 && size <= budget * 1024 * 1024;
+
+}
+
+/**
+ * @brief Receives a blob that a client uploads on its socket, as data frames ended by an empty
+ * frame, and stores it if it matches its size and digest.
+ *
+ * @param socketID the socket of the client
+ * @param digest the digest of the blob
+ * @param size the size of the blob
+ *
+ * @return how the upload ended
+*/
+Blobs::UploadResult Blobs::Store::upload(const int socketID, const std::string& digest, const unsigned long size) {
+
+    // Every upload writes a file of its own, so identical uploads at the same time do not mix up their bytes
+    pthread_mutex_lock(&Server::Process::mutex_blobs);
+    std::string partPath = Blobs::Store::getBlobPath(digest) + ".part" + std::to_string(Blobs::Store::nextUpload++);
+    pthread_mutex_unlock(&Server::Process::mutex_blobs);
+
+    int fd = open(partPath.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0444);
+    if (fd == -1) {
+        perror("Error creating blob");
+        return JBU_FAILED;
+    }
+
+    // The blob is hashed as it is written, so it never has to be read back
+    Sha::Context context;
+    Sha::Digest::init(context);
+
+    char* buffer = new char[BLOB_CHUNK_SIZE];
+    unsigned long received = 0;
+    UploadResult result = JBU_STORED;
+    ssize_t frameSize;
+
+    while (result == JBU_STORED) {
+
+        if (!readExactly(socketID, (char*)&frameSize, sizeof(ssize_t))) {
+            result = JBU_FAILED;
+            break;
+        }
+
+        // The empty frame ends the blob, and a blob that grows past its size is not what the client claimed
+        if (frameSize == 0) break;
+        if (frameSize < 0 || received + frameSize > size) {
+            result = JBU_CORRUPTED;
+            break;
+        }
+
+        while (frameSize > 0) {
+
+            ssize_t chunkSize = frameSize < BLOB_CHUNK_SIZE ? frameSize : BLOB_CHUNK_SIZE;
+
+            if (!readExactly(socketID, buffer, chunkSize)) {
+                result = JBU_FAILED;
+                break;
+            }
+            if (!writeAll(fd, buffer, chunkSize)) {
+                perror("Error writing blob");
+                result = JBU_FAILED;
+                break;
+            }
+
+            Sha::Digest::update(context, buffer, chunkSize);
+            received += chunkSize;
+            frameSize -= chunkSize;
+
+        }
+
+    }
+
+    delete[] buffer;
+
+    if (close(fd) == -1 && result == JBU_STORED) {
+        perror("Error writing blob");
+        result = JBU_FAILED;
+    }
+
+    if (result == JBU_STORED && (received != size || Sha::Digest::finish(context) != digest)) {
+        result = JBU_CORRUPTED;
+    }
+
+    if (result != JBU_STORED) {
+        unlink(partPath.c_str());
+        return result;
+    }
+
+    pthread_mutex_lock(&Server::Process::mutex_blobs);
+
+    // An identical upload that finished first has already stored the blob
+    if (Blobs::Store::blobs.find(digest) != Blobs::Store::blobs.end()) {
+        unlink(partPath.c_str());
+    }
+    else if (!Blobs::Store::makeRoom(size)) {
+        unlink(partPath.c_str());
+        result = JBU_NO_ROOM;
+    }
+    else if (rename(partPath.c_str(), Blobs::Store::getBlobPath(digest).c_str()) == -1) {
+        perror("Error storing blob");
+        unlink(partPath.c_str());
+        result = JBU_FAILED;
+    }
+    else {
+        Blobs::Store::add(digest, size);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_blobs);
+
+    return result;
+
+}
+
+/**
+ * @brief Creates the working directory of a job and copies every blob of the job into it. The job
+ * holds a reference to each of its blobs until it is released.
+ *
+ * @param jobID the job ID of the job
+ * @param links the digests of the blobs of the job, by the file names they get
+ * @param directory the path of the working directory
+ * @param missing the digest of a blob that is not stored, if there is one
+ *
+ * @return true if the working directory is ready, false otherwise
+*/
+bool Blobs::Store::acquire(const std::string& jobID, const std::map<std::string, std::string>& links, std::string& directory, std::string& missing) {
+
+    directory = Blobs::Store::getWorkDirectory(jobID);
+    missing.clear();
+
+    pthread_mutex_lock(&Server::Process::mutex_blobs);
+
+    // A blob may have been evicted while the job waited, in which case the job can not run
+    for (std::map<std::string, std::string>::const_iterator it = links.begin(); it != links.end(); it++) {
+        if (Blobs::Store::blobs.find(it->second) == Blobs::Store::blobs.end()) {
+            missing = it->second;
+            pthread_mutex_unlock(&Server::Process::mutex_blobs);
+            return false;
+        }
+    }
+
+    for (std::map<std::string, std::string>::const_iterator it = links.begin(); it != links.end(); it++) {
+        Blob& blob = Blobs::Store::blobs[it->second];
+        blob.references++;
+        Blobs::Store::recentlyUsed.splice(Blobs::Store::recentlyUsed.begin(), Blobs::Store::recentlyUsed, blob.position);
+    }
+
+    Blobs::Store::pins[jobID] = links;
+
+    pthread_mutex_unlock(&Server::Process::mutex_blobs);
+
+    // The blobs can not be evicted while they are referenced, so they are copied without holding the mutex. Every
+    // job gets copies of its own, so whatever a job does to its files never reaches the store or the other jobs
+    bool ready = mkdir(directory.c_str(), 0755) != -1;
+
+    for (std::map<std::string, std::string>::const_iterator it = links.begin(); ready && it != links.end(); it++) {
+        ready = copyBlob(Blobs::Store::getBlobPath(it->second), directory + "/" + it->first);
+    }
+
+    if (!ready) {
+        perror("Error creating working directory");
+        Blobs::Store::release(jobID);
+    }
+
+    return ready;
+
+}
+
+/**
+ * @brief Removes the working directory of a job that has ended and drops its references to its
+ * blobs. A job that holds no blobs is ignored.
+ *
+ * @param jobID the job ID of the job
+*/
+void Blobs::Store::release(const std::string& jobID) {
+
+    pthread_mutex_lock(&Server::Process::mutex_blobs);
+
+    std::map<std::string, std::map<std::string, std::string>>::iterator it = Blobs::Store::pins.find(jobID);
+    if (it == Blobs::Store::pins.end()) {
+        pthread_mutex_unlock(&Server::Process::mutex_blobs);
+        return;
+    }
+
+    for (std::map<std::string, std::string>::iterator link = it->second.begin(); link != it->second.end(); link++) {
+        Blobs::Store::blobs[link->second].references--;
+    }
+
+    Blobs::Store::pins.erase(it);
+
+    pthread_mutex_unlock(&Server::Process::mutex_blobs);
+
+    // Whatever else the job wrote in its working directory goes along with it
+    removeDirectoryTree(Blobs::Store::getWorkDirectory(jobID));
+
+}
+
+/**
+ * @brief Returns the number of the stored blobs, the bytes they take and how many of them are
+ * used by running jobs.
+ *
+ * @param count the number of blobs
+ * @param bytes the bytes the blobs take
+ * @param inUse the number of blobs used by running jobs
+*/
+void Blobs::Store::getStats(unsigned long& count, unsigned long& bytes, unsigned long& inUse) {
+
+    pthread_mutex_lock(&Server::Process::mutex_blobs);
+
+    count = Blobs::Store::blobs.size();
+    bytes = Blobs::Store::storedBytes;
+    inUse = 0;
+
+    for (std::map<std::string, Blob>::iterator it = Blobs::Store::blobs.begin(); it != Blobs::Store::blobs.end(); it++) {
+        if (it->second.references > 0) inUse++;
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_blobs);
+
+}
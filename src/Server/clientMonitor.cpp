@@ -0,0 +1,249 @@
+/* Filename: clientMonitor.cpp */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include <sys/epoll.h>
+#include "../../include/clientMonitor.h"
+#include "../../include/controllerThread.h"
+#include "../../include/runningJobsTable.h"
+#include "../../include/dependencyGraph.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+#define KNRM  "\x1B[0m"
+#define KRED  "\x1B[31m"
+#define KGRN  "\x1B[32m"
+#define KYEL  "\x1B[33m"
+#define KBLU  "\x1B[34m"
+#define KMAG  "\x1B[35m"
+#define KCYN  "\x1B[36m"
+#define KWHT  "\x1B[37m"
+
+#define MONITOR_POLL_MILLISECONDS (200)
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Monitoring = Application_Job_Executor_Server::Application_Client_Monitor;
+namespace Controller = Application_Job_Executor_Server::Application_Controller_Thread;
+namespace RunningJobs = Application_Job_Executor_Server::Application_Running_Jobs;
+namespace Dependencies = Application_Job_Executor_Server::Application_Job_Dependencies;
+
+// Initialize the static members
+int Monitoring::Monitor::epollFD = -1;
+std::map<int, Monitoring::WatchedJob> Monitoring::Monitor::clients;
+bool Monitoring::Monitor::stopping = false;
+pthread_t Monitoring::Monitor::monitorThread;
+
+/**
+ * @brief Drops the work of a client that has gone away. Its job is removed if it has not
+ * started running yet, and its running job or tasks are stopped if they were issued with
+ * the cancel on disconnect policy.
+ *
+ * @param socketID the socket of the client
+ * @param watched the job the client was waiting for
+*/
+void Monitoring::Monitor::dropAbandonedJob(const int socketID, const WatchedJob& watched) {
+
+    // The tasks of a job array that have not started yet are removed along with the job array
+    bool removed = Controller::Thread::removeWaitingJob(watched.jobID, "JOB CANCELED BECAUSE ITS CLIENT DISCONNECTED");
+    unsigned int stopped = 0;
+
+    if (watched.cancelRunning) {
+
+        std::vector<RunningJobs::RunningJob> jobs;
+
+        pthread_mutex_lock(&Server::Process::mutex_worker);
+        RunningJobs::Table::getJobs(jobs);
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+        // Every task of a job array runs under its own job ID
+        for (unsigned int i = 0; i < jobs.size(); i++) {
+            const std::string& jobID = jobs[i].jobID;
+            if ((jobID == watched.jobID || jobID.compare(0, watched.jobID.size() + 1, watched.jobID + "[") == 0) && Controller::Thread::stopRunningJob(jobID)) {
+                stopped++;
+            }
+        }
+
+    }
+
+    if (!removed && stopped == 0) {
+        return;
+    }
+
+    std::cout << "---[" << KRED << "Client Disconnect" << KWHT << "]--- | ";
+    std::cout << "Socket ID: " << "[" << KRED << socketID << KWHT << "]" << " | ";
+    std::cout << "Job ID: " << "[" << KGRN << watched.jobID << KWHT << "]" << " | ";
+    std::cout << "Dropped: " << "[" << KYEL << (removed ? "waiting" : "") << (removed && stopped > 0 ? ", " : "");
+    std::cout << (stopped > 0 ? std::to_string(stopped) + " running" : "") << KWHT << "]" << std::endl;
+
+}
+
+/**
+ * @brief Monitor Thread function. It waits for the watched clients to hang up and drops
+ * their work, until it is stopped.
+ *
+ * @param arg unused
+ *
+ * @return anything
+*/
+void* Monitoring::Monitor::MonitorThread(void* arg) {
+
+    struct epoll_event events[64];
+
+    while (true) {
+
+        pthread_mutex_lock(&Server::Process::mutex_clients);
+        bool done = Monitoring::Monitor::stopping;
+        pthread_mutex_unlock(&Server::Process::mutex_clients);
+
+        if (done) {
+            break;
+        }
+
+        int ready = epoll_wait(Monitoring::Monitor::epollFD, events, 64, MONITOR_POLL_MILLISECONDS);
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            perror("Error waiting for client hangups");
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+
+            int socketID = events[i].data.fd;
+
+            if (!(events[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                continue;
+            }
+
+            // The socket is no longer watched once its client has hung up or its connection has failed, however its work is dropped
+            pthread_mutex_lock(&Server::Process::mutex_clients);
+
+            std::map<int, WatchedJob>::iterator it = Monitoring::Monitor::clients.find(socketID);
+            if (it == Monitoring::Monitor::clients.end()) {
+                pthread_mutex_unlock(&Server::Process::mutex_clients);
+                continue;
+            }
+
+            WatchedJob watched = it->second;
+            Monitoring::Monitor::clients.erase(it);
+            epoll_ctl(Monitoring::Monitor::epollFD, EPOLL_CTL_DEL, socketID, NULL);
+
+            pthread_mutex_unlock(&Server::Process::mutex_clients);
+
+            // Dropping the work takes the locks of the queue and the workers, so it is done without holding the monitor mutex
+            Monitoring::Monitor::dropAbandonedJob(socketID, watched);
+
+        }
+
+    }
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Creates the monitor thread.
+ *
+ * @return true if the monitor was started successfully, false otherwise
+*/
+bool Monitoring::Monitor::start(void) {
+
+    if ((Monitoring::Monitor::epollFD = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+        perror("Error creating monitor epoll instance");
+        return false;
+    }
+
+    if (pthread_create(&Monitoring::Monitor::monitorThread, NULL, Monitoring::Monitor::MonitorThread, NULL) != 0) {
+        perror("Error creating monitor thread");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops the monitor thread.
+*/
+void Monitoring::Monitor::stop(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_clients);
+    Monitoring::Monitor::stopping = true;
+    pthread_mutex_unlock(&Server::Process::mutex_clients);
+
+    pthread_join(Monitoring::Monitor::monitorThread, NULL);
+    close(Monitoring::Monitor::epollFD);
+
+}
+
+/**
+ * @brief Starts watching the connection of a client that waits for a job that has just
+ * been submitted.
+ *
+ * @param socketID the socket of the client
+ * @param jobID the job ID of the job
+ * @param cancelRunning whether the job is stopped even while running, if the client goes away
+ * @param outputs the outputs the client waits for, one for every task of a job array, 0 for a recurring job
+*/
+void Monitoring::Monitor::watch(const int socketID, const std::string& jobID, const bool cancelRunning, const unsigned long outputs) {
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLRDHUP | EPOLLHUP | EPOLLERR;
+    event.data.fd = socketID;
+
+    pthread_mutex_lock(&Server::Process::mutex_clients);
+
+    // A client that has already hung up is reported as soon as its socket is watched
+    if (epoll_ctl(Monitoring::Monitor::epollFD, EPOLL_CTL_ADD, socketID, &event) == -1) {
+        perror("Error watching client connection");
+    } else {
+        Monitoring::Monitor::clients[socketID] = { jobID, cancelRunning, outputs };
+    }
+
+    // A job that has already ended before its client was watched finds no client to release
+    Dependencies::State state;
+    if (outputs > 0 && Dependencies::Graph::getState(jobID, state) && state != Dependencies::JDS_PENDING) {
+        epoll_ctl(Monitoring::Monitor::epollFD, EPOLL_CTL_DEL, socketID, NULL);
+        Monitoring::Monitor::clients.erase(socketID);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_clients);
+
+}
+
+/**
+ * @brief Counts the end of a job, or of a task of a job array, towards the outputs its client
+ * waits for, and stops watching the connection of the client once it has got the last one.
+ *
+ * @param jobID the job ID of the job, or of the task of a job array
+*/
+void Monitoring::Monitor::release(const std::string& jobID) {
+
+    pthread_mutex_lock(&Server::Process::mutex_clients);
+
+    for (std::map<int, WatchedJob>::iterator it = Monitoring::Monitor::clients.begin(); it != Monitoring::Monitor::clients.end(); ++it) {
+
+        WatchedJob& watched = it->second;
+
+        // The end of a job array itself, when it is removed, leaves nothing for its client to wait for
+        bool task = jobID.compare(0, watched.jobID.size() + 1, watched.jobID + "[") == 0;
+        if ((jobID != watched.jobID && !task) || watched.outputs == 0) {
+            continue;
+        }
+
+        if (task && --watched.outputs > 0) {
+            break;
+        }
+
+        epoll_ctl(Monitoring::Monitor::epollFD, EPOLL_CTL_DEL, it->first, NULL);
+        Monitoring::Monitor::clients.erase(it);
+        break;
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_clients);
+
+}
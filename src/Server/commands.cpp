@@ -1,10 +1,14 @@
 /* Filename: commands.cpp */
 
+#include <cstdlib>
+#include <climits>
 #include "../../include/clientCommands.h"
 #include "../../include/common.h"
+#include "../../include/sha256.h"
 
 /* Namespace Alias */
 namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+namespace Sha = Application_Job_Commander_Client::Application_Sha256;
 
 /**
  * @brief Receives a specific client command as a string and returns its mode (ISSUE_JOB, POLL,
@@ -21,9 +25,15 @@ CC::CC_Mode getClientCommandMode(const std::string command) {
     
     // Determin the job type and return it
     if (firstArgument == "issueJob") { commandMode = CC::JECC_ISSUE_JOB; }
+    else if (firstArgument == "issueJobArray") { commandMode = CC::JECC_ISSUE_JOB_ARRAY; }
     else if (firstArgument == "setConcurrency") { commandMode = CC::JECC_SET_CONCURRENCY; }
     else if (firstArgument == "poll") { commandMode = CC::JECC_POLL; }
     else if (firstArgument == "stop") { commandMode = CC::JECC_STOP; }
+    else if (firstArgument == "stats") { commandMode = CC::JECC_STATS; }
+    else if (firstArgument == "result") { commandMode = CC::JECC_RESULT; }
+    else if (firstArgument == "watch") { commandMode = CC::JECC_WATCH; }
+    else if (firstArgument == "have") { commandMode = CC::JECC_HAVE; }
+    else if (firstArgument == "upload") { commandMode = CC::JECC_UPLOAD; }
     else if (firstArgument == "exit") { commandMode = CC::JECC_EXIT; }
     else { commandMode = CC::JECC_INVALID; }
 
@@ -31,6 +41,235 @@ CC::CC_Mode getClientCommandMode(const std::string command) {
 
 }
 
+/**
+ * @brief Supporting function that converts the given string to an unsigned number, making sure
+ * the whole string is a valid non negative number.
+ * 
+ * @param str the string to convert
+ * @param number the resulting number
+ * 
+ * @return true if the conversion was successfull, false otherwise
+*/
+static bool stringToUnsigned(const std::string str, unsigned long& number) {
+
+    if (str.empty() || str[0] == '-') {
+        return false;
+    }
+
+    char* end;
+    number = strtoul(str.c_str(), &end, 10);
+
+    return *end == '\0';
+
+}
+
+/**
+ * @brief Strips the leading '--option value' pairs from the given job string and stores them in the
+ * given job options. Parsing stops at the first word that is not an option, which is the executable
+ * of the job. Options that are not given keep their default values.
+ * 
+ * @param job the job string, which contains only the actual command after the call
+ * @param options the options of the job
+ * 
+ * @return true if every option was valid, false otherwise
+*/
+bool parseJobOptions(std::string& job, CC::JobOptions& options) {
+
+    // Set up the default options of a job
+    options.cpus = 1;
+    options.memory = 0;
+    options.priority = 0;
+    options.dependencies.clear();
+    options.startTime = 0;
+    options.period = 0;
+    options.streamOutput = false;
+    options.wallLimit = 0;
+    options.cpuLimit = 0;
+    options.memoryLimit = 0;
+    options.outputLimit = 0;
+    options.cacheable = false;
+    options.cacheInputs = false;
+    options.coalesce = false;
+    options.detach = false;
+    options.tag.clear();
+    options.headLines = 0;
+    options.tailLines = 0;
+    options.lineFilter.clear();
+    options.filterIsRegex = false;
+    options.maxBytes = 0;
+    options.compress = false;
+    options.cancelOnDisconnect = false;
+    options.input.clear();
+    options.blobs.clear();
+
+    // Consume every word starting with '--' along with its value
+    while (job.compare(0, 2, "--") == 0) {
+
+        std::string option = getFirstWord(job);
+        job = removeFirstWord(job);
+
+        std::string value = getFirstWord(job);
+        job = removeFirstWord(job);
+
+        unsigned long number;
+
+        if (option == "--cpus") {
+            // The CPUs are counted in an unsigned int, so a bigger request is rejected instead of wrapping around
+            if (!stringToUnsigned(value, number) || number == 0 || number > UINT_MAX) return false;
+            options.cpus = number;
+        }
+        else if (option == "--mem") {
+            if (!stringToUnsigned(value, number)) return false;
+            options.memory = number;
+        }
+        else if (option == "--priority") {
+            if (!stringToUnsigned(value, number) || number > UINT_MAX) return false;
+            options.priority = number;
+        }
+        else if (option == "--after") {
+            while (!value.empty()) {
+                options.dependencies.push_back(getFirstWord(value, ','));
+                value = removeFirstWord(value, ',');
+            }
+            if (options.dependencies.empty()) return false;
+        }
+        else if (option == "--at") {
+            // The start time is either a UNIX timestamp, or a number of seconds from now if it starts with '+'
+            bool relative = value.compare(0, 1, "+") == 0;
+            if (!stringToUnsigned(relative ? value.substr(1) : value, number)) return false;
+            options.startTime = relative ? time(NULL) + number : number;
+        }
+        else if (option == "--every") {
+            if (!stringToUnsigned(value, number) || number == 0) return false;
+            options.period = number;
+        }
+        else if (option == "--output") {
+            // The output is either sent whole when the job ends, or streamed while it runs
+            if (value != "file" && value != "stream") return false;
+            options.streamOutput = value == "stream";
+        }
+        else if (option == "--timeout") {
+            if (!stringToUnsigned(value, number)) return false;
+            options.wallLimit = number;
+        }
+        else if (option == "--cpu-limit") {
+            if (!stringToUnsigned(value, number)) return false;
+            options.cpuLimit = number;
+        }
+        else if (option == "--mem-limit") {
+            if (!stringToUnsigned(value, number)) return false;
+            options.memoryLimit = number;
+        }
+        else if (option == "--output-limit") {
+            if (!stringToUnsigned(value, number)) return false;
+            options.outputLimit = number;
+        }
+        else if (option == "--cacheable") {
+            // The output is reused for the same arguments, and with 'inputs' only while the files they name are unchanged
+            if (value != "no" && value != "yes" && value != "inputs") return false;
+            options.cacheable = value != "no";
+            options.cacheInputs = value == "inputs";
+        }
+        else if (option == "--coalesce") {
+            if (value != "no" && value != "yes") return false;
+            options.coalesce = value == "yes";
+        }
+        else if (option == "--detach") {
+            if (value != "no" && value != "yes") return false;
+            options.detach = value == "yes";
+        }
+        else if (option == "--tag") {
+            if (value.empty()) return false;
+            options.tag = value;
+        }
+        else if (option == "--head") {
+            if (!stringToUnsigned(value, number) || number == 0) return false;
+            options.headLines = number;
+        }
+        else if (option == "--tail") {
+            if (!stringToUnsigned(value, number) || number == 0) return false;
+            options.tailLines = number;
+        }
+        else if (option == "--grep" || option == "--grep-regex") {
+            if (value.empty()) return false;
+            options.lineFilter = value;
+            options.filterIsRegex = option == "--grep-regex";
+        }
+        else if (option == "--max-bytes") {
+            if (!stringToUnsigned(value, number) || number == 0) return false;
+            options.maxBytes = number;
+        }
+        else if (option == "--compress") {
+            if (value != "no" && value != "yes") return false;
+            options.compress = value == "yes";
+        }
+        else if (option == "--on-disconnect") {
+            if (value != "keep" && value != "cancel") return false;
+            options.cancelOnDisconnect = value == "cancel";
+        }
+        else if (option == "--input") {
+            // The client reads a file or its own standard input, and only tells the server that the input follows
+            if (value.empty()) return false;
+            options.input = value;
+        }
+        else if (option == "--blobs") {
+            // Every blob becomes a file of the working directory of the job, so its name is a plain file name
+            if (value.empty()) return false;
+            while (!value.empty()) {
+                std::string link = getFirstWord(value, ',');
+                value = removeFirstWord(value, ',');
+                size_t pos = link.find('=');
+                if (pos == std::string::npos) return false;
+                std::string name = link.substr(0, pos);
+                std::string digest = link.substr(pos + 1);
+                if (name.empty() || name == "." || name == ".." || name.find('/') != std::string::npos) return false;
+                if (!Sha::Digest::isValid(digest)) return false;
+                options.blobs[name] = digest;
+            }
+        }
+        else {
+            return false;
+        }
+
+    }
+
+    return !job.empty();
+
+}
+
+/**
+ * @brief Strips the index range '<first>..<last>' from the end of the given job array string.
+ * 
+ * @param job the job array string, which contains only the job template after the call
+ * @param first the first index of the range
+ * @param last the last index of the range
+ * 
+ * @return true if the range was valid, false otherwise
+*/
+bool parseJobArrayRange(std::string& job, unsigned long& first, unsigned long& last) {
+
+    // The range is the last word of the job array
+    size_t pos = job.find_last_of(' ');
+    if (pos == std::string::npos) {
+        return false;
+    }
+
+    std::string range = job.substr(pos + 1);
+    size_t dots = range.find("..");
+    if (dots == std::string::npos) {
+        return false;
+    }
+
+    if (!stringToUnsigned(range.substr(0, dots), first) || !stringToUnsigned(range.substr(dots + 2), last) || first > last) {
+        return false;
+    }
+
+    job = job.substr(0, pos);
+
+    return !job.empty();
+
+}
+
 /**
  * @brief Overloading operator << function that is being used to print a specific client command job
  * triplate to the tty.
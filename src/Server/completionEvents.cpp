@@ -0,0 +1,346 @@
+/* Filename: completionEvents.cpp */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "../../include/completionEvents.h"
+#include "../../include/dependencyGraph.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Events = Application_Job_Executor_Server::Application_Completion_Events;
+namespace Dependencies = Application_Job_Executor_Server::Application_Job_Dependencies;
+
+// Initialize the static members
+std::vector<Events::Subscription> Events::Publisher::subscriptions;
+std::vector<Events::CompletionEvent> Events::Publisher::pending;
+bool Events::Publisher::stopping = false;
+pthread_t Events::Publisher::publisherThread;
+
+/**
+ * @brief The messages a watching client is sent at once.
+*/
+typedef struct Application_Delivery {
+
+    int socketID;                      // The socket of the client
+    std::vector<std::string> messages; // The messages to send, in order
+    bool ended;                        // Whether the watch has ended, so the socket is closed after the messages
+
+} Delivery;
+
+/**
+ * @brief Supporting function that sends a single message, a size and that many bytes, to a watching
+ * client. The client may have gone away, so a closed socket must not raise SIGPIPE.
+ *
+ * @param socketID the socket of the client
+ * @param message the message to send
+ *
+ * @return true if the message was sent, false otherwise
+*/
+static bool sendFrame(const int socketID, const std::string& message) {
+
+    ssize_t messageSize = message.size();
+
+    if (send(socketID, &messageSize, sizeof(ssize_t), MSG_NOSIGNAL) != sizeof(ssize_t)) {
+        return false;
+    }
+
+    return send(socketID, message.data(), messageSize, MSG_NOSIGNAL) == messageSize;
+
+}
+
+/**
+ * @brief Supporting function that returns the line of a completion event, as it is shown to the clients.
+ *
+ * @param event the completion event
+ *
+ * @return the line of the event
+*/
+static std::string formatEvent(const Events::CompletionEvent& event) {
+
+    if (!event.ran) {
+        return "JOB <" + event.jobID + "> CANCELED";
+    }
+
+    std::string line = "JOB <" + event.jobID + ", ";
+    line += event.exitCode >= 0 ? "EXIT " + std::to_string(event.exitCode) : "NO EXIT CODE";
+    line += ", " + std::to_string(event.runtime) + " SEC, ";
+    line += event.outputSize >= 0 ? std::to_string(event.outputSize) + " BYTES" : "STREAMED";
+    line += std::string("> ") + (event.succeeded ? "SUCCEEDED" : "FAILED");
+
+    return line;
+
+}
+
+/**
+ * @brief Returns whether the given event is one of the events the given client watches.
+ * A task of a job array belongs to the job array.
+ *
+ * @param subscription the subscription of the client
+ * @param event the completion event
+ *
+ * @return true if the client watches the event, false otherwise
+*/
+bool Events::Publisher::matches(const Subscription& subscription, const CompletionEvent& event) {
+
+    if (subscription.kind == CEW_ALL) {
+        return true;
+    }
+    if (subscription.kind == CEW_TAG) {
+        return event.tag == subscription.tag;
+    }
+
+    for (unsigned int i = 0; i < subscription.jobIDs.size(); i++) {
+        const std::string& jobID = subscription.jobIDs[i];
+        if (event.jobID == jobID || event.jobID.compare(0, jobID.size() + 1, jobID + "[") == 0) {
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+/**
+ * @brief Returns whether every job of a watch on a set of jobs has finished. The caller must
+ * hold the events mutex of the server.
+ *
+ * @param subscription the subscription of the client
+ *
+ * @return true if the watch has ended, false otherwise
+*/
+bool Events::Publisher::hasEnded(const Subscription& subscription) {
+
+    if (subscription.kind != CEW_JOBS) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < subscription.jobIDs.size(); i++) {
+        Dependencies::State state;
+        if (Dependencies::Graph::getState(subscription.jobIDs[i], state) && state == Dependencies::JDS_PENDING) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Publisher Thread function. It sends the queued events to the clients that watch them,
+ * until it is stopped.
+ *
+ * @param arg unused
+ *
+ * @return anything
+*/
+void* Events::Publisher::PublisherThread(void* arg) {
+
+    pthread_mutex_lock(&Server::Process::mutex_events);
+
+    while (true) {
+
+        while (Events::Publisher::pending.empty() && !Events::Publisher::stopping) {
+            pthread_cond_wait(&Server::Process::condVar_events, &Server::Process::mutex_events);
+        }
+
+        // Take every queued event at once, so that the events of the jobs that ended together share a message
+        std::vector<CompletionEvent> events;
+        events.swap(Events::Publisher::pending);
+        bool stopping = Events::Publisher::stopping;
+
+        std::vector<Delivery> deliveries;
+
+        for (unsigned int i = 0; i < Events::Publisher::subscriptions.size(); ) {
+
+            const Subscription& subscription = Events::Publisher::subscriptions[i];
+            std::string lines;
+
+            for (unsigned int j = 0; j < events.size(); j++) {
+                if (Events::Publisher::matches(subscription, events[j])) {
+                    lines += (lines.empty() ? "" : "\n") + formatEvent(events[j]);
+                }
+            }
+
+            Delivery delivery = { subscription.socketID, {}, false };
+            if (!lines.empty()) {
+                delivery.messages.push_back(lines);
+            }
+
+            // A watch on a set of jobs can only end with the event of one of its jobs
+            if (!lines.empty() && Events::Publisher::hasEnded(subscription)) {
+                delivery.messages.push_back("WATCH ENDED");
+                delivery.ended = true;
+            }
+            else if (stopping) {
+                delivery.messages.push_back("SERVER TERMINATED");
+                delivery.ended = true;
+            }
+
+            if (!delivery.messages.empty()) {
+                deliveries.push_back(delivery);
+            }
+
+            if (delivery.ended) {
+                Events::Publisher::subscriptions.erase(Events::Publisher::subscriptions.begin() + i);
+            } else {
+                i++;
+            }
+
+        }
+
+        // Send the events without holding the mutex, so that a slow client does not hold back the jobs that finish
+        pthread_mutex_unlock(&Server::Process::mutex_events);
+
+        for (unsigned int i = 0; i < deliveries.size(); i++) {
+
+            bool sent = true;
+            for (unsigned int j = 0; j < deliveries[i].messages.size() && sent; j++) {
+                sent = sendFrame(deliveries[i].socketID, deliveries[i].messages[j]);
+            }
+
+            // A client that can not be reached has gone away, and its watch ends as well
+            if (!sent && !deliveries[i].ended) {
+
+                pthread_mutex_lock(&Server::Process::mutex_events);
+                for (unsigned int j = 0; j < Events::Publisher::subscriptions.size(); j++) {
+                    if (Events::Publisher::subscriptions[j].socketID == deliveries[i].socketID) {
+                        Events::Publisher::subscriptions.erase(Events::Publisher::subscriptions.begin() + j);
+                        break;
+                    }
+                }
+                pthread_mutex_unlock(&Server::Process::mutex_events);
+
+                deliveries[i].ended = true;
+
+            }
+
+            if (deliveries[i].ended) {
+                close(deliveries[i].socketID);
+            }
+
+        }
+
+        if (stopping) {
+            break;
+        }
+
+        pthread_mutex_lock(&Server::Process::mutex_events);
+
+    }
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Creates the publisher thread.
+ *
+ * @return true if the publisher was started successfully, false otherwise
+*/
+bool Events::Publisher::start(void) {
+
+    if (pthread_create(&Events::Publisher::publisherThread, NULL, Events::Publisher::PublisherThread, NULL) != 0) {
+        perror("Error creating publisher thread");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops the publisher thread, once the queued events have been sent, and ends every watch.
+*/
+void Events::Publisher::stop(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_events);
+    Events::Publisher::stopping = true;
+    pthread_cond_signal(&Server::Process::condVar_events);
+    pthread_mutex_unlock(&Server::Process::mutex_events);
+
+    pthread_join(Events::Publisher::publisherThread, NULL);
+
+}
+
+/**
+ * @brief Subscribes a client to the completion events of the given jobs and confirms it to the
+ * client. Every job of a watch on a set of jobs must have been submitted, and the ones that have
+ * already finished are reported right away.
+ *
+ * @param subscription the subscription of the client
+ * @param unknownID the first job ID that was never submitted, if any
+ *
+ * @return true if the client was subscribed, false if a job ID is unknown
+*/
+bool Events::Publisher::subscribe(const Subscription& subscription, std::string& unknownID) {
+
+    std::string confirmation;
+    std::string lines;
+
+    // The states are read while holding the events mutex, so that a job that ends meanwhile is either
+    // reported as finished here, or its event is queued after the client has been subscribed
+    pthread_mutex_lock(&Server::Process::mutex_events);
+
+    if (subscription.kind == CEW_ALL) {
+        confirmation = "WATCHING ALL JOBS";
+    }
+    else if (subscription.kind == CEW_TAG) {
+        confirmation = "WATCHING JOBS TAGGED " + subscription.tag;
+    }
+    else {
+
+        for (unsigned int i = 0; i < subscription.jobIDs.size(); i++) {
+
+            Dependencies::State state;
+
+            if (!Dependencies::Graph::getState(subscription.jobIDs[i], state)) {
+                pthread_mutex_unlock(&Server::Process::mutex_events);
+                unknownID = subscription.jobIDs[i];
+                return false;
+            }
+            if (state != Dependencies::JDS_PENDING) {
+                lines += (lines.empty() ? "" : "\n") + ("JOB <" + subscription.jobIDs[i] + "> ALREADY ") + (state == Dependencies::JDS_SUCCEEDED ? "SUCCEEDED" : "FAILED");
+            }
+
+        }
+
+        confirmation = "WATCHING " + std::to_string(subscription.jobIDs.size()) + " JOBS";
+
+    }
+
+    bool ended = Events::Publisher::hasEnded(subscription);
+
+    bool sent = sendFrame(subscription.socketID, confirmation);
+    if (sent && !lines.empty()) sent = sendFrame(subscription.socketID, lines);
+    if (sent && ended) sent = sendFrame(subscription.socketID, "WATCH ENDED");
+
+    if (sent && !ended) {
+        Events::Publisher::subscriptions.push_back(subscription);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_events);
+
+    if (!sent || ended) {
+        close(subscription.socketID);
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Queues the completion event of a job that has ended. It must be called once the end of
+ * the job has been recorded in the dependency graph.
+ *
+ * @param event the completion event
+*/
+void Events::Publisher::publish(const CompletionEvent& event) {
+
+    pthread_mutex_lock(&Server::Process::mutex_events);
+    Events::Publisher::pending.push_back(event);
+    pthread_cond_signal(&Server::Process::condVar_events);
+    pthread_mutex_unlock(&Server::Process::mutex_events);
+
+}
@@ -0,0 +1,465 @@
+/* Filename: cpuPlacement.cpp */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include "../../include/cpuPlacement.h"
+
+#define NODE_DIRECTORY "/sys/devices/system/node"
+
+namespace Placement = Application_Job_Executor_Server::Application_Cpu_Placement; // namespace alias
+
+// Initialize the static members
+Placement::Policy Placement::Engine::policy = Placement::CPL_NONE;
+std::vector<Placement::Core> Placement::Engine::cores;
+int Placement::Engine::nodes = 1;
+
+/**
+ * @brief Supporting function that returns whether the first core should be selected before the second,
+ * when the least busy cores with the lowest numbers are selected first.
+ *
+ * @param first the first core
+ * @param second the second core
+ *
+ * @return true if the first core comes first, false otherwise
+*/
+static bool lessBusyCore(const Placement::Core& first, const Placement::Core& second) {
+
+    if (first.load != second.load) return first.load < second.load;
+    if (first.node != second.node) return first.node < second.node;
+    return first.cpu < second.cpu;
+
+}
+
+/**
+ * @brief Supporting function that parses a list of cores of /sys, e.g. '0-3,8-11'.
+ *
+ * @param list the list of cores
+ * @param cpus the numbers of the cores of the list
+*/
+static void parseCpuList(const std::string& list, std::vector<int>& cpus) {
+
+    const char* position = list.c_str();
+
+    while (*position != '\0' && *position != '\n') {
+
+        char* end;
+        int first = strtol(position, &end, 10);
+        int last = first;
+        if (end == position) break;
+
+        if (*end == '-') {
+            position = end + 1;
+            last = strtol(position, &end, 10);
+        }
+
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+
+        position = (*end == ',') ? end + 1 : end;
+
+    }
+
+}
+
+/**
+ * @brief Reads the NUMA node of every core from /sys/devices/system/node. Every core is on
+ * node 0 if the machine does not report its nodes.
+*/
+void Placement::Engine::readNodes(void) {
+
+    DIR* directory = opendir(NODE_DIRECTORY);
+    if (directory == NULL) {
+        return;
+    }
+
+    std::vector<int> nodeNumbers;
+    struct dirent* entry;
+
+    while ((entry = readdir(directory)) != NULL) {
+
+        int node;
+        if (sscanf(entry->d_name, "node%d", &node) != 1) {
+            continue;
+        }
+
+        std::ifstream file(std::string(NODE_DIRECTORY) + "/" + entry->d_name + "/cpulist");
+        std::string list;
+        if (!std::getline(file, list)) {
+            continue;
+        }
+
+        std::vector<int> cpus;
+        parseCpuList(list, cpus);
+
+        for (Core& core : Placement::Engine::cores) {
+            if (std::find(cpus.begin(), cpus.end(), core.cpu) != cpus.end()) {
+                core.node = node;
+            }
+        }
+
+        nodeNumbers.push_back(node);
+
+    }
+
+    closedir(directory);
+
+    // The nodes are counted by their highest number, since node numbers may have gaps
+    for (int node : nodeNumbers) {
+        Placement::Engine::nodes = std::max(Placement::Engine::nodes, node + 1);
+    }
+
+}
+
+/**
+ * @brief Initializes the placement engine with the given policy and finds the cores the jobs
+ * can be placed on. It must be called before any thread of the server is created.
+ *
+ * @param policyName the name of the placement policy, none, compact, spread or numa
+ *
+ * @return true if the policy is known, false otherwise
+*/
+bool Placement::Engine::init(const std::string& policyName) {
+
+    if (policyName == "none") { Placement::Engine::policy = CPL_NONE; }
+    else if (policyName == "compact") { Placement::Engine::policy = CPL_COMPACT; }
+    else if (policyName == "spread") { Placement::Engine::policy = CPL_SPREAD; }
+    else if (policyName == "numa") { Placement::Engine::policy = CPL_NUMA; }
+    else { return false; }
+
+    if (Placement::Engine::policy == CPL_NONE) {
+        return true;
+    }
+
+    // The jobs can only be placed on the cores the server is allowed to run on
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == -1) {
+        perror("Error getting the cores of the server");
+        Placement::Engine::policy = CPL_NONE;
+        return true;
+    }
+
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            Placement::Engine::cores.push_back({ cpu, 0, 0 });
+        }
+    }
+
+    Placement::Engine::readNodes();
+
+    return true;
+
+}
+
+/**
+ * @brief Returns whether the jobs are placed on cores.
+ *
+ * @return true if a placement policy is set, false otherwise
+*/
+bool Placement::Engine::isEnabled(void) {
+
+    return Placement::Engine::policy != CPL_NONE && !Placement::Engine::cores.empty();
+
+}
+
+/**
+ * @brief Selects the given number of cores, packed on the least busy cores with the lowest numbers.
+ *
+ * @param count the number of cores to select
+ * @param selected the cores that were selected
+*/
+void Placement::Engine::placeCompact(const unsigned int count, std::vector<int>& selected) {
+
+    std::vector<Core> candidates = Placement::Engine::cores;
+    std::sort(candidates.begin(), candidates.end(), lessBusyCore);
+
+    for (unsigned int i = 0; i < count; i++) {
+        selected.push_back(candidates[i].cpu);
+    }
+
+}
+
+/**
+ * @brief Selects the given number of cores, one at a time from the least busy node.
+ *
+ * @param count the number of cores to select
+ * @param selected the cores that were selected
+*/
+void Placement::Engine::placeSpread(const unsigned int count, std::vector<int>& selected) {
+
+    std::vector<Core> candidates = Placement::Engine::cores;
+    std::vector<unsigned int> nodeLoads(Placement::Engine::nodes, 0);
+    std::vector<bool> taken(candidates.size(), false);
+
+    for (const Core& core : candidates) {
+        nodeLoads[core.node] += core.load;
+    }
+
+    // Every core is taken from the least busy node so far, counting the cores already taken for the job
+    for (unsigned int i = 0; i < count; i++) {
+
+        int best = -1;
+        for (unsigned int c = 0; c < candidates.size(); c++) {
+
+            if (taken[c]) continue;
+            if (best == -1) { best = c; continue; }
+
+            const Core& core = candidates[c];
+            const Core& current = candidates[best];
+
+            if (core.load != current.load) {
+                if (core.load < current.load) best = c;
+            } else if (nodeLoads[core.node] != nodeLoads[current.node]) {
+                if (nodeLoads[core.node] < nodeLoads[current.node]) best = c;
+            }
+
+        }
+
+        taken[best] = true;
+        nodeLoads[candidates[best].node]++;
+        selected.push_back(candidates[best].cpu);
+
+    }
+
+}
+
+/**
+ * @brief Selects the given number of cores inside the NUMA node whose least busy cores are the
+ * least busy. Among equally busy nodes the one with the fewest idle cores is chosen, so that whole
+ * nodes are left for bigger jobs. A job that does not fit in any node is placed compactly.
+ *
+ * @param count the number of cores to select
+ * @param selected the cores that were selected
+*/
+void Placement::Engine::placeNuma(const unsigned int count, std::vector<int>& selected) {
+
+    int bestNode = -1;
+    unsigned int bestLoad = 0, bestIdle = 0;
+    std::vector<Core> bestCores;
+
+    for (int node = 0; node < Placement::Engine::nodes; node++) {
+
+        std::vector<Core> nodeCores;
+        for (const Core& core : Placement::Engine::cores) {
+            if (core.node == node) nodeCores.push_back(core);
+        }
+
+        if (nodeCores.size() < count) {
+            continue;
+        }
+
+        std::sort(nodeCores.begin(), nodeCores.end(), lessBusyCore);
+
+        unsigned int load = 0, idle = 0;
+        for (unsigned int i = 0; i < nodeCores.size(); i++) {
+            if (i < count) load += nodeCores[i].load;
+            if (nodeCores[i].load == 0) idle++;
+        }
+
+        if (bestNode == -1 || load < bestLoad || (load == bestLoad && idle < bestIdle)) {
+            bestNode = node;
+            bestLoad = load;
+            bestIdle = idle;
+            bestCores = nodeCores;
+        }
+
+    }
+
+    if (bestNode == -1) {
+        Placement::Engine::placeCompact(count, selected);
+        return;
+    }
+
+    for (unsigned int i = 0; i < count; i++) {
+        selected.push_back(bestCores[i].cpu);
+    }
+
+}
+
+/**
+ * @brief Places a job that is about to be launched on the given number of cores, according to the
+ * placement policy, and marks them busy. A job asking for more CPUs than there are cores gets all
+ * of them. Nothing is placed if placement is disabled.
+ *
+ * @param cpus the number of CPUs the job has reserved
+ * @param selected the cores the job was placed on
+*/
+void Placement::Engine::place(const unsigned int cpus, std::vector<int>& selected) {
+
+    selected.clear();
+
+    if (!Placement::Engine::isEnabled()) {
+        return;
+    }
+
+    unsigned int count = std::min((size_t)std::max(cpus, 1u), Placement::Engine::cores.size());
+
+    switch (Placement::Engine::policy) {
+        case CPL_COMPACT: Placement::Engine::placeCompact(count, selected); break;
+        case CPL_SPREAD: Placement::Engine::placeSpread(count, selected); break;
+        case CPL_NUMA: Placement::Engine::placeNuma(count, selected); break;
+        default: break;
+    }
+
+    std::sort(selected.begin(), selected.end());
+    Placement::Engine::claim(selected);
+
+}
+
+/**
+ * @brief Marks the cores of a job busy again, when the job is resumed on them.
+ *
+ * @param selected the cores of the job
+*/
+void Placement::Engine::claim(const std::vector<int>& selected) {
+
+    for (Core& core : Placement::Engine::cores) {
+        if (std::find(selected.begin(), selected.end(), core.cpu) != selected.end()) {
+            core.load++;
+        }
+    }
+
+}
+
+/**
+ * @brief Marks the cores of a job free, when the job finishes or stops using them.
+ *
+ * @param selected the cores of the job
+*/
+void Placement::Engine::release(const std::vector<int>& selected) {
+
+    for (Core& core : Placement::Engine::cores) {
+        if (core.load > 0 && std::find(selected.begin(), selected.end(), core.cpu) != selected.end()) {
+            core.load--;
+        }
+    }
+
+}
+
+/**
+ * @brief Returns whether no running job is placed on any of the given cores.
+ *
+ * @param selected the cores of the job
+ *
+ * @return true if all the cores are free, false otherwise
+*/
+bool Placement::Engine::isFree(const std::vector<int>& selected) {
+
+    for (const Core& core : Placement::Engine::cores) {
+        if (core.load > 0 && std::find(selected.begin(), selected.end(), core.cpu) != selected.end()) {
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Moves every thread of every process of a job that is already running to the given
+ * cores, when the job has to continue on other cores than the ones it was launched on.
+ *
+ * @param processGroup the process group of the job
+ * @param selected the new cores of the job
+ *
+ * @return true if the job was moved, false otherwise
+*/
+bool Placement::Engine::movePlacedJob(const pid_t processGroup, const std::vector<int>& selected) {
+
+    cpu_set_t set;
+    Placement::Engine::getCpuSet(selected, set);
+
+    DIR* processes = opendir("/proc");
+    if (processes == NULL) {
+        perror("Error reading processes");
+        return false;
+    }
+
+    // The affinity belongs to every single thread, so the threads of the processes of the group are moved one by one
+    bool moved = true;
+    struct dirent* process;
+
+    while ((process = readdir(processes)) != NULL) {
+
+        pid_t pid = atoi(process->d_name);
+        if (pid <= 0 || getpgid(pid) != processGroup) {
+            continue;
+        }
+
+        std::string taskPath = std::string("/proc/") + process->d_name + "/task";
+        DIR* tasks = opendir(taskPath.c_str());
+        if (tasks == NULL) {
+            continue;
+        }
+
+        struct dirent* task;
+        while ((task = readdir(tasks)) != NULL) {
+            pid_t tid = atoi(task->d_name);
+            if (tid > 0 && sched_setaffinity(tid, sizeof(set), &set) == -1 && errno != ESRCH) {
+                perror("Error moving job to its cores");
+                moved = false;
+            }
+        }
+
+        closedir(tasks);
+
+    }
+
+    closedir(processes);
+
+    return moved;
+
+}
+
+/**
+ * @brief Fills the CPU set the launcher restricts a job to with the given cores.
+ *
+ * @param selected the cores of the job
+ * @param set the CPU set of the cores, empty if there are none
+*/
+void Placement::Engine::getCpuSet(const std::vector<int>& selected, cpu_set_t& set) {
+
+    CPU_ZERO(&set);
+    for (int cpu : selected) {
+        CPU_SET(cpu, &set);
+    }
+
+}
+
+/**
+ * @brief Formats the given cores as a list of numbers and ranges, e.g. '0-3,8'.
+ *
+ * @param selected the cores of the job
+ *
+ * @return the formatted cores
+*/
+std::string Placement::Engine::format(const std::vector<int>& selected) {
+
+    std::string list;
+
+    for (unsigned int i = 0; i < selected.size(); i++) {
+
+        // Consecutive cores are written as a range
+        unsigned int last = i;
+        while (last + 1 < selected.size() && selected[last + 1] == selected[last] + 1) {
+            last++;
+        }
+
+        if (!list.empty()) list += ",";
+        list += std::to_string(selected[i]);
+        if (last > i) list += "-" + std::to_string(selected[last]);
+
+        i = last;
+
+    }
+
+    return list;
+
+}
@@ -0,0 +1,254 @@
+/* Filename: dependencyGraph.cpp */
+
+#include "../../include/common.h"
+#include "../../include/dependencyGraph.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Dependencies = Application_Job_Executor_Server::Application_Job_Dependencies;
+
+// Initialize the static members
+std::map<std::string, Dependencies::State> Dependencies::Graph::states;
+std::map<std::string, std::vector<std::string>> Dependencies::Graph::dependents;
+std::map<std::string, Dependencies::BlockedJob> Dependencies::Graph::blocked;
+std::map<std::string, unsigned long> Dependencies::Graph::arrayTasks;
+
+/**
+ * @brief Marks the given job as failed and cancels every blocked job depending on it,
+ * recursively. The caller must hold the dependencies mutex of the server.
+ * 
+ * @param jobID the job ID of the failed job
+ * @param canceled the triplates of the blocked jobs that were canceled
+*/
+void Dependencies::Graph::failJob(const std::string jobID, std::vector<CC::JobTriplate>& canceled) {
+
+    Dependencies::Graph::states[jobID] = Dependencies::JDS_FAILED;
+    Dependencies::Graph::arrayTasks.erase(jobID);
+
+    std::map<std::string, std::vector<std::string>>::iterator edges = Dependencies::Graph::dependents.find(jobID);
+    if (edges == Dependencies::Graph::dependents.end()) {
+        return;
+    }
+
+    // Take the edges out of the graph, as the recursion below may modify it
+    std::vector<std::string> jobDependents;
+    jobDependents.swap(edges->second);
+    Dependencies::Graph::dependents.erase(edges);
+
+    // Cancel every dependent that is still blocked, along with its own dependents
+    for (unsigned int i = 0; i < jobDependents.size(); i++) {
+
+        std::map<std::string, Dependencies::BlockedJob>::iterator it = Dependencies::Graph::blocked.find(jobDependents[i]);
+        if (it == Dependencies::Graph::blocked.end()) {
+            continue;
+        }
+
+        canceled.push_back(it->second.triplate);
+        Dependencies::Graph::blocked.erase(it);
+
+        Dependencies::Graph::failJob(jobDependents[i], canceled);
+
+    }
+
+}
+
+/**
+ * @brief Adds a newly submitted job to the dependency graph and determines whether it can
+ * run right away. If it has to wait for its dependencies, it is placed in the blocked set.
+ * 
+ * @param triplate the triplate of the new job
+ * 
+ * @return the admission result of the job
+*/
+Dependencies::Admission Dependencies::Graph::addJob(const CC::JobTriplate& triplate) {
+
+    const std::vector<std::string>& dependencies = triplate.options.dependencies;
+    unsigned int pendingCount = 0;
+
+    pthread_mutex_lock(&Server::Process::mutex_dependencies);
+
+    // Check the state of every dependency, before touching the graph
+    for (unsigned int i = 0; i < dependencies.size(); i++) {
+
+        std::map<std::string, Dependencies::State>::iterator it = Dependencies::Graph::states.find(dependencies[i]);
+
+        if (it == Dependencies::Graph::states.end()) {
+            pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+            return Dependencies::JDA_UNKNOWN;
+        }
+
+        if (it->second == Dependencies::JDS_FAILED) {
+            Dependencies::Graph::states[triplate.jobID] = Dependencies::JDS_FAILED;
+            pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+            return Dependencies::JDA_FAILED;
+        }
+
+        if (it->second == Dependencies::JDS_PENDING) {
+            pendingCount++;
+        }
+
+    }
+
+    Dependencies::Graph::states[triplate.jobID] = Dependencies::JDS_PENDING;
+
+    if (triplate.isArray) {
+        Dependencies::Graph::arrayTasks[triplate.jobID] = triplate.arrayLast - triplate.arrayNext + 1;
+    }
+
+    if (pendingCount == 0) {
+        pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+        return Dependencies::JDA_READY;
+    }
+
+    // Add an edge from every unfinished dependency to the new job and block it
+    for (unsigned int i = 0; i < dependencies.size(); i++) {
+        if (Dependencies::Graph::states[dependencies[i]] == Dependencies::JDS_PENDING) {
+            Dependencies::Graph::dependents[dependencies[i]].push_back(triplate.jobID);
+        }
+    }
+
+    Dependencies::Graph::blocked[triplate.jobID] = { triplate, pendingCount };
+
+    pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+
+    return Dependencies::JDA_BLOCKED;
+
+}
+
+/**
+ * @brief Records the end of a job. If the job succeeded, its blocked dependents whose last
+ * dependency it was are released, otherwise all its blocked dependents are canceled. The end
+ * of a task 'job_N[i]' counts towards its job array, which succeeds when all of its tasks
+ * have succeeded and fails with its first failed task.
+ * 
+ * @param taskID the job ID of the finished job, or of the finished task of a job array
+ * @param succeeded whether the job finished successfully
+ * @param released the triplates of the jobs that can now be placed in the waiting buffer
+ * @param canceled the triplates of the blocked jobs that were canceled
+*/
+void Dependencies::Graph::finishJob(const std::string taskID, const bool succeeded, std::vector<CC::JobTriplate>& released, std::vector<CC::JobTriplate>& canceled) {
+
+    std::string jobID = taskID;
+
+    pthread_mutex_lock(&Server::Process::mutex_dependencies);
+
+    // The task of a job array only counts towards its array, which ends with its last task or its first failure
+    if (Dependencies::Graph::states.find(jobID) == Dependencies::Graph::states.end()) {
+
+        jobID = getFirstWord(taskID, '[');
+
+        std::map<std::string, unsigned long>::iterator it = Dependencies::Graph::arrayTasks.find(jobID);
+        if (it == Dependencies::Graph::arrayTasks.end() || (succeeded && --it->second > 0)) {
+            pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+            return;
+        }
+
+        Dependencies::Graph::arrayTasks.erase(it);
+
+    }
+
+    if (!succeeded) {
+        Dependencies::Graph::failJob(jobID, canceled);
+        pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+        return;
+    }
+
+    Dependencies::Graph::states[jobID] = Dependencies::JDS_SUCCEEDED;
+
+    std::map<std::string, std::vector<std::string>>::iterator edges = Dependencies::Graph::dependents.find(jobID);
+    if (edges != Dependencies::Graph::dependents.end()) {
+
+        // Release the dependents for which this was the last unfinished dependency
+        for (unsigned int i = 0; i < edges->second.size(); i++) {
+
+            std::map<std::string, Dependencies::BlockedJob>::iterator it = Dependencies::Graph::blocked.find(edges->second[i]);
+            if (it == Dependencies::Graph::blocked.end()) {
+                continue;
+            }
+
+            if (--it->second.pendingCount == 0) {
+                released.push_back(it->second.triplate);
+                Dependencies::Graph::blocked.erase(it);
+            }
+
+        }
+
+        Dependencies::Graph::dependents.erase(edges);
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+
+}
+
+/**
+ * @brief Searches for the blocked job with the specific job ID and if it is found, it
+ * removes it from the blocked set.
+ * 
+ * @param jobID the job ID of the job to remove
+ * @param triplate the triplate that has been removed
+ * 
+ * @return true if the job ID was found, false otherwise
+*/
+bool Dependencies::Graph::removeBlockedJob(const std::string jobID, CC::JobTriplate& triplate) {
+
+    pthread_mutex_lock(&Server::Process::mutex_dependencies);
+
+    std::map<std::string, Dependencies::BlockedJob>::iterator it = Dependencies::Graph::blocked.find(jobID);
+    bool found = it != Dependencies::Graph::blocked.end();
+
+    if (found) {
+        triplate = it->second.triplate;
+        Dependencies::Graph::blocked.erase(it);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+
+    return found;
+
+}
+
+/**
+ * @brief Removes every job of the blocked set.
+ * 
+ * @param triplates the triplates of the jobs that were removed
+*/
+void Dependencies::Graph::removeAllBlockedJobs(std::vector<CC::JobTriplate>& triplates) {
+
+    pthread_mutex_lock(&Server::Process::mutex_dependencies);
+
+    for (auto& entry : Dependencies::Graph::blocked) {
+        triplates.push_back(entry.second.triplate);
+    }
+
+    Dependencies::Graph::blocked.clear();
+
+    pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+
+}
+
+/**
+ * @brief Returns the state of the job with the specific job ID.
+ * 
+ * @param jobID the job ID of the job
+ * @param state the state of the job
+ * 
+ * @return true if the job ID was ever submitted, false otherwise
+*/
+bool Dependencies::Graph::getState(const std::string jobID, State& state) {
+
+    pthread_mutex_lock(&Server::Process::mutex_dependencies);
+
+    std::map<std::string, Dependencies::State>::iterator it = Dependencies::Graph::states.find(jobID);
+    bool found = it != Dependencies::Graph::states.end();
+
+    if (found) {
+        state = it->second;
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_dependencies);
+
+    return found;
+
+}
@@ -0,0 +1,304 @@
+/* Filename: inputFeeder.cpp */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include "../../include/inputFeeder.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+#define KNRM  "\x1B[0m"
+#define KRED  "\x1B[31m"
+#define KGRN  "\x1B[32m"
+#define KYEL  "\x1B[33m"
+#define KBLU  "\x1B[34m"
+#define KMAG  "\x1B[35m"
+#define KCYN  "\x1B[36m"
+#define KWHT  "\x1B[37m"
+
+#define FEED_POLL_MILLISECONDS (100)
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Feeding = Application_Job_Executor_Server::Application_Input_Feeder;
+
+// Initialize the static members
+int Feeding::Feeder::epollFD = -1;
+std::map<int, Feeding::Feed> Feeding::Feeder::feeds;
+bool Feeding::Feeder::stopping = false;
+pthread_t Feeding::Feeder::feederThread;
+
+/**
+ * @brief Moves the next frame header or chunk of input of the given feed from its client to
+ * its job, or ends the input once the empty frame arrives or the client has gone away.
+ *
+ * @param socketID the socket of the client of the feed
+ * @param hangUp true if the client has closed its end of the connection
+ *
+ * @return true if the input continues, false if it has ended
+*/
+bool Feeding::Feeder::feedChunk(const int socketID, const bool hangUp) {
+
+    Feeding::Feed& feed = Feeding::Feeder::feeds[socketID];
+
+    int available = 0;
+    if (ioctl(socketID, FIONREAD, &available) == -1) {
+        perror("Error checking job input");
+        return false;
+    }
+
+    // A client that has gone away in the middle of a frame has nothing more to send
+    if (feed.frameLeft == 0 && available < (int)sizeof(ssize_t)) {
+        return !hangUp;
+    }
+    if (feed.frameLeft > 0 && available == 0) {
+        return !hangUp;
+    }
+
+    // The empty frame ends the input
+    if (feed.frameLeft == 0) {
+        ssize_t frameSize = 0;
+        if (recv(socketID, &frameSize, sizeof(ssize_t), 0) != sizeof(ssize_t) || frameSize <= 0) {
+            return false;
+        }
+        feed.frameLeft = frameSize;
+        return true;
+    }
+
+    // Only bytes that have already arrived are moved, so the splice() never waits for the client
+    ssize_t chunkSize = feed.frameLeft;
+    if (chunkSize > available) chunkSize = available;
+    if (chunkSize > INPUT_CHUNK_SIZE) chunkSize = INPUT_CHUNK_SIZE;
+
+    // A job that has closed its input does not stop its client, so the rest of the input is still drained
+    if (feed.pipeFD == -1) {
+        char discarded[INPUT_CHUNK_SIZE];
+        ssize_t bytes = recv(socketID, discarded, chunkSize, 0);
+        if (bytes > 0) feed.frameLeft -= bytes;
+        return bytes > 0 || (bytes == -1 && errno == EINTR);
+    }
+
+    ssize_t bytes = splice(socketID, NULL, feed.pipeFD, NULL, chunkSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+
+    if (bytes == -1 && errno == EINTR) {
+        return true;
+    }
+
+    // A full pipe waits for the job to read, which leaves the input in the socket and holds back the client
+    if (bytes == -1 && errno == EAGAIN) {
+        Feeding::Feeder::switchWaiting(socketID, true);
+        return true;
+    }
+
+    if (bytes == -1 && errno == EPIPE) {
+        close(feed.pipeFD);
+        feed.pipeFD = -1;
+        return true;
+    }
+
+    if (bytes <= 0) {
+        return false;
+    }
+
+    feed.frameLeft -= bytes;
+    feed.fed += bytes;
+
+    return true;
+
+}
+
+/**
+ * @brief Stops reading the socket of the given feed until its job has read from its full pipe,
+ * or starts reading it again once it has.
+ *
+ * @param socketID the socket of the client of the feed
+ * @param waitForPipe true to wait for the pipe, false to go back to the socket
+*/
+void Feeding::Feeder::switchWaiting(const int socketID, const bool waitForPipe) {
+
+    Feeding::Feed& feed = Feeding::Feeder::feeds[socketID];
+
+    // Either the socket or the pipe is watched, and both report the socket, which the feed is found by
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = waitForPipe ? EPOLLOUT : (EPOLLIN | EPOLLRDHUP);
+    event.data.fd = socketID;
+
+    epoll_ctl(Feeding::Feeder::epollFD, EPOLL_CTL_DEL, waitForPipe ? socketID : feed.pipeFD, NULL);
+    if (epoll_ctl(Feeding::Feeder::epollFD, EPOLL_CTL_ADD, waitForPipe ? feed.pipeFD : socketID, &event) == -1) {
+        perror("Error watching job input");
+    }
+
+    feed.waitingForPipe = waitForPipe;
+
+}
+
+/**
+ * @brief Ends the given feed. The pipe is closed, so the job sees the end of its input.
+ *
+ * @param socketID the socket of the client of the feed
+*/
+void Feeding::Feeder::endFeed(const int socketID) {
+
+    Feeding::Feed& feed = Feeding::Feeder::feeds[socketID];
+
+    epoll_ctl(Feeding::Feeder::epollFD, EPOLL_CTL_DEL, feed.waitingForPipe ? feed.pipeFD : socketID, NULL);
+    if (feed.pipeFD != -1) {
+        close(feed.pipeFD);
+    }
+
+    std::cout << "---[" << KCYN << "Job  Input" << KWHT << "]--- | ";
+    std::cout << "Job ID: " << "[" << KGRN << feed.jobID << KWHT << "]" << " | ";
+    std::cout << "Fed: " << "[" << KYEL << feed.fed << " bytes" << KWHT << "]" << std::endl;
+
+    Feeding::Feeder::feeds.erase(socketID);
+
+}
+
+/**
+ * @brief Feeder Thread function. It waits for input on every socket and room in every full
+ * pipe, and moves the input to the jobs, until it is stopped.
+ *
+ * @param arg unused
+ *
+ * @return anything
+*/
+void* Feeding::Feeder::FeederThread(void* arg) {
+
+    // A job that has closed its input must fail the splice() instead of raising SIGPIPE in the server
+    sigset_t pipeSignal;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, NULL);
+
+    struct epoll_event events[64];
+
+    while (true) {
+
+        pthread_mutex_lock(&Server::Process::mutex_inputs);
+        bool done = Feeding::Feeder::stopping;
+        pthread_mutex_unlock(&Server::Process::mutex_inputs);
+
+        if (done) {
+            break;
+        }
+
+        int ready = epoll_wait(Feeding::Feeder::epollFD, events, 64, FEED_POLL_MILLISECONDS);
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            perror("Error waiting for job input");
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+
+            int socketID = events[i].data.fd;
+
+            pthread_mutex_lock(&Server::Process::mutex_inputs);
+
+            // An event of an input that has ended in this same round is stale
+            if (Feeding::Feeder::feeds.find(socketID) == Feeding::Feeder::feeds.end()) {
+                pthread_mutex_unlock(&Server::Process::mutex_inputs);
+                continue;
+            }
+
+            // The pipe of a feed that waits for it has room again, or its job has closed it
+            bool hangUp = false;
+            if (Feeding::Feeder::feeds[socketID].waitingForPipe) {
+                Feeding::Feeder::switchWaiting(socketID, false);
+            } else {
+                hangUp = events[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR);
+            }
+
+            if (!Feeding::Feeder::feedChunk(socketID, hangUp)) {
+                Feeding::Feeder::endFeed(socketID);
+            }
+
+            pthread_mutex_unlock(&Server::Process::mutex_inputs);
+
+        }
+
+    }
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Creates the feeder thread.
+ *
+ * @return true if the feeder was started successfully, false otherwise
+*/
+bool Feeding::Feeder::start(void) {
+
+    if ((Feeding::Feeder::epollFD = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+        perror("Error creating feeder epoll instance");
+        return false;
+    }
+
+    if (pthread_create(&Feeding::Feeder::feederThread, NULL, Feeding::Feeder::FeederThread, NULL) != 0) {
+        perror("Error creating feeder thread");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops the feeder thread and closes the pipes of the inputs that have not ended.
+*/
+void Feeding::Feeder::stop(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_inputs);
+    Feeding::Feeder::stopping = true;
+    pthread_mutex_unlock(&Server::Process::mutex_inputs);
+
+    pthread_join(Feeding::Feeder::feederThread, NULL);
+
+    // The clients of these inputs may never send the rest, so their jobs see the end of their input right away
+    while (!Feeding::Feeder::feeds.empty()) {
+        Feeding::Feeder::endFeed(Feeding::Feeder::feeds.begin()->first);
+    }
+
+    close(Feeding::Feeder::epollFD);
+
+}
+
+/**
+ * @brief Starts feeding the input that the client of a job sends to the write end of the
+ * input pipe of the job, which is closed when the input ends.
+ *
+ * @param pipeFD the write end of the input pipe of the job
+ * @param socketID the socket of the client
+ * @param jobID the job ID of the job
+ *
+ * @return true if the feed was started, false otherwise
+*/
+bool Feeding::Feeder::feed(const int pipeFD, const int socketID, const std::string& jobID) {
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLRDHUP;
+    event.data.fd = socketID;
+
+    pthread_mutex_lock(&Server::Process::mutex_inputs);
+
+    Feeding::Feeder::feeds[socketID] = { jobID, pipeFD, 0, false, 0 };
+
+    bool added = epoll_ctl(Feeding::Feeder::epollFD, EPOLL_CTL_ADD, socketID, &event) != -1;
+    if (!added) {
+        perror("Error watching job input");
+        Feeding::Feeder::feeds.erase(socketID);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_inputs);
+
+    return added;
+
+}
@@ -0,0 +1,171 @@
+/* Filename: jobCoalescing.cpp */
+
+#include "../../include/jobCoalescing.h"
+#include "../../include/resultCache.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Coalescing = Application_Job_Executor_Server::Application_Job_Coalescing;
+namespace Results = Application_Job_Executor_Server::Application_Result_Cache;
+
+// Initialize the static members
+std::map<std::string, Coalescing::InFlightJob> Coalescing::Coalescer::jobs;
+unsigned long Coalescing::Coalescer::submissions = 0;
+unsigned long Coalescing::Coalescer::coalesced = 0;
+
+/**
+ * @brief Returns the normalized arguments of the given job, that identify it among the jobs in flight.
+ *
+ * @param job the job string
+ *
+ * @return the normalized arguments
+*/
+std::string Coalescing::Coalescer::getKey(const std::string& job) {
+
+    std::vector<std::string> arguments;
+    return Results::Cache::normalize(job, arguments);
+
+}
+
+/**
+ * @brief Attaches a newly submitted job to an identical job in flight. If there is none, the
+ * job becomes the job in flight that later identical jobs are attached to.
+ *
+ * @param triplate the triplate of the submitted job
+ * @param leaderID the job ID of the job it was attached to
+ *
+ * @return true if the job was attached as a waiter, false if it must run itself
+*/
+bool Coalescing::Coalescer::attach(const CC::JobTriplate& triplate, std::string& leaderID) {
+
+    std::string key = Coalescing::Coalescer::getKey(triplate.job);
+
+    pthread_mutex_lock(&Server::Process::mutex_coalescing);
+
+    Coalescing::Coalescer::submissions++;
+
+    std::map<std::string, InFlightJob>::iterator it = Coalescing::Coalescer::jobs.find(key);
+    bool attached = it != Coalescing::Coalescer::jobs.end();
+
+    if (attached) {
+        it->second.waiters.push_back(triplate);
+        leaderID = it->second.leaderID;
+        Coalescing::Coalescer::coalesced++;
+    } else {
+        Coalescing::Coalescer::jobs[key] = { triplate.jobID, {} };
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_coalescing);
+
+    return attached;
+
+}
+
+/**
+ * @brief Removes a job in flight that has finished, or that will never run, and returns the jobs
+ * waiting for its output.
+ *
+ * @param leader the triplate of the job in flight
+ * @param waiters the jobs that were waiting for its output
+*/
+void Coalescing::Coalescer::detach(const CC::JobTriplate& leader, std::vector<CC::JobTriplate>& waiters) {
+
+    std::string key = Coalescing::Coalescer::getKey(leader.job);
+
+    pthread_mutex_lock(&Server::Process::mutex_coalescing);
+
+    std::map<std::string, InFlightJob>::iterator it = Coalescing::Coalescer::jobs.find(key);
+    if (it != Coalescing::Coalescer::jobs.end() && it->second.leaderID == leader.jobID) {
+        waiters = it->second.waiters;
+        Coalescing::Coalescer::jobs.erase(it);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_coalescing);
+
+}
+
+/**
+ * @brief Hands a queued job in flight that was stopped over to its first waiter, which has to take
+ * its place in the queue. The job in flight is removed if nobody waits for it.
+ *
+ * @param leader the triplate of the stopped job
+ * @param successor the waiter that becomes the job in flight
+ *
+ * @return true if a waiter took over, false otherwise
+*/
+bool Coalescing::Coalescer::handOver(const CC::JobTriplate& leader, CC::JobTriplate& successor) {
+
+    std::string key = Coalescing::Coalescer::getKey(leader.job);
+    bool handedOver = false;
+
+    pthread_mutex_lock(&Server::Process::mutex_coalescing);
+
+    std::map<std::string, InFlightJob>::iterator it = Coalescing::Coalescer::jobs.find(key);
+    if (it != Coalescing::Coalescer::jobs.end() && it->second.leaderID == leader.jobID) {
+
+        if (it->second.waiters.empty()) {
+            Coalescing::Coalescer::jobs.erase(it);
+        } else {
+            successor = it->second.waiters.front();
+            it->second.waiters.erase(it->second.waiters.begin());
+            it->second.leaderID = successor.jobID;
+            handedOver = true;
+        }
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_coalescing);
+
+    return handedOver;
+
+}
+
+/**
+ * @brief Removes a waiter with the given job ID, when it is stopped.
+ *
+ * @param jobID the job ID of the waiter
+ * @param triplate the triplate of the waiter that was removed
+ *
+ * @return true if the waiter was found, false otherwise
+*/
+bool Coalescing::Coalescer::removeWaiter(const std::string& jobID, CC::JobTriplate& triplate) {
+
+    pthread_mutex_lock(&Server::Process::mutex_coalescing);
+
+    for (std::pair<const std::string, InFlightJob>& entry : Coalescing::Coalescer::jobs) {
+
+        std::vector<CC::JobTriplate>& waiters = entry.second.waiters;
+
+        for (unsigned int i = 0; i < waiters.size(); i++) {
+            if (waiters[i].jobID == jobID) {
+                triplate = waiters[i];
+                waiters.erase(waiters.begin() + i);
+                pthread_mutex_unlock(&Server::Process::mutex_coalescing);
+                return true;
+            }
+        }
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_coalescing);
+
+    return false;
+
+}
+
+/**
+ * @brief Returns how many coalescing jobs have been submitted, and how many of them were attached
+ * to an identical job.
+ *
+ * @param submitted the coalescing jobs that have been submitted
+ * @param attached the coalescing jobs that were attached to an identical job
+*/
+void Coalescing::Coalescer::getStats(unsigned long& submitted, unsigned long& attached) {
+
+    pthread_mutex_lock(&Server::Process::mutex_coalescing);
+    submitted = Coalescing::Coalescer::submissions;
+    attached = Coalescing::Coalescer::coalesced;
+    pthread_mutex_unlock(&Server::Process::mutex_coalescing);
+
+}
@@ -0,0 +1,605 @@
+/* Filename: jobLauncher.cpp */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/signalfd.h>
+#include "../../include/jobLauncher.h"
+#include "../../include/jobExecutorServerProcess.h"
+#include "../../include/jobSupervisor.h"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Launch = Application_Job_Executor_Server::Application_Job_Launcher;
+namespace Supervision = Application_Job_Executor_Server::Application_Job_Supervisor;
+
+// Initialize the static members
+int Launch::Launcher::launcherSocket = -1;
+pid_t Launch::Launcher::launcherPID = -1;
+pthread_t Launch::Launcher::replyThread;
+bool Launch::Launcher::launcherAlive = false;
+unsigned long Launch::Launcher::nextTag = 0;
+std::map<unsigned long, Launch::Reply> Launch::Launcher::spawnedReplies;
+unsigned long Launch::Launcher::cacheHits = 0;
+unsigned long Launch::Launcher::cacheMisses = 0;
+std::map<std::string, Launch::ResolvedExecutable> Launch::Launcher::executables;
+
+/**
+ * @brief Supporting function that sends a reply of the launcher process to the server.
+ * 
+ * @param socketFD the launcher end of the socket pair
+ * @param reply the reply to send
+*/
+static void sendReply(const int socketFD, const Launch::Reply& reply) {
+
+    if (send(socketFD, &reply, sizeof(reply), MSG_NOSIGNAL) != sizeof(reply)) {
+        perror("Error sending launcher reply");
+    }
+
+}
+
+/**
+ * @brief Supporting function that sets the resource limits of the calling process, which is
+ * about to become a job. The CPU limit raises SIGXCPU, and SIGKILL a second later if the job
+ * ignores it.
+ * 
+ * @param limits the resource limits of the job
+ * 
+ * @return true if every limit was set, false otherwise
+*/
+static bool setJobLimits(const Launch::Limits& limits) {
+
+    struct rlimit limit;
+
+    if (limits.cpuSeconds > 0) {
+        limit.rlim_cur = limits.cpuSeconds;
+        limit.rlim_max = limits.cpuSeconds + 1;
+        if (setrlimit(RLIMIT_CPU, &limit) == -1) return false;
+    }
+
+    if (limits.addressSpace > 0) {
+        limit.rlim_cur = limit.rlim_max = limits.addressSpace * 1024 * 1024;
+        if (setrlimit(RLIMIT_AS, &limit) == -1) return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Supporting function that launches a job with resource limits or placed on cores. posix_spawn()
+ * can not set limits or the affinity of the child, and setting them after the job has started leaves
+ * it running without them for a while, so the launcher forks the job itself. The launcher is a small
+ * single-threaded process, so forking it is cheap and safe. The child reports a failed exec() through a pipe.
+ * 
+ * @param executable the full path of the executable
+ * @param argv the arguments of the job
+ * @param outputFD the file descriptor of the output file of the job
+ * @param inputFD the file descriptor of the input pipe of the job, -1 if it has no input
+ * @param directoryFD the file descriptor of the working directory of the job, -1 to run it in the directory of the server
+ * @param limits the resource limits of the job
+ * @param cpus the cores the job is placed on, empty if it can run on any core
+ * @param pid the process ID of the new process
+ * 
+ * @return zero if the job was launched successfully, the error number otherwise
+*/
+static int forkLimitedJob(const char* executable, char* const* argv, const int outputFD, const int inputFD, const int directoryFD, const Launch::Limits& limits, const cpu_set_t& cpus, pid_t& pid) {
+
+    int errorPipe[2];
+    if (pipe2(errorPipe, O_CLOEXEC) == -1) {
+        return errno;
+    }
+
+    if ((pid = fork()) == -1) {
+        int error = errno;
+        close(errorPipe[0]);
+        close(errorPipe[1]);
+        return error;
+    }
+
+    /* Job process code */
+    if (pid == 0) {
+
+        sigset_t signalMask;
+        sigemptyset(&signalMask);
+        sigprocmask(SIG_SETMASK, &signalMask, NULL);
+
+        setpgid(0, 0);
+
+        int error = 0;
+        // The cores are set before the exec(), so every process the job creates inherits them
+        if (dup2(outputFD, STDOUT_FILENO) == -1 || (inputFD != -1 && dup2(inputFD, STDIN_FILENO) == -1) ||
+            (directoryFD != -1 && fchdir(directoryFD) == -1) || !setJobLimits(limits) ||
+            (CPU_COUNT(&cpus) > 0 && sched_setaffinity(0, sizeof(cpus), &cpus) == -1)) {
+            error = errno;
+        } else {
+            execve(executable, argv, environ);
+            error = errno;
+        }
+
+        if (write(errorPipe[1], &error, sizeof(error)) == -1) {}
+        _exit(127);
+
+    }
+
+    // The pipe is closed by a successful exec(), otherwise it carries the error of the child
+    close(errorPipe[1]);
+
+    int error = 0;
+    if (read(errorPipe[0], &error, sizeof(error)) != sizeof(error)) {
+        error = 0;
+    }
+    close(errorPipe[0]);
+
+    if (error != 0) {
+        waitpid(pid, NULL, 0);
+        pid = -1;
+    }
+
+    return error;
+
+}
+
+/**
+ * @brief Splits the given job string into the arguments of its executable.
+ * 
+ * @param job the job string
+ * @param arguments the arguments of the job, where the first one is the executable
+*/
+void Launch::Launcher::getJobArguments(const std::string& job, std::vector<std::string>& arguments) {
+
+    size_t start = job.find_first_not_of(' ');
+
+    while (start != std::string::npos) {
+        size_t end = job.find(' ', start);
+        arguments.push_back(job.substr(start, end - start));
+        start = job.find_first_not_of(' ', end);
+    }
+
+}
+
+/**
+ * @brief Finds the full path of the given executable. A name that contains a slash is used as it
+ * is, otherwise the cached path is used as long as its file has not changed, or $PATH is searched
+ * and the path that is found is cached.
+ * 
+ * @param name the executable of the job
+ * @param path the full path of the executable
+ * 
+ * @return how the executable was found
+*/
+Launch::ExecutableLookup Launch::Launcher::resolveExecutable(const std::string& name, std::string& path) {
+
+    struct stat st;
+    path = name;
+
+    if (name.find('/') != std::string::npos) {
+        return JLX_DIRECT;
+    }
+
+    // A cached executable is used only if it is still the same file, otherwise it is searched again
+    std::map<std::string, ResolvedExecutable>::iterator it = Launch::Launcher::executables.find(name);
+    if (it != Launch::Launcher::executables.end()) {
+
+        const ResolvedExecutable& cached = it->second;
+
+        if (stat(cached.path.c_str(), &st) == 0 && st.st_dev == cached.device && st.st_ino == cached.inode &&
+            st.st_mtim.tv_sec == cached.modified.tv_sec && st.st_mtim.tv_nsec == cached.modified.tv_nsec) {
+            path = cached.path;
+            return JLX_CACHED;
+        }
+
+        Launch::Launcher::executables.erase(it);
+
+    }
+
+    // Search every directory of $PATH in order, like execvp() does
+    const char* searchPath = getenv("PATH");
+    std::string directories = searchPath != NULL ? searchPath : "/usr/local/bin:/usr/bin:/bin";
+
+    size_t start = 0;
+    while (start <= directories.size()) {
+
+        size_t end = directories.find(':', start);
+        if (end == std::string::npos) end = directories.size();
+
+        // An empty directory of $PATH stands for the current directory
+        std::string directory = directories.substr(start, end - start);
+        std::string candidate = (directory.empty() ? "." : directory) + "/" + name;
+
+        if (stat(candidate.c_str(), &st) == 0 && S_ISREG(st.st_mode) && access(candidate.c_str(), X_OK) == 0) {
+            Launch::Launcher::executables[name] = { candidate, st.st_dev, st.st_ino, st.st_mtim };
+            path = candidate;
+            return JLX_RESOLVED;
+        }
+
+        start = end + 1;
+
+    }
+
+    // The executable was not found, so launching it fails the same way execvp() would
+    return JLX_DIRECT;
+
+}
+
+/**
+ * @brief Launches the given job with posix_spawn() in a new process, which is the leader of
+ * its own process group and whose standard output is the given file descriptor. The executable
+ * is launched by its full path, which is found through the executable cache. A job with
+ * resource limits or placed on cores is forked by the launcher instead, which sets them before
+ * the exec(). A job with input reads it from the given pipe as its standard input. A job with
+ * a working directory of its own is forked as well, since it has to change to it before the exec().
+ * 
+ * @param job the job string
+ * @param outputFD the file descriptor of the output file of the job
+ * @param inputFD the file descriptor of the input pipe of the job, -1 if it has no input
+ * @param directoryFD the file descriptor of the working directory of the job, -1 to run it in the directory of the server
+ * @param limits the resource limits of the job
+ * @param cpus the cores the job is placed on, empty if it can run on any core
+ * @param pid the process ID of the new process
+ * @param lookup how the executable of the job was found
+ * 
+ * @return zero if the job was launched successfully, the error number otherwise
+*/
+int Launch::Launcher::spawnJobProcess(const std::string& job, const int outputFD, const int inputFD, const int directoryFD, const Limits& limits, const cpu_set_t& cpus, pid_t& pid, ExecutableLookup& lookup) {
+
+    std::vector<std::string> arguments;
+    Launch::Launcher::getJobArguments(job, arguments);
+
+    lookup = JLX_DIRECT;
+    if (arguments.empty()) {
+        return EINVAL;
+    }
+
+    std::string executable;
+    lookup = Launch::Launcher::resolveExecutable(arguments[0], executable);
+
+    std::vector<char*> argv;
+    for (unsigned int i = 0; i < arguments.size(); i++) {
+        argv.push_back((char*)arguments[i].c_str());
+    }
+    argv.push_back(NULL);
+
+    // The CPU and address space limits, the cores and the working directory of the job must be in place before the job
+    // starts. The wall time and the output limits are enforced by the supervisor, so they do not need the slower fork
+    if (limits.cpuSeconds > 0 || limits.addressSpace > 0 || CPU_COUNT(&cpus) > 0 || directoryFD != -1) {
+        return forkLimitedJob(executable.c_str(), argv.data(), outputFD, inputFD, directoryFD, limits, cpus, pid);
+    }
+
+    posix_spawnattr_t attributes;
+    posix_spawn_file_actions_t fileActions;
+    sigset_t signalMask;
+
+    // The job leads its own process group, so that signals reach every process of the job, and
+    // it does not inherit the signal mask of the launcher
+    sigemptyset(&signalMask);
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK);
+    posix_spawnattr_setpgroup(&attributes, 0);
+    posix_spawnattr_setsigmask(&attributes, &signalMask);
+
+    // The child makes the output file its standard output right before the exec()
+    posix_spawn_file_actions_init(&fileActions);
+    posix_spawn_file_actions_adddup2(&fileActions, outputFD, STDOUT_FILENO);
+    if (inputFD != -1) {
+        posix_spawn_file_actions_adddup2(&fileActions, inputFD, STDIN_FILENO);
+    }
+
+    int error = posix_spawn(&pid, executable.c_str(), &fileActions, &attributes, argv.data(), environ);
+
+    posix_spawn_file_actions_destroy(&fileActions);
+    posix_spawnattr_destroy(&attributes);
+
+    return error;
+
+}
+
+/**
+ * @brief The main loop of the launcher process. It launches the jobs it is asked to and
+ * reports every job that finishes, until the server closes its end of the socket pair.
+ * 
+ * @param socketFD the launcher end of the socket pair
+*/
+void Launch::Launcher::runLauncherProcess(const int socketFD) {
+
+    // Finished jobs are noticed through a signal file descriptor, so that a single poll() waits for both events
+    sigset_t childSignal;
+    sigemptyset(&childSignal);
+    sigaddset(&childSignal, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &childSignal, NULL);
+
+    int signalFD = signalfd(-1, &childSignal, SFD_CLOEXEC);
+    if (signalFD == -1) {
+        perror("Error creating launcher signal file descriptor");
+        return;
+    }
+
+    char* buffer = new char[MAX_LAUNCH_REQUEST_SIZE + 1];
+    struct pollfd fds[2] = { { socketFD, POLLIN, 0 }, { signalFD, POLLIN, 0 } };
+
+    while (true) {
+
+        if (poll(fds, 2, -1) == -1) {
+            if (errno == EINTR) continue;
+            perror("Error polling in launcher process");
+            break;
+        }
+
+        // Report every job that has finished
+        if (fds[1].revents & POLLIN) {
+
+            // Signals of several finished jobs may be merged into one, so every finished job is reaped
+            struct signalfd_siginfo info;
+            if (read(signalFD, &info, sizeof(info)) == -1) {
+                perror("Error reading launcher signal file descriptor");
+            }
+
+            // The CPU time of a job tells whether the kernel killed it for its CPU limit
+            int status;
+            pid_t pid;
+            struct rusage usage;
+            while ((pid = wait4(-1, &status, WNOHANG, &usage)) > 0) {
+                unsigned long cpuSeconds = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec;
+                sendReply(socketFD, { JLR_EXITED, 0, pid, status, JLX_DIRECT, cpuSeconds });
+            }
+
+        }
+
+        if (!(fds[0].revents & (POLLIN | POLLHUP))) {
+            continue;
+        }
+
+        // Receive the next request together with the output file descriptor of its job, and its input pipe and working directory if it has them
+        char control[CMSG_SPACE(3 * sizeof(int))];
+        struct iovec io = { buffer, MAX_LAUNCH_REQUEST_SIZE };
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = &io;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        ssize_t received = recvmsg(socketFD, &message, MSG_CMSG_CLOEXEC);
+        if (received <= 0) {
+            break; // The server has closed its end
+        }
+
+        struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+        if (received < (ssize_t)sizeof(Request) || header == NULL || header->cmsg_type != SCM_RIGHTS) {
+            std::cerr << "Launcher received an invalid request" << std::endl;
+            continue;
+        }
+
+        Request request;
+        int descriptors[3] = { -1, -1, -1 };
+        size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        memcpy(&request, buffer, sizeof(request));
+        memcpy(descriptors, CMSG_DATA(header), (count < 3 ? count : 3) * sizeof(int));
+        buffer[received] = '\0';
+
+        // The descriptors the job does not have are left out of the request
+        int inputFD = request.hasInput ? descriptors[1] : -1;
+        int directoryFD = request.hasDirectory ? descriptors[request.hasInput ? 2 : 1] : -1;
+
+        pid_t pid = -1;
+        Launch::ExecutableLookup lookup;
+        int error = Launch::Launcher::spawnJobProcess(std::string(buffer + sizeof(Request)), descriptors[0], inputFD, directoryFD, request.limits, request.cpus, pid, lookup);
+        for (size_t i = 0; i < count && i < 3; i++) {
+            close(descriptors[i]);
+        }
+
+        sendReply(socketFD, { JLR_SPAWNED, request.tag, error == 0 ? pid : -1, error, lookup });
+
+    }
+
+    delete[] buffer;
+    close(signalFD);
+
+}
+
+/**
+ * @brief Reply Thread function of the server. It receives the replies of the launcher
+ * process, wakes up the worker threads waiting for them and reports the exits of the
+ * jobs to the supervisor.
+ * 
+ * @param arg unused
+ * 
+ * @return anything
+*/
+void* Launch::Launcher::ReplyThread(void* arg) {
+
+    Launch::Reply reply;
+
+    while (recv(Launch::Launcher::launcherSocket, &reply, sizeof(reply), 0) == sizeof(reply)) {
+
+        // Exits go to the supervisor of the running jobs
+        if (reply.type == JLR_EXITED) {
+            Supervision::Supervisor::notifyExit(reply.pid, reply.value, reply.cpuSeconds);
+            continue;
+        }
+
+        pthread_mutex_lock(&Server::Process::mutex_launcher);
+        if (reply.lookup == JLX_CACHED) Launch::Launcher::cacheHits++;
+        if (reply.lookup == JLX_RESOLVED) Launch::Launcher::cacheMisses++;
+        Launch::Launcher::spawnedReplies[reply.tag] = reply;
+        pthread_cond_broadcast(&Server::Process::condVar_launcher);
+        pthread_mutex_unlock(&Server::Process::mutex_launcher);
+
+    }
+
+    // The launcher process has gone away, so nobody must keep waiting for it
+    pthread_mutex_lock(&Server::Process::mutex_launcher);
+    Launch::Launcher::launcherAlive = false;
+    pthread_cond_broadcast(&Server::Process::condVar_launcher);
+    pthread_mutex_unlock(&Server::Process::mutex_launcher);
+
+    Supervision::Supervisor::notifyLauncherGone();
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Forks the launcher process and creates the reply thread. It must be called before
+ * any other thread of the server is created.
+ * 
+ * @return true if the launcher was started successfully, false otherwise
+*/
+bool Launch::Launcher::start(void) {
+
+    int sockets[2];
+
+    // A sequenced packet socket keeps every request and reply in a single message
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) == -1) {
+        perror("Error creating launcher socket pair");
+        return false;
+    }
+
+    if ((Launch::Launcher::launcherPID = fork()) == -1) {
+        perror("Error creating launcher process");
+        return false;
+    }
+
+    /* Launcher process code */
+    if (Launch::Launcher::launcherPID == 0) {
+        close(sockets[0]);
+        Launch::Launcher::runLauncherProcess(sockets[1]);
+        _exit(EXIT_SUCCESS);
+    }
+
+    close(sockets[1]);
+    Launch::Launcher::launcherSocket = sockets[0];
+    Launch::Launcher::launcherAlive = true;
+
+    if (pthread_create(&Launch::Launcher::replyThread, NULL, Launch::Launcher::ReplyThread, NULL) != 0) {
+        perror("Error creating launcher reply thread");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops the launcher process and the reply thread.
+*/
+void Launch::Launcher::stop(void) {
+
+    // Closing the server end makes the launcher process exit, which in turn ends the reply thread
+    shutdown(Launch::Launcher::launcherSocket, SHUT_RDWR);
+    pthread_join(Launch::Launcher::replyThread, NULL);
+    close(Launch::Launcher::launcherSocket);
+
+    waitpid(Launch::Launcher::launcherPID, NULL, 0);
+
+}
+
+/**
+ * @brief Launches the given job through the launcher process. Its standard output is
+ * redirected to the given file descriptor, its standard input to the given input pipe
+ * and its working directory to the given directory if it has them, all of which the
+ * caller still has to close.
+ * 
+ * @param job the job string
+ * @param outputFD the file descriptor that becomes the standard output of the job
+ * @param inputFD the file descriptor that becomes the standard input of the job, -1 to keep the inherited one
+ * @param directoryFD the file descriptor of the working directory of the job, -1 to keep the inherited one
+ * @param limits the resource limits of the job
+ * @param cpus the cores the job is placed on, empty if it can run on any core
+ * @param pid the process ID of the new process
+ * 
+ * @return true if the job was launched successfully, false otherwise
+*/
+bool Launch::Launcher::spawnJob(const std::string& job, const int outputFD, const int inputFD, const int directoryFD, const Limits& limits, const cpu_set_t& cpus, pid_t& pid) {
+
+    if (job.size() > MAX_LAUNCH_REQUEST_SIZE - sizeof(Request)) {
+        std::cerr << "Error executing job: command too long" << std::endl;
+        return false;
+    }
+
+    pthread_mutex_lock(&Server::Process::mutex_launcher);
+    Request request = { Launch::Launcher::nextTag++, limits, cpus, inputFD != -1, directoryFD != -1 };
+    pthread_mutex_unlock(&Server::Process::mutex_launcher);
+
+    // Send the request and the job string as a single packet, with the output file descriptor, the input pipe and the working directory attached
+    std::string packet(reinterpret_cast<const char*>(&request), sizeof(request));
+    packet += job;
+
+    int descriptors[3] = { outputFD, -1, -1 };
+    size_t count = 1;
+    if (inputFD != -1) descriptors[count++] = inputFD;
+    if (directoryFD != -1) descriptors[count++] = directoryFD;
+
+    char control[CMSG_SPACE(3 * sizeof(int))];
+    memset(control, 0, sizeof(control));
+    struct iovec io = { (void*)packet.data(), packet.size() };
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = CMSG_SPACE(count * sizeof(int));
+
+    struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(count * sizeof(int));
+    memcpy(CMSG_DATA(header), descriptors, count * sizeof(int));
+
+    ssize_t sent = sendmsg(Launch::Launcher::launcherSocket, &message, MSG_NOSIGNAL);
+
+    if (sent == -1) {
+        perror("Error sending launch request");
+        return false;
+    }
+
+    // Wait for the reply to this request
+    pthread_mutex_lock(&Server::Process::mutex_launcher);
+
+    std::map<unsigned long, Reply>::iterator it;
+    while ((it = Launch::Launcher::spawnedReplies.find(request.tag)) == Launch::Launcher::spawnedReplies.end() && Launch::Launcher::launcherAlive) {
+        pthread_cond_wait(&Server::Process::condVar_launcher, &Server::Process::mutex_launcher);
+    }
+
+    bool found = it != Launch::Launcher::spawnedReplies.end();
+    Reply reply = found ? it->second : Reply { JLR_SPAWNED, request.tag, -1, EPIPE };
+    if (found) {
+        Launch::Launcher::spawnedReplies.erase(it);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_launcher);
+
+    if (reply.pid == -1) {
+        errno = reply.value;
+        perror("Error executing job");
+        return false;
+    }
+
+    pid = reply.pid;
+    return true;
+
+}
+
+/**
+ * @brief Returns how many launches found their executable in the executable cache and how
+ * many had to search $PATH for it.
+ * 
+ * @param hits the launches that found their executable in the cache
+ * @param misses the launches that searched $PATH
+*/
+void Launch::Launcher::getCacheStats(unsigned long& hits, unsigned long& misses) {
+
+    pthread_mutex_lock(&Server::Process::mutex_launcher);
+    hits = Launch::Launcher::cacheHits;
+    misses = Launch::Launcher::cacheMisses;
+    pthread_mutex_unlock(&Server::Process::mutex_launcher);
+
+}
@@ -0,0 +1,138 @@
+/* Filename: jobResults.cpp */
+
+#include "../../include/jobResults.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace JobResults = Application_Job_Executor_Server::Application_Job_Results;
+
+// Initialize the static members
+std::set<std::string> JobResults::Store::pending;
+std::map<std::string, JobResults::JobResult> JobResults::Store::results;
+std::list<std::string> JobResults::Store::recentlyUsed;
+unsigned long JobResults::Store::storedBytes = 0;
+
+/**
+ * @brief Drops the result of the given job. The caller must hold the detached results mutex of the server.
+ *
+ * @param jobID the job ID of the result
+*/
+void JobResults::Store::drop(const std::string& jobID) {
+
+    std::map<std::string, JobResult>::iterator it = JobResults::Store::results.find(jobID);
+    if (it == JobResults::Store::results.end()) {
+        return;
+    }
+
+    JobResults::Store::storedBytes -= it->second.output.size() + it->second.note.size();
+    JobResults::Store::recentlyUsed.erase(it->second.position);
+    JobResults::Store::results.erase(it);
+
+}
+
+/**
+ * @brief Records a detached job that has been submitted, so that its result is known to be on its way.
+ *
+ * @param jobID the job ID of the detached job
+*/
+void JobResults::Store::expect(const std::string& jobID) {
+
+    pthread_mutex_lock(&Server::Process::mutex_detached);
+    JobResults::Store::pending.insert(jobID);
+    pthread_mutex_unlock(&Server::Process::mutex_detached);
+
+}
+
+/**
+ * @brief Keeps the result of a detached job that has finished, dropping the least recently used
+ * results if there is no room for it. A result bigger than the whole budget keeps only its note.
+ *
+ * @param jobID the job ID of the detached job
+ * @param result the result of the job
+*/
+void JobResults::Store::keep(const std::string& jobID, JobResult result) {
+
+    unsigned long budget = Server::Process::getOptions().detachedMemory * 1024 * 1024;
+
+    // The client must still learn how the job ended, even if its output can not be kept
+    if (result.output.size() + result.note.size() > budget) {
+        result.output.clear();
+        result.note += std::string(result.note.empty() ? "" : "\n") + "THE OUTPUT OF THE JOB WAS TOO BIG TO BE KEPT";
+    }
+
+    unsigned long size = result.output.size() + result.note.size();
+
+    pthread_mutex_lock(&Server::Process::mutex_detached);
+
+    JobResults::Store::pending.erase(jobID);
+    JobResults::Store::drop(jobID);
+
+    while (JobResults::Store::storedBytes + size > budget && !JobResults::Store::recentlyUsed.empty()) {
+        JobResults::Store::drop(JobResults::Store::recentlyUsed.back());
+    }
+
+    JobResults::Store::recentlyUsed.push_front(jobID);
+    result.position = JobResults::Store::recentlyUsed.begin();
+    JobResults::Store::storedBytes += size;
+    JobResults::Store::results[jobID] = result;
+
+    pthread_mutex_unlock(&Server::Process::mutex_detached);
+
+}
+
+/**
+ * @brief Keeps the result of a detached job that will never run, if it has not finished yet.
+ *
+ * @param jobID the job ID of the detached job
+ * @param reason why the job did not run
+*/
+void JobResults::Store::discard(const std::string& jobID, const std::string& reason) {
+
+    pthread_mutex_lock(&Server::Process::mutex_detached);
+    bool isPending = JobResults::Store::pending.count(jobID) > 0;
+    pthread_mutex_unlock(&Server::Process::mutex_detached);
+
+    if (isPending) {
+        time_t now = time(NULL);
+        JobResults::Store::keep(jobID, { false, -1, "", reason, now, now, now, {} });
+    }
+
+}
+
+/**
+ * @brief Fetches the result of a detached job. A result that has expired is dropped.
+ *
+ * @param jobID the job ID of the detached job
+ * @param result the result of the job, if it has finished
+ *
+ * @return the state of the result
+*/
+JobResults::ResultState JobResults::Store::fetch(const std::string& jobID, JobResult& result) {
+
+    unsigned long timeToLive = Server::Process::getOptions().detachedTimeToLive;
+    ResultState state = JRS_UNKNOWN;
+
+    pthread_mutex_lock(&Server::Process::mutex_detached);
+
+    std::map<std::string, JobResult>::iterator it = JobResults::Store::results.find(jobID);
+
+    if (it != JobResults::Store::results.end() && timeToLive > 0 && time(NULL) - it->second.finished >= (time_t)timeToLive) {
+        JobResults::Store::drop(jobID);
+        it = JobResults::Store::results.end();
+    }
+
+    if (it != JobResults::Store::results.end()) {
+        result = it->second;
+        JobResults::Store::recentlyUsed.splice(JobResults::Store::recentlyUsed.begin(), JobResults::Store::recentlyUsed, it->second.position);
+        state = JRS_FINISHED;
+    }
+    else if (JobResults::Store::pending.count(jobID) > 0) {
+        state = JRS_PENDING;
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_detached);
+
+    return state;
+
+}
@@ -0,0 +1,692 @@
+/* Filename: jobSupervisor.cpp */
+
+#include <time.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "../../include/jobSupervisor.h"
+#include "../../include/jobExecutorServerProcess.h"
+#include "../../include/resourcePool.h"
+#include "../../include/runningJobsTable.h"
+#include "../../include/pluginJobs.h"
+#include "../../include/outputStreamer.h"
+#include "../../include/outputCapture.h"
+#include "../../include/cpuPlacement.h"
+#include "../../include/resultCache.h"
+#include "../../include/jobCoalescing.h"
+#include "../../include/jobResults.h"
+#include "../../include/completionEvents.h"
+#include "../../include/outputReducers.h"
+#include "../../include/lzCodec.h"
+#include "../../include/outputSender.h"
+#include "../../include/blobStore.h"
+
+#define KNRM  "\x1B[0m"
+#define KRED  "\x1B[31m"
+#define KGRN  "\x1B[32m"
+#define KYEL  "\x1B[33m"
+#define KBLU  "\x1B[34m"
+#define KMAG  "\x1B[35m"
+#define KCYN  "\x1B[36m"
+#define KWHT  "\x1B[37m"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Supervision = Application_Job_Executor_Server::Application_Job_Supervisor;
+namespace Resources = Application_Job_Executor_Server::Application_Resource_Pool;
+namespace RunningJobs = Application_Job_Executor_Server::Application_Running_Jobs;
+namespace Plugins = Application_Job_Executor_Server::Application_Plugin_Jobs;
+namespace Streaming = Application_Job_Executor_Server::Application_Output_Streamer;
+namespace Capturing = Application_Job_Executor_Server::Application_Output_Capture;
+namespace Launch = Application_Job_Executor_Server::Application_Job_Launcher;
+namespace Placement = Application_Job_Executor_Server::Application_Cpu_Placement;
+namespace Results = Application_Job_Executor_Server::Application_Result_Cache;
+namespace Blobs = Application_Job_Executor_Server::Application_Blob_Store;
+namespace Coalescing = Application_Job_Executor_Server::Application_Job_Coalescing;
+namespace JobResults = Application_Job_Executor_Server::Application_Job_Results;
+namespace Events = Application_Job_Executor_Server::Application_Completion_Events;
+namespace Reducers = Application_Job_Executor_Server::Application_Output_Reducers;
+namespace Lz = Application_Job_Commander_Client::Application_Lz_Codec;
+namespace Sending = Application_Job_Executor_Server::Application_Output_Sender;
+
+// Initialize the static members
+std::map<pid_t, Supervision::SupervisedJob> Supervision::Supervisor::jobs;
+std::vector<Supervision::JobExit> Supervision::Supervisor::exits;
+std::map<std::string, Supervision::JobLimit> Supervision::Supervisor::enforced;
+bool Supervision::Supervisor::launcherGone = false;
+bool Supervision::Supervisor::stopping = false;
+pthread_t Supervision::Supervisor::supervisorThread;
+
+/**
+ * @brief Supporting function that returns the name of a resource limit, as it is shown to the clients.
+ * 
+ * @param limit the resource limit
+ * 
+ * @return the name of the limit
+*/
+static const char* getLimitName(const Supervision::JobLimit limit) {
+
+    switch (limit) {
+        case Supervision::JL_WALL_TIME: return "WALL TIME";
+        case Supervision::JL_CPU_TIME: return "CPU TIME";
+        case Supervision::JL_MEMORY: return "MEMORY";
+        case Supervision::JL_OUTPUT: return "OUTPUT";
+        case Supervision::JL_CANCELED: return "STOPPED";
+        default: return "NONE";
+    }
+
+}
+
+/**
+ * @brief Supporting function that finds out which of the limits the kernel enforces a job that
+ * has exited was stopped by, from the way it ended. The limits the supervisor enforces itself are
+ * recorded when it stops the job instead.
+ * 
+ * @param job the supervised job
+ * @param exit the exit of the job
+ * 
+ * @return the limit the job was stopped by
+*/
+static Supervision::JobLimit getLimitHit(const Supervision::SupervisedJob& job, const Supervision::JobExit& exit) {
+
+    if (!WIFSIGNALED(exit.status)) {
+        return Supervision::JL_NONE;
+    }
+
+    // The kernel signals a job that reaches its CPU limit, and kills it if it keeps going, so a killed job was
+    // stopped by its CPU limit only if it used up its CPU time. A job that runs out of address space usually
+    // crashes on the allocation that failed
+    switch (WTERMSIG(exit.status)) {
+        case SIGXCPU: return Supervision::JL_CPU_TIME;
+        case SIGKILL: return job.limits.cpuSeconds > 0 && exit.cpuSeconds >= job.limits.cpuSeconds ? Supervision::JL_CPU_TIME : Supervision::JL_NONE;
+        case SIGSEGV:
+        case SIGBUS:
+        case SIGABRT: return job.limits.addressSpace > 0 ? Supervision::JL_MEMORY : Supervision::JL_NONE;
+        default: return Supervision::JL_NONE;
+    }
+
+}
+
+/**
+ * @brief Supporting function that returns the note a client gets after the output of a job that was
+ * stopped by a resource limit or by a client, or an empty string if the job was not stopped.
+ * 
+ * @param jobID the ID of the job
+ * @param limitHit the resource limit the job was stopped by
+ * 
+ * @return the note of the job
+*/
+static std::string getLimitNote(const std::string& jobID, const Supervision::JobLimit limitHit) {
+
+    if (limitHit == Supervision::JL_CANCELED) {
+        return "JOB " + jobID + " WAS STOPPED WHILE RUNNING";
+    }
+    if (limitHit != Supervision::JL_NONE) {
+        return "JOB " + jobID + " EXCEEDED ITS " + std::string(getLimitName(limitHit)) + " LIMIT";
+    }
+
+    return "";
+
+}
+
+/**
+ * @brief Supporting function that sends the output of a job back to its client. The output is
+ * sent as a single response, with an extra text at its beginning and at its end, straight from
+ * where it lies in memory. A job stopped by a resource limit or by a client gets a note after the end.
+ * A response that reaches the compression threshold of the server is sent compressed instead, if
+ * the client can decompress it and it gets any smaller. The response is handed to the sender, so
+ * a slow client does not hold back the thread that finished the job.
+ * 
+ * @param clientSocket the socket of the client
+ * @param jobID the ID of the job
+ * @param limitHit the resource limit the job was stopped by
+ * @param output the output of the job
+ * @param outputSize the size of the output
+ * @param compress whether the client can decompress the response
+*/
+static void sendJobOutputToClient(const int clientSocket, const std::string& jobID, const Supervision::JobLimit limitHit, const char* output, const ssize_t outputSize, const bool compress) {
+
+    // Add the extra string at the start and at the end
+    std::string startingText = "-----" + jobID + " output start------\n";
+    std::string endingText = "\n-----" + jobID + " output end------";
+    std::string note = getLimitNote(jobID, limitHit);
+
+    if (!note.empty()) {
+        endingText += "\n" + note;
+    }
+
+    ssize_t responseSize = startingText.size() + outputSize + endingText.size();
+
+    struct iovec parts[4];
+    parts[0] = { (void*)&responseSize, sizeof(ssize_t) };
+    parts[1] = { (void*)startingText.data(), startingText.size() };
+    parts[2] = { (void*)output, (size_t)outputSize };
+    parts[3] = { (void*)endingText.data(), endingText.size() };
+    int partCount = 4;
+
+    // The compressor needs the response in one piece, which is only worth building for a big enough response
+    unsigned long threshold = Server::Process::getOptions().compressThreshold;
+    std::string packed;
+
+    if (compress && threshold > 0 && (unsigned long)responseSize >= threshold) {
+
+        std::string response = startingText;
+        response.append(output, outputSize);
+        response += endingText;
+
+        if (Lz::Codec::pack(response, packed)) {
+            responseSize = packed.size();
+            parts[1] = { (void*)packed.data(), packed.size() };
+            partCount = 2;
+        }
+
+    }
+
+    // Send the size of the response, and then the actual response back to the client. The tasks of a job
+    // array share the same client, so the sender keeps the responses of a client whole and in order
+    Sending::Sender::send(clientSocket, parts, partCount);
+
+}
+
+/**
+ * @brief Supporting function that hands the output of a job that has finished to its client. A
+ * detached job has no client waiting, so its output, its exit code and its timings are kept in the
+ * store of the detached results instead, until its client fetches them. Either way, only what is
+ * left of the output after the reducers of the job is handed over.
+ * 
+ * @param triplate the triplate of the job
+ * @param limitHit the resource limit the job was stopped by
+ * @param exitCode the exit code of the job, or -1 if it is unknown
+ * @param startTime the time the job started running at
+ * @param output the output of the job
+ * @param outputSize the size of the output
+*/
+static void deliverJobOutput(const CC::JobTriplate& triplate, const Supervision::JobLimit limitHit, const int exitCode, const time_t startTime, const char* output, ssize_t outputSize) {
+
+    // The reducers are applied for every client on its own, as the jobs sharing an output may reduce it differently
+    std::string reduced;
+    if (Reducers::Reducer::isEnabled(triplate.options)) {
+        Reducers::Reducer::reduce(triplate.options, output, outputSize, reduced);
+        output = reduced.data();
+        outputSize = reduced.size();
+    }
+
+    if (!triplate.options.detach) {
+        sendJobOutputToClient(triplate.socketID, triplate.jobID, limitHit, output, outputSize, triplate.options.compress);
+        return;
+    }
+
+    JobResults::Store::keep(triplate.jobID, { true, exitCode, std::string(output, outputSize), getLimitNote(triplate.jobID, limitHit), triplate.submitTime, startTime, time(NULL), {} });
+
+}
+
+/**
+ * @brief Supporting function that finishes a supervised job that has exited. It maps the captured
+ * output of the job, finishes the job and releases the output. A streamed job has no captured output.
+ * 
+ * @param job the supervised job
+ * @param succeeded whether the job finished successfully
+*/
+static void finishSupervisedJob(const Supervision::SupervisedJob& job, const bool succeeded) {
+
+    // The output of a streamed job has already been sent by the streamer
+    if (job.output.fd == -1) {
+        Supervision::Supervisor::finishJob(job.triplate, succeeded, job.limitHit, job.exitCode, nullptr, 0);
+        return;
+    }
+
+    ssize_t contentsSize = 0;
+    const char* contents = Capturing::Capture::map(job.output, contentsSize);
+
+    // The job may have written a bit more before it was stopped, but only the output within its limit is sent
+    ssize_t outputSize = contents != nullptr ? contentsSize : 0;
+    if (job.limits.outputBytes > 0 && outputSize > (ssize_t)job.limits.outputBytes) {
+        outputSize = job.limits.outputBytes;
+    }
+
+    Supervision::Supervisor::finishJob(job.triplate, succeeded, job.limitHit, job.exitCode, contents != nullptr ? contents : "", outputSize);
+
+    Capturing::Capture::close(job.output, contents, contentsSize);
+
+}
+
+/**
+ * @brief Supervisor Thread function. It finishes the supervised jobs as their exits are
+ * reported, until the supervisor is stopped.
+ * 
+ * @param arg unused
+ * 
+ * @return anything
+*/
+void* Supervision::Supervisor::SupervisorThread(void* arg) {
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+
+    while (!Supervision::Supervisor::stopping) {
+
+        std::vector<std::pair<Supervision::SupervisedJob, bool>> finished;
+
+        // Take every reported exit of a watched job. An exit may be reported before its job is watched, so it is kept until then
+        for (unsigned int i = 0; i < Supervision::Supervisor::exits.size(); ) {
+
+            std::map<pid_t, Supervision::SupervisedJob>::iterator it = Supervision::Supervisor::jobs.find(Supervision::Supervisor::exits[i].pid);
+
+            if (it == Supervision::Supervisor::jobs.end()) {
+                i++;
+                continue;
+            }
+
+            // A limit the supervisor stopped the job for is known for sure, the rest are found from the exit
+            int status = Supervision::Supervisor::exits[i].status;
+            std::map<std::string, JobLimit>::iterator limit = Supervision::Supervisor::enforced.find(it->second.triplate.jobID);
+            if (limit != Supervision::Supervisor::enforced.end()) {
+                it->second.limitHit = limit->second;
+                Supervision::Supervisor::enforced.erase(limit);
+            } else {
+                it->second.limitHit = getLimitHit(it->second, Supervision::Supervisor::exits[i]);
+            }
+            it->second.exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+            finished.push_back({ it->second, WIFEXITED(status) && WEXITSTATUS(status) == 0 && it->second.limitHit == JL_NONE });
+
+            Supervision::Supervisor::jobs.erase(it);
+            Supervision::Supervisor::exits.erase(Supervision::Supervisor::exits.begin() + i);
+
+        }
+
+        // Without the launcher no exit will ever be reported, so every watched job has failed
+        if (Supervision::Supervisor::launcherGone) {
+            for (auto& job : Supervision::Supervisor::jobs) {
+                finished.push_back({ job.second, false });
+            }
+            Supervision::Supervisor::jobs.clear();
+        }
+
+        if (finished.empty()) {
+            pthread_cond_wait(&Server::Process::condVar_supervisor, &Server::Process::mutex_supervisor);
+            continue;
+        }
+
+        // Finish the jobs without holding the mutex, so that workers can keep handing over jobs
+        pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+        for (unsigned int i = 0; i < finished.size(); i++) {
+            finishSupervisedJob(finished[i].first, finished[i].second);
+        }
+
+        pthread_mutex_lock(&Server::Process::mutex_supervisor);
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Creates the supervisor thread.
+ * 
+ * @return true if the supervisor was started successfully, false otherwise
+*/
+bool Supervision::Supervisor::start(void) {
+
+    if (pthread_create(&Supervision::Supervisor::supervisorThread, NULL, Supervision::Supervisor::SupervisorThread, NULL) != 0) {
+        perror("Error creating supervisor thread");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops the supervisor thread. It must be called only when no job runs.
+*/
+void Supervision::Supervisor::stop(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+    Supervision::Supervisor::stopping = true;
+    pthread_cond_signal(&Server::Process::condVar_supervisor);
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+    pthread_join(Supervision::Supervisor::supervisorThread, NULL);
+
+}
+
+/**
+ * @brief Starts supervising a job that has been launched.
+ * 
+ * @param pid the process ID of the job
+ * @param triplate the triplate of the job
+ * @param output the captured output of the job, with a file descriptor of -1 if it is streamed
+ * @param limits the resource limits of the job
+*/
+void Supervision::Supervisor::watch(const pid_t pid, const CC::JobTriplate& triplate, const Capturing::CapturedOutput& output, const Launch::Limits& limits) {
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += limits.wallSeconds;
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+    Supervision::Supervisor::jobs[pid] = { triplate, output, limits, deadline, false, { 0, 0 }, JL_NONE, -1 };
+    pthread_cond_signal(&Server::Process::condVar_supervisor);
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+}
+
+/**
+ * @brief Kills every supervised job that has run past the deadline of its wall time limit or
+ * whose captured output has grown past its output limit, and every canceled job that has
+ * outlived its grace period. It is called on every tick of the timer thread.
+*/
+void Supervision::Supervisor::checkDeadlines(void) {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+
+    for (std::map<pid_t, Supervision::SupervisedJob>::iterator it = Supervision::Supervisor::jobs.begin(); it != Supervision::Supervisor::jobs.end(); it++) {
+
+        Supervision::SupervisedJob& job = it->second;
+
+        if (Supervision::Supervisor::enforced.find(job.triplate.jobID) != Supervision::Supervisor::enforced.end()) {
+            continue;
+        }
+
+        // The captured output of a job is a file the job writes to directly, so its size is checked here
+        struct stat output;
+        JobLimit limit = JL_NONE;
+
+        if (job.limits.wallSeconds > 0 && !job.suspended && (now.tv_sec > job.deadline.tv_sec || (now.tv_sec == job.deadline.tv_sec && now.tv_nsec >= job.deadline.tv_nsec))) {
+            limit = JL_WALL_TIME;
+        }
+        else if (job.limits.outputBytes > 0 && job.output.fd != -1 && fstat(job.output.fd, &output) != -1 && (unsigned long)output.st_size > job.limits.outputBytes) {
+            limit = JL_OUTPUT;
+        }
+
+        if (limit == JL_NONE) {
+            continue;
+        }
+
+        // A job whose exit is already reported has been reaped, so its process group may not exist anymore
+        bool exited = false;
+        for (unsigned int i = 0; i < Supervision::Supervisor::exits.size() && !exited; i++) {
+            exited = Supervision::Supervisor::exits[i].pid == it->first;
+        }
+        if (exited) {
+            continue;
+        }
+
+        // The job leads its own process group, so every process of the job is killed, even a suspended one
+        kill(-it->first, SIGKILL);
+        Supervision::Supervisor::enforced[job.triplate.jobID] = limit;
+
+        if (limit == JL_WALL_TIME) {
+            std::cout << "---[" << KRED << "Job  Timeout" << KWHT << "]--- | ";
+            std::cout << "Job ID: " << "[" << KGRN << job.triplate.jobID << KWHT << "]" << " | ";
+            std::cout << "Timeout: " << "[" << KYEL << job.limits.wallSeconds << " sec" << KWHT << "]" << std::endl;
+        } else {
+            std::cout << "---[" << KRED << "Output  Limit" << KWHT << "]--- | ";
+            std::cout << "Job ID: " << "[" << KGRN << job.triplate.jobID << KWHT << "]" << " | ";
+            std::cout << "Limit: " << "[" << KYEL << job.limits.outputBytes << " bytes" << KWHT << "]" << std::endl;
+        }
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+    // Canceled jobs that ignore SIGTERM for longer than the grace period are killed
+    std::vector<pid_t> overdue;
+
+    pthread_mutex_lock(&Server::Process::mutex_worker);
+    RunningJobs::Table::takeOverdueCanceledJobs(now, overdue);
+    pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+    for (unsigned int i = 0; i < overdue.size(); i++) {
+        kill(-overdue[i], SIGKILL);
+    }
+
+}
+
+/**
+ * @brief Stops or restarts the wall time of a job while the scheduler suspends it, so
+ * that the time it spends suspended does not count towards its wall time limit.
+ * 
+ * @param pid the process ID of the job
+ * @param suspended whether the job is suspended or resumed
+*/
+void Supervision::Supervisor::setSuspended(const pid_t pid, const bool suspended) {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+
+    std::map<pid_t, Supervision::SupervisedJob>::iterator it = Supervision::Supervisor::jobs.find(pid);
+
+    if (it != Supervision::Supervisor::jobs.end() && it->second.suspended != suspended) {
+
+        Supervision::SupervisedJob& job = it->second;
+        job.suspended = suspended;
+
+        // The deadline moves forward by the time the job was suspended for
+        if (suspended) {
+            job.suspendedAt = now;
+        } else {
+            job.deadline.tv_sec += now.tv_sec - job.suspendedAt.tv_sec;
+            job.deadline.tv_nsec += now.tv_nsec - job.suspendedAt.tv_nsec;
+            if (job.deadline.tv_nsec < 0) {
+                job.deadline.tv_sec--;
+                job.deadline.tv_nsec += 1000000000L;
+            } else if (job.deadline.tv_nsec >= 1000000000L) {
+                job.deadline.tv_sec++;
+                job.deadline.tv_nsec -= 1000000000L;
+            }
+        }
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+}
+
+/**
+ * @brief Kills a job for going past one of its limits, and records the limit so that it is
+ * reported when the job exits. It may be called before the job is watched.
+ * 
+ * @param processGroup the process group of the job
+ * @param jobID the job ID of the job
+ * @param limit the limit the job went past
+*/
+void Supervision::Supervisor::enforceLimit(const pid_t processGroup, const std::string& jobID, const JobLimit limit) {
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+    Supervision::Supervisor::enforced.insert({ jobID, limit });
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+    kill(-processGroup, SIGKILL);
+
+}
+
+/**
+ * @brief Returns the resource limits of the given job. A limit that is not given to the
+ * job gets the default of the server.
+ * 
+ * @param triplate the triplate of the job
+ * 
+ * @return the resource limits of the job
+*/
+Launch::Limits Supervision::Supervisor::getJobLimits(const CC::JobTriplate& triplate) {
+
+    const Server::Options& options = Server::Process::getOptions();
+    Launch::Limits limits;
+
+    limits.wallSeconds = triplate.options.wallLimit > 0 ? triplate.options.wallLimit : options.jobWallLimit;
+    limits.cpuSeconds = triplate.options.cpuLimit > 0 ? triplate.options.cpuLimit : options.jobCpuLimit;
+    limits.addressSpace = triplate.options.memoryLimit > 0 ? triplate.options.memoryLimit : options.jobMemoryLimit;
+    limits.outputBytes = triplate.options.outputLimit > 0 ? triplate.options.outputLimit : options.jobOutputLimit;
+
+    return limits;
+
+}
+
+/**
+ * @brief Reports that a job has exited. The exit may be reported before the job is watched.
+ * 
+ * @param pid the process ID of the job
+ * @param status the wait status of the job
+ * @param cpuSeconds the CPU seconds the job used
+*/
+void Supervision::Supervisor::notifyExit(const pid_t pid, const int status, const unsigned long cpuSeconds) {
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+    Supervision::Supervisor::exits.push_back({ pid, status, cpuSeconds });
+    pthread_cond_signal(&Server::Process::condVar_supervisor);
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+}
+
+/**
+ * @brief Reports that the launcher process has gone away, so no more exits will be reported
+ * and every supervised job is finished as failed.
+*/
+void Supervision::Supervisor::notifyLauncherGone(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_supervisor);
+    Supervision::Supervisor::launcherGone = true;
+    pthread_cond_signal(&Server::Process::condVar_supervisor);
+    pthread_mutex_unlock(&Server::Process::mutex_supervisor);
+
+}
+
+/**
+ * @brief Finishes a job. It sends the output of the job to its client, gives back its slot,
+ * its resources and its blobs and releases or cancels the jobs depending on it. The output of a cacheable
+ * job that succeeded is stored in the result cache, and the output of a coalescing job is sent
+ * to the identical jobs waiting for it as well, which end the same way. The output of a detached
+ * job is kept until its client fetches it, instead. The end of every job is published to the
+ * clients that watch it.
+ * 
+ * @param triplate the triplate of the job
+ * @param succeeded whether the job finished successfully
+ * @param limitHit the resource limit the job was stopped by
+ * @param exitCode the exit code of the job, or -1 if it is unknown
+ * @param output the output of the job, or nullptr if it has already been streamed
+ * @param outputSize the size of the output
+*/
+void Supervision::Supervisor::finishJob(const CC::JobTriplate& triplate, const bool succeeded, const JobLimit limitHit, const int exitCode, const char* output, const ssize_t outputSize) {
+
+    // Give back the slot and the resources of the job and let the workers check if a job fits now.
+    // A job that ended while suspended or canceled has already given back its slot and its CPUs
+    pthread_mutex_lock(&Server::Process::mutex_worker);
+    RunningJobs::RunningJob job;
+    bool canceled = false;
+    time_t startTime = time(NULL);
+    if (Plugins::Registry::isPluginJob(triplate.job)) {
+        Plugins::Registry::releaseSlot();
+    } else {
+        bool found = RunningJobs::Table::remove(triplate.jobID, job);
+        if (!found || (!job.suspended && !job.canceled)) {
+            Server::Process::decreaseRunningJobs();
+            Resources::Pool::release(triplate.options.cpus, 0);
+            Placement::Engine::release(job.cores);
+        }
+        Resources::Pool::release(0, triplate.options.memory);
+        canceled = found && job.canceled;
+        if (found) startTime = job.startTime;
+    }
+    pthread_cond_broadcast(&Server::Process::condVar_worker);
+    pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+    // The working directory of a job with blobs goes away with it, and its blobs can be evicted again
+    if (!triplate.options.blobs.empty()) {
+        Blobs::Store::release(triplate.jobID);
+    }
+
+    // A canceled job has been stopped by a client, whatever the way it ended
+    JobLimit endReason = canceled ? JL_CANCELED : limitHit;
+
+    std::cout << "---[ " << KGRN << "Job  Termination" << KWHT << " ]---" << " | ";
+    if (succeeded && !canceled) {
+        std::cout << KGRN << triplate.jobID << " was successfully executed!" << KWHT << std::endl;
+    } else if (endReason != JL_NONE) {
+        std::cout << KRED << triplate.jobID << " has failed!" << KWHT << " | " << "Limit: " << "[" << KYEL << getLimitName(endReason) << KWHT << "]" << std::endl;
+    } else {
+        std::cout << KRED << triplate.jobID << " has failed!" << KWHT << std::endl;
+    }
+
+    // Only a complete output of a successful run can stand in for the next run. It is stored before it
+    // is sent, so that the client can issue the same job again as soon as it gets the output
+    if (triplate.options.cacheable && succeeded && endReason == JL_NONE && output != nullptr) {
+        Results::Cache::store(triplate.job, triplate.options.cacheInputs, startTime, output, outputSize);
+    }
+
+    // Build the output response and send it back to the client, unless it has already been streamed
+    if (output != nullptr && triplate.options.streamOutput) {
+        Streaming::Streamer::sendWholeOutput(triplate.socketID, triplate.jobID, output, outputSize);
+    }
+    else if (output != nullptr) {
+        deliverJobOutput(triplate, endReason, exitCode, startTime, output, outputSize);
+    }
+
+    Server::Process::completeJob(triplate.jobID, succeeded && !canceled);
+
+    // The watching clients learn how the job ended, once its end has been recorded
+    time_t runtime = time(NULL) - startTime;
+    ssize_t eventOutputSize = output != nullptr ? outputSize : -1;
+    Events::Publisher::publish({ triplate.jobID, triplate.options.tag, true, succeeded && !canceled, exitCode, runtime, eventOutputSize });
+
+    // The identical jobs attached to a coalescing job get its output under their own job IDs
+    std::vector<CC::JobTriplate> waiters;
+    if (triplate.options.coalesce) {
+        Coalescing::Coalescer::detach(triplate, waiters);
+    }
+
+    for (unsigned int i = 0; i < waiters.size(); i++) {
+
+        std::cout << "---[ " << KGRN << "Job  Termination" << KWHT << " ]---" << " | ";
+        std::cout << (succeeded && !canceled ? KGRN : KRED) << waiters[i].jobID << " shared the output of " << triplate.jobID << KWHT << std::endl;
+
+        if (output != nullptr) {
+            deliverJobOutput(waiters[i], endReason, exitCode, startTime, output, outputSize);
+        }
+
+        Server::Process::completeJob(waiters[i].jobID, succeeded && !canceled);
+        Events::Publisher::publish({ waiters[i].jobID, waiters[i].options.tag, true, succeeded && !canceled, exitCode, runtime, eventOutputSize });
+
+    }
+
+    pthread_mutex_lock(&Server::Process::mutex_allJobsDone);
+    pthread_cond_signal(&Server::Process::condVar_allJobsDone);
+    pthread_mutex_unlock(&Server::Process::mutex_allJobsDone);
+
+}
+
+/**
+ * @brief Finishes a cacheable job whose output was found in the result cache, without running it.
+ * It sends the cached output to its client, or keeps it for a detached job, and releases the jobs
+ * depending on it.
+ * 
+ * @param triplate the triplate of the job
+ * @param output the cached output of the job
+*/
+void Supervision::Supervisor::finishCachedJob(const CC::JobTriplate& triplate, const std::string& output) {
+
+    std::cout << "---[ " << KGRN << "Job  Termination" << KWHT << " ]---" << " | ";
+    std::cout << KGRN << triplate.jobID << " was served from the result cache!" << KWHT << std::endl;
+
+    deliverJobOutput(triplate, JL_NONE, 0, time(NULL), output.data(), output.size());
+
+    Server::Process::completeJob(triplate.jobID, true);
+    Events::Publisher::publish({ triplate.jobID, triplate.options.tag, true, true, 0, 0, (ssize_t)output.size() });
+
+    pthread_mutex_lock(&Server::Process::mutex_allJobsDone);
+    pthread_cond_signal(&Server::Process::condVar_allJobsDone);
+    pthread_mutex_unlock(&Server::Process::mutex_allJobsDone);
+
+}
@@ -0,0 +1,153 @@
+/* Filename: outputCapture.cpp */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../../include/outputCapture.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Capturing = Application_Job_Executor_Server::Application_Output_Capture;
+
+// Initialize the static members
+std::set<int> Capturing::Capture::memoryOutputs;
+
+/**
+ * @brief Returns the number of bytes the outputs kept in memory take at the moment.
+ * The caller must hold the outputs mutex of the server.
+ *
+ * @return the bytes of the outputs in memory
+*/
+unsigned long Capturing::Capture::getMemoryInUse(void) {
+
+    unsigned long memoryInUse = 0;
+    struct stat st;
+
+    // The outputs keep growing while their jobs run, so their current sizes are asked every time
+    for (int fd : Capturing::Capture::memoryOutputs) {
+        if (fstat(fd, &st) == 0) {
+            memoryInUse += st.st_size;
+        }
+    }
+
+    return memoryInUse;
+
+}
+
+/**
+ * @brief Creates the file that captures the output of a job. It is kept in memory if the
+ * output memory budget of the server allows it, otherwise it is a file on disk.
+ *
+ * @param jobID the ID of the job
+ * @param output the captured output that was created
+ *
+ * @return true if the output file was created successfully, false otherwise
+*/
+bool Capturing::Capture::open(const std::string& jobID, CapturedOutput& output) {
+
+    unsigned long budget = Server::Process::getOptions().outputMemory * 1024 * 1024;
+
+    pthread_mutex_lock(&Server::Process::mutex_outputs);
+
+    if (budget > 0 && Capturing::Capture::getMemoryInUse() < budget) {
+
+        output.fd = memfd_create(jobID.c_str(), MFD_CLOEXEC);
+        output.filePath.clear();
+
+        if (output.fd != -1) {
+            Capturing::Capture::memoryOutputs.insert(output.fd);
+            pthread_mutex_unlock(&Server::Process::mutex_outputs);
+            return true;
+        }
+
+        perror("Error creating output in memory");
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_outputs);
+
+    // There is no room in memory, so the output is written to the temporary directory
+    if (mkdir(OUTPUT_DIRECTORY, 0777) == -1) {
+        if (errno != EEXIST) {
+            perror("Error creating temporary directory");
+            return false;
+        }
+    }
+
+    output.filePath = std::string(OUTPUT_DIRECTORY) + "/" + jobID + ".output";
+    output.fd = ::open(output.filePath.c_str(), O_CREAT | O_RDWR | O_TRUNC | O_CLOEXEC, 0777);
+
+    if (output.fd == -1) {
+        perror("Failed to create output file");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Maps the captured output of a job that has ended in the memory of the server.
+ *
+ * @param output the captured output
+ * @param size the size of the output
+ *
+ * @return the contents of the output, an empty string if there are none, nullptr if an error occurred
+*/
+const char* Capturing::Capture::map(const CapturedOutput& output, ssize_t& size) {
+
+    struct stat st;
+    if (fstat(output.fd, &st) == -1) {
+        perror("Error getting output size");
+        return nullptr;
+    }
+
+    // An empty file can not be mapped
+    size = st.st_size;
+    if (size == 0) {
+        return "";
+    }
+
+    void* contents = mmap(NULL, size, PROT_READ, MAP_PRIVATE, output.fd, 0);
+    if (contents == MAP_FAILED) {
+        perror("Error mapping output");
+        return nullptr;
+    }
+
+    return (const char*)contents;
+
+}
+
+/**
+ * @brief Releases the captured output of a job. It unmaps and closes the output file, and
+ * deletes it if it is on disk.
+ *
+ * @param output the captured output
+ * @param contents the contents returned by map(), or nullptr if it was not mapped
+ * @param size the size of the output
+*/
+void Capturing::Capture::close(const CapturedOutput& output, const char* contents, const ssize_t size) {
+
+    if (contents != nullptr && size > 0) {
+        munmap((void*)contents, size);
+    }
+
+    // Forget the output before its file descriptor can be reused
+    if (output.filePath.empty()) {
+        pthread_mutex_lock(&Server::Process::mutex_outputs);
+        Capturing::Capture::memoryOutputs.erase(output.fd);
+        pthread_mutex_unlock(&Server::Process::mutex_outputs);
+    }
+
+    ::close(output.fd);
+
+    // Delete the temporary output file of the job
+    if (!output.filePath.empty() && unlink(output.filePath.c_str()) != 0) {
+        perror("Error deleting temporary output file");
+    }
+
+}
@@ -0,0 +1,157 @@
+/* Filename: outputReducers.cpp */
+
+#include <string.h>
+#include <regex.h>
+#include "../../include/outputReducers.h"
+
+/* namespace alias */
+namespace Reducers = Application_Job_Executor_Server::Application_Output_Reducers;
+
+/**
+ * @brief Supporting function that returns the end of the line that starts at the given position,
+ * right after its newline, or the end of the output if it is the last line without a newline.
+ *
+ * @param output the output
+ * @param outputSize the size of the output
+ * @param start the position the line starts at
+ *
+ * @return the end of the line
+*/
+static ssize_t getLineEnd(const char* output, const ssize_t outputSize, const ssize_t start) {
+
+    const char* newline = (const char*)memchr(output + start, '\n', outputSize - start);
+    return newline != nullptr ? newline - output + 1 : outputSize;
+
+}
+
+/**
+ * @brief Supporting function that keeps the lines of an output that contain a fixed string or match
+ * a regular expression.
+ *
+ * @param options the options of the job
+ * @param output the output of the job
+ * @param outputSize the size of the output
+ * @param filtered the lines that were kept
+*/
+static void filterLines(const CC::JobOptions& options, const char* output, const ssize_t outputSize, std::string& filtered) {
+
+    regex_t expression;
+    bool useRegex = options.filterIsRegex;
+
+    if (useRegex && regcomp(&expression, options.lineFilter.c_str(), REG_EXTENDED | REG_NOSUB) != 0) {
+        return;
+    }
+
+    std::string line;
+
+    for (ssize_t start = 0; start < outputSize; ) {
+
+        ssize_t end = getLineEnd(output, outputSize, start);
+        ssize_t length = end - start - (output[end - 1] == '\n' ? 1 : 0);
+        bool keep;
+
+        // The regular expression needs the line on its own, the fixed string is searched in place
+        if (useRegex) {
+            line.assign(output + start, length);
+            keep = regexec(&expression, line.c_str(), 0, NULL, 0) == 0;
+        } else {
+            keep = memmem(output + start, length, options.lineFilter.data(), options.lineFilter.size()) != nullptr;
+        }
+
+        if (keep) {
+            filtered.append(output + start, end - start);
+        }
+
+        start = end;
+
+    }
+
+    if (useRegex) {
+        regfree(&expression);
+    }
+
+}
+
+/**
+ * @brief Returns whether the given job was issued with any output reducer.
+ *
+ * @param options the options of the job
+ *
+ * @return true if the output of the job is reduced, false otherwise
+*/
+bool Reducers::Reducer::isEnabled(const CC::JobOptions& options) {
+
+    return options.headLines > 0 || options.tailLines > 0 || !options.lineFilter.empty() || options.maxBytes > 0;
+
+}
+
+/**
+ * @brief Returns whether the output reducers of the given job can be applied. The head and the
+ * tail can not be combined, and the regular expression of the filter must be valid.
+ *
+ * @param options the options of the job
+ *
+ * @return true if the reducers are valid, false otherwise
+*/
+bool Reducers::Reducer::isValid(const CC::JobOptions& options) {
+
+    if (options.headLines > 0 && options.tailLines > 0) {
+        return false;
+    }
+
+    if (options.filterIsRegex) {
+        regex_t expression;
+        if (regcomp(&expression, options.lineFilter.c_str(), REG_EXTENDED | REG_NOSUB) != 0) {
+            return false;
+        }
+        regfree(&expression);
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Applies the output reducers of a job to its output.
+ *
+ * @param options the options of the job
+ * @param output the output of the job
+ * @param outputSize the size of the output
+ * @param reduced the reduced output
+*/
+void Reducers::Reducer::reduce(const CC::JobOptions& options, const char* output, const ssize_t outputSize, std::string& reduced) {
+
+    // The filter is the only reducer that may keep lines from all over the output, so it is the only one that copies them
+    std::string filtered;
+    if (!options.lineFilter.empty()) {
+        filterLines(options, output, outputSize, filtered);
+        output = filtered.data();
+    }
+    ssize_t size = !options.lineFilter.empty() ? (ssize_t)filtered.size() : outputSize;
+
+    ssize_t start = 0, end = size;
+
+    if (options.headLines > 0) {
+        end = 0;
+        for (unsigned long i = 0; i < options.headLines && end < size; i++) {
+            end = getLineEnd(output, size, end);
+        }
+    }
+
+    // The tail walks back from the end, where a final newline does not start a new line
+    if (options.tailLines > 0) {
+        start = size;
+        unsigned long lines = 0;
+        for (ssize_t i = size - 1; i >= 0; i--) {
+            if (output[i] == '\n' && i != size - 1 && ++lines == options.tailLines) break;
+            start = i;
+        }
+    }
+
+    if (options.maxBytes > 0 && (unsigned long)(end - start) > options.maxBytes) {
+        end = start + options.maxBytes;
+    }
+
+    reduced.assign(output + start, end - start);
+
+}
@@ -0,0 +1,350 @@
+/* Filename: outputSender.cpp */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include "../../include/outputSender.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+#define KNRM  "\x1B[0m"
+#define KRED  "\x1B[31m"
+#define KGRN  "\x1B[32m"
+#define KYEL  "\x1B[33m"
+#define KBLU  "\x1B[34m"
+#define KMAG  "\x1B[35m"
+#define KCYN  "\x1B[36m"
+#define KWHT  "\x1B[37m"
+
+#define SENDER_POLL_MILLISECONDS (1000)
+#define SENDER_STOP_SECONDS (5)   // The seconds a stalled client can hold back the termination of the server
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Sending = Application_Job_Executor_Server::Application_Output_Sender;
+
+// Initialize the static members
+int Sending::Sender::epollFD = -1;
+int Sending::Sender::wakeFD = -1;
+std::map<int, Sending::Connection> Sending::Sender::connections;
+bool Sending::Sender::stopping = false;
+pthread_t Sending::Sender::senderThread;
+
+/**
+ * @brief Sends as many of the pending bytes of a connection as its client takes without
+ * blocking. The caller must hold the sender mutex of the server.
+ *
+ * @param socketID the socket of the client
+ * @param connection the connection of the client
+ *
+ * @return true if the connection is still usable, false if the client has gone away
+*/
+bool Sending::Sender::flush(const int socketID, Connection& connection) {
+
+    while (connection.sent < connection.pending.size()) {
+
+        ssize_t bytes = ::send(socketID, connection.pending.data() + connection.sent, connection.pending.size() - connection.sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+        if (bytes == -1 && errno == EINTR) continue;
+        if (bytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (bytes <= 0) return false;
+
+        connection.sent += bytes;
+        connection.lastProgress = time(NULL);
+
+    }
+
+    // The bytes that were sent are let go once they are the most of the buffer, so a big output is not moved on every write
+    if (connection.sent == connection.pending.size()) {
+        connection.pending.clear();
+        connection.sent = 0;
+    }
+    else if (connection.sent > connection.pending.size() / 2) {
+        connection.pending.erase(0, connection.sent);
+        connection.sent = 0;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops sending to a connection and drops its pending bytes. The caller must hold
+ * the sender mutex of the server.
+ *
+ * @param socketID the socket of the client
+*/
+void Sending::Sender::drop(const int socketID) {
+
+    epoll_ctl(Sending::Sender::epollFD, EPOLL_CTL_DEL, socketID, NULL);
+    Sending::Sender::connections.erase(socketID);
+
+    // The client may have been left in the middle of a message, so it is cut off instead of getting anything after it
+    shutdown(socketID, SHUT_RDWR);
+
+}
+
+/**
+ * @brief Sender Thread function. It sends the pending bytes of every connection as its client
+ * can take them and drops the clients that take too long, until it is stopped and every
+ * connection has been flushed.
+ *
+ * @param arg unused
+ *
+ * @return anything
+*/
+void* Sending::Sender::SenderThread(void* arg) {
+
+    struct epoll_event events[64];
+
+    while (true) {
+
+        pthread_mutex_lock(&Server::Process::mutex_sender);
+        bool done = Sending::Sender::stopping && Sending::Sender::connections.empty();
+        pthread_mutex_unlock(&Server::Process::mutex_sender);
+
+        if (done) {
+            break;
+        }
+
+        int ready = epoll_wait(Sending::Sender::epollFD, events, 64, SENDER_POLL_MILLISECONDS);
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            perror("Error waiting for client sockets");
+            break;
+        }
+
+        pthread_mutex_lock(&Server::Process::mutex_sender);
+
+        for (int i = 0; i < ready; i++) {
+
+            int socketID = events[i].data.fd;
+
+            if (socketID == Sending::Sender::wakeFD) {
+                eventfd_t value;
+                eventfd_read(Sending::Sender::wakeFD, &value);
+                continue;
+            }
+
+            std::map<int, Connection>::iterator it = Sending::Sender::connections.find(socketID);
+            if (it == Sending::Sender::connections.end()) {
+                continue;
+            }
+
+            if (!Sending::Sender::flush(socketID, it->second)) {
+                Sending::Sender::drop(socketID);
+            }
+            else if (it->second.pending.empty()) {
+                epoll_ctl(Sending::Sender::epollFD, EPOLL_CTL_DEL, socketID, NULL);
+                Sending::Sender::connections.erase(it);
+            }
+
+        }
+
+        // A client that has taken nothing for too long is dropped, and on termination no client is waited for long
+        unsigned long timeout = Server::Process::getOptions().sendTimeout;
+        if (Sending::Sender::stopping && (timeout == 0 || timeout > SENDER_STOP_SECONDS)) {
+            timeout = SENDER_STOP_SECONDS;
+        }
+
+        time_t now = time(NULL);
+        std::vector<int> stalled;
+
+        for (auto& connection : Sending::Sender::connections) {
+            if (timeout > 0 && (unsigned long)(now - connection.second.lastProgress) >= timeout) {
+                stalled.push_back(connection.first);
+            }
+        }
+
+        for (unsigned int i = 0; i < stalled.size(); i++) {
+
+            const Connection& connection = Sending::Sender::connections[stalled[i]];
+
+            std::cout << "---[" << KRED << "Slow  Client" << KWHT << "]--- | ";
+            std::cout << "Socket ID: " << "[" << KRED << stalled[i] << KWHT << "]" << " | ";
+            std::cout << "Dropped: " << "[" << KYEL << connection.pending.size() - connection.sent << " bytes" << KWHT << "]" << std::endl;
+
+            Sending::Sender::drop(stalled[i]);
+
+        }
+
+        pthread_mutex_unlock(&Server::Process::mutex_sender);
+
+    }
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Creates the sender thread.
+ *
+ * @return true if the sender was started successfully, false otherwise
+*/
+bool Sending::Sender::start(void) {
+
+    if ((Sending::Sender::epollFD = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+        perror("Error creating sender epoll instance");
+        return false;
+    }
+
+    if ((Sending::Sender::wakeFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) == -1) {
+        perror("Error creating sender event");
+        return false;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = Sending::Sender::wakeFD;
+
+    if (epoll_ctl(Sending::Sender::epollFD, EPOLL_CTL_ADD, Sending::Sender::wakeFD, &event) == -1) {
+        perror("Error watching sender event");
+        return false;
+    }
+
+    if (pthread_create(&Sending::Sender::senderThread, NULL, Sending::Sender::SenderThread, NULL) != 0) {
+        perror("Error creating sender thread");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops the sender thread, once every connection has been flushed or dropped.
+*/
+void Sending::Sender::stop(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_sender);
+    Sending::Sender::stopping = true;
+    pthread_mutex_unlock(&Server::Process::mutex_sender);
+
+    eventfd_write(Sending::Sender::wakeFD, 1);
+
+    pthread_join(Sending::Sender::senderThread, NULL);
+    close(Sending::Sender::wakeFD);
+    close(Sending::Sender::epollFD);
+
+}
+
+/**
+ * @brief Sends a message made of the given parts to a client, without blocking. Whatever the
+ * client does not take right away is sent by the sender thread, after the messages that are
+ * already waiting for the same client.
+ *
+ * @param socketID the socket of the client
+ * @param parts the parts of the message, in order
+ * @param partCount the number of parts
+*/
+void Sending::Sender::send(const int socketID, const struct iovec* parts, const int partCount) {
+
+    // A detached job has no client
+    if (socketID < 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&Server::Process::mutex_sender);
+
+    std::map<int, Connection>::iterator it = Sending::Sender::connections.find(socketID);
+    size_t taken = 0;
+
+    // Only a client with nothing waiting for it can take the message right away, or the messages would go out of order
+    if (it == Sending::Sender::connections.end()) {
+
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = (struct iovec*)parts;
+        message.msg_iovlen = partCount;
+
+        ssize_t bytes = sendmsg(socketID, &message, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+        if (bytes == -1 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            pthread_mutex_unlock(&Server::Process::mutex_sender);
+            return;
+        }
+
+        taken = bytes > 0 ? bytes : 0;
+
+    }
+
+    // Keep whatever the client did not take
+    std::string rest;
+    for (int i = 0; i < partCount; i++) {
+        if (taken >= parts[i].iov_len) {
+            taken -= parts[i].iov_len;
+            continue;
+        }
+        rest.append((const char*)parts[i].iov_base + taken, parts[i].iov_len - taken);
+        taken = 0;
+    }
+
+    if (rest.empty()) {
+        pthread_mutex_unlock(&Server::Process::mutex_sender);
+        return;
+    }
+
+    if (it != Sending::Sender::connections.end()) {
+        it->second.pending += rest;
+        pthread_mutex_unlock(&Server::Process::mutex_sender);
+        return;
+    }
+
+    // Let the sender thread go on once the socket of the client can take more
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLOUT;
+    event.data.fd = socketID;
+
+    if (epoll_ctl(Sending::Sender::epollFD, EPOLL_CTL_ADD, socketID, &event) == -1) {
+        perror("Error watching client socket");
+    } else {
+        Sending::Sender::connections[socketID] = { rest, 0, time(NULL) };
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_sender);
+
+}
+
+/**
+ * @brief Sends a single message, its size and then its bytes, to a client, without blocking.
+ *
+ * @param socketID the socket of the client
+ * @param message the message to send
+*/
+void Sending::Sender::sendMessage(const int socketID, const std::string& message) {
+
+    ssize_t messageSize = message.size();
+
+    struct iovec parts[2];
+    parts[0] = { (void*)&messageSize, sizeof(ssize_t) };
+    parts[1] = { (void*)message.data(), message.size() };
+
+    Sending::Sender::send(socketID, parts, 2);
+
+}
+
+/**
+ * @brief Returns the bytes that are still waiting to be sent to a client.
+ *
+ * @param socketID the socket of the client
+ *
+ * @return the bytes that the client has not taken yet
+*/
+size_t Sending::Sender::backlog(const int socketID) {
+
+    pthread_mutex_lock(&Server::Process::mutex_sender);
+
+    std::map<int, Connection>::iterator it = Sending::Sender::connections.find(socketID);
+    size_t bytes = it == Sending::Sender::connections.end() ? 0 : it->second.pending.size() - it->second.sent;
+
+    pthread_mutex_unlock(&Server::Process::mutex_sender);
+
+    return bytes;
+
+}
@@ -0,0 +1,387 @@
+/* Filename: outputStreamer.cpp */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include "../../include/outputStreamer.h"
+#include "../../include/outputSender.h"
+#include "../../include/jobSupervisor.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+#define STREAM_POLL_MILLISECONDS (100)
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Streaming = Application_Job_Executor_Server::Application_Output_Streamer;
+namespace Supervision = Application_Job_Executor_Server::Application_Job_Supervisor;
+namespace Sending = Application_Job_Executor_Server::Application_Output_Sender;
+
+// Initialize the static members
+int Streaming::Streamer::epollFD = -1;
+std::map<int, Streaming::Stream> Streaming::Streamer::streams;
+bool Streaming::Streamer::stopping = false;
+pthread_t Streaming::Streamer::streamerThread;
+
+/**
+ * @brief Supporting function that hands a single message, a size and that many bytes, over to
+ * the sender, that keeps the messages of a client whole and in order.
+ * 
+ * @param socketID the socket of the client
+ * @param data the data of the message
+ * @param size the size of the data
+*/
+static void sendFrame(const int socketID, const char* data, const ssize_t size) {
+
+    struct iovec parts[2];
+    parts[0] = { (void*)&size, sizeof(ssize_t) };
+    parts[1] = { (void*)data, (size_t)size };
+
+    Sending::Sender::send(socketID, parts, size > 0 ? 2 : 1);
+
+}
+
+/**
+ * @brief Supporting function that sends the start marker of a streamed output.
+ * 
+ * @param socketID the socket of the client
+ * @param jobID the job ID of the job
+*/
+static void sendStartMarker(const int socketID, const std::string& jobID) {
+
+    std::string marker = "-----" + jobID + " output start------";
+    sendFrame(socketID, marker.c_str(), marker.size());
+
+}
+
+/**
+ * @brief Supporting function that ends a streamed output with an empty frame and the end marker.
+ * 
+ * @param socketID the socket of the client
+ * @param jobID the job ID of the job
+*/
+static void sendEndMarker(const int socketID, const std::string& jobID) {
+
+    std::string marker = "-----" + jobID + " output end------";
+
+    sendFrame(socketID, NULL, 0);
+    sendFrame(socketID, marker.c_str(), marker.size());
+
+}
+
+/**
+ * @brief Moves the next chunk of the given stream to its client, or ends the stream if the
+ * job has closed its output and everything has been sent.
+ * 
+ * @param pipeFD the read end of the pipe of the stream
+ * @param hangUp true if the job has closed its end of the pipe
+ * 
+ * @return true if the stream continues, false if it has ended
+*/
+bool Streaming::Streamer::forwardChunk(const int pipeFD, const bool hangUp) {
+
+    Streaming::Stream& stream = Streaming::Streamer::streams[pipeFD];
+
+    // A client that has not taken the previous chunk yet gets no more until it does, and the job waits on its full pipe meanwhile
+    if (!stream.broken && Sending::Sender::backlog(stream.socketID) >= STREAM_CHUNK_SIZE) {
+        Streaming::Streamer::park(pipeFD);
+        return true;
+    }
+
+    int available = 0;
+    if (ioctl(pipeFD, FIONREAD, &available) == -1) {
+        perror("Error checking job output");
+        available = 0;
+    }
+
+    if (available == 0) {
+
+        if (!hangUp) {
+            return true;
+        }
+
+        if (!stream.broken) {
+            sendEndMarker(stream.socketID, stream.jobID);
+        }
+
+        return false;
+
+    }
+
+    ssize_t chunkSize = available < STREAM_CHUNK_SIZE ? available : STREAM_CHUNK_SIZE;
+
+    // A job that goes past its output limit is stopped, and only the output within the limit is sent
+    if (stream.outputLimit > 0 && !stream.truncated && stream.sent + chunkSize > stream.outputLimit) {
+        stream.truncated = true;
+        Supervision::Supervisor::enforceLimit(stream.processGroup, stream.jobID, Supervision::JL_OUTPUT);
+    }
+
+    if (stream.truncated && stream.sent + chunkSize > stream.outputLimit) {
+        chunkSize = stream.outputLimit - stream.sent;
+    }
+
+    char chunk[STREAM_CHUNK_SIZE];
+
+    // A client that has gone away does not stop the job, so its output is still drained
+    if (stream.broken || chunkSize == 0) {
+        return read(pipeFD, chunk, STREAM_CHUNK_SIZE) != -1 || errno == EINTR;
+    }
+
+    ssize_t bytes = read(pipeFD, chunk, chunkSize);
+    if (bytes == -1) {
+        return errno == EINTR;
+    }
+
+    sendFrame(stream.socketID, chunk, bytes);
+    stream.sent += bytes;
+
+    return true;
+
+}
+
+/**
+ * @brief Stops reading the pipe of the given stream, until the socket of its client can
+ * take more. The caller must hold the streams mutex of the server.
+ * 
+ * @param pipeFD the read end of the pipe of the stream
+*/
+void Streaming::Streamer::park(const int pipeFD) {
+
+    Streaming::Stream& stream = Streaming::Streamer::streams[pipeFD];
+
+    // The socket is watched once for all the streams of its client, so it may be watched already
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLOUT | EPOLLONESHOT;
+    event.data.fd = stream.socketID;
+
+    if (epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_MOD, stream.socketID, &event) == -1 &&
+        epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_ADD, stream.socketID, &event) == -1) {
+        perror("Error watching client socket");
+        return;
+    }
+
+    // The pipe is left out instead of waiting for nothing, or a job that has ended would report its hang-up over and over
+    epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_DEL, pipeFD, NULL);
+    stream.parked = true;
+
+}
+
+/**
+ * @brief Reads the pipes of the streams of a client again, once it has taken what was
+ * sent to it. The caller must hold the streams mutex of the server.
+ * 
+ * @param socketID the socket of the client
+ * @param hangUp true if the client can not be reached anymore
+*/
+void Streaming::Streamer::resume(const int socketID, const bool hangUp) {
+
+    // The socket can take more before the sender has caught up, so it is watched again until the sender has
+    if (!hangUp && Sending::Sender::backlog(socketID) >= STREAM_CHUNK_SIZE) {
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLOUT | EPOLLONESHOT;
+        event.data.fd = socketID;
+
+        if (epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_MOD, socketID, &event) != -1) {
+            return;
+        }
+
+        perror("Error watching client socket");
+
+    }
+
+    for (auto& entry : Streaming::Streamer::streams) {
+
+        Streaming::Stream& stream = entry.second;
+        if (!stream.parked || stream.socketID != socketID) {
+            continue;
+        }
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = entry.first;
+
+        if (epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_ADD, entry.first, &event) == -1) {
+            perror("Error watching job output");
+        }
+
+        stream.parked = false;
+        stream.broken = stream.broken || hangUp;
+
+    }
+
+}
+
+/**
+ * @brief Streamer Thread function. It waits for output on every stream and forwards it,
+ * until it is stopped and every stream has ended.
+ * 
+ * @param arg unused
+ * 
+ * @return anything
+*/
+void* Streaming::Streamer::StreamerThread(void* arg) {
+
+    struct epoll_event events[64];
+
+    while (true) {
+
+        pthread_mutex_lock(&Server::Process::mutex_streams);
+        bool done = Streaming::Streamer::stopping && Streaming::Streamer::streams.empty();
+        pthread_mutex_unlock(&Server::Process::mutex_streams);
+
+        if (done) {
+            break;
+        }
+
+        int ready = epoll_wait(Streaming::Streamer::epollFD, events, 64, STREAM_POLL_MILLISECONDS);
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            perror("Error waiting for job output");
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+
+            int fd = events[i].data.fd;
+            bool hangUp = events[i].events & (EPOLLHUP | EPOLLERR);
+
+            pthread_mutex_lock(&Server::Process::mutex_streams);
+
+            // Anything that is not the pipe of a stream is the socket of a client whose streams wait for it
+            std::map<int, Stream>::iterator it = Streaming::Streamer::streams.find(fd);
+            if (it == Streaming::Streamer::streams.end()) {
+                Streaming::Streamer::resume(fd, hangUp);
+                pthread_mutex_unlock(&Server::Process::mutex_streams);
+                continue;
+            }
+
+            if (!Streaming::Streamer::forwardChunk(fd, hangUp)) {
+
+                int socketID = it->second.socketID;
+
+                epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_DEL, fd, NULL);
+                Streaming::Streamer::streams.erase(it);
+                close(fd);
+
+                // The socket of the client is not watched anymore once its last stream has ended
+                bool streaming = false;
+                for (auto& entry : Streaming::Streamer::streams) {
+                    streaming = streaming || entry.second.socketID == socketID;
+                }
+
+                if (!streaming && Streaming::Streamer::streams.find(socketID) == Streaming::Streamer::streams.end()) {
+                    epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_DEL, socketID, NULL);
+                }
+
+            }
+
+            pthread_mutex_unlock(&Server::Process::mutex_streams);
+
+        }
+
+    }
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Creates the streamer thread.
+ * 
+ * @return true if the streamer was started successfully, false otherwise
+*/
+bool Streaming::Streamer::start(void) {
+
+    if ((Streaming::Streamer::epollFD = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+        perror("Error creating streamer epoll instance");
+        return false;
+    }
+
+    if (pthread_create(&Streaming::Streamer::streamerThread, NULL, Streaming::Streamer::StreamerThread, NULL) != 0) {
+        perror("Error creating streamer thread");
+        return false;
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Stops the streamer thread, once every stream has ended.
+*/
+void Streaming::Streamer::stop(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_streams);
+    Streaming::Streamer::stopping = true;
+    pthread_mutex_unlock(&Server::Process::mutex_streams);
+
+    pthread_join(Streaming::Streamer::streamerThread, NULL);
+    close(Streaming::Streamer::epollFD);
+
+}
+
+/**
+ * @brief Starts streaming the output of a job from the read end of its pipe to its client.
+ * The start marker is sent right away and the pipe is closed when the stream ends. A job
+ * that writes more than its output limit is stopped by the supervisor, like a job whose output is captured.
+ * 
+ * @param pipeFD the read end of the pipe of the job
+ * @param socketID the socket of the client
+ * @param jobID the job ID of the job
+ * @param processGroup the process group of the job
+ * @param outputLimit the bytes of output the job can write, 0 for no limit
+ * 
+ * @return true if the stream was started, false otherwise
+*/
+bool Streaming::Streamer::stream(const int pipeFD, const int socketID, const std::string& jobID, const pid_t processGroup, const unsigned long outputLimit) {
+
+    sendStartMarker(socketID, jobID);
+
+    pthread_mutex_lock(&Server::Process::mutex_streams);
+
+    Streaming::Streamer::streams[pipeFD] = { socketID, jobID, false, processGroup, outputLimit, 0, false, false };
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = pipeFD;
+
+    bool added = epoll_ctl(Streaming::Streamer::epollFD, EPOLL_CTL_ADD, pipeFD, &event) != -1;
+    if (!added) {
+        perror("Error watching job output");
+        Streaming::Streamer::streams.erase(pipeFD);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_streams);
+
+    return added;
+
+}
+
+/**
+ * @brief Sends a whole output, that is already known, in the format of a stream. It is
+ * used for streamed jobs that did not run as a process.
+ * 
+ * @param socketID the socket of the client
+ * @param jobID the job ID of the job
+ * @param output the output of the job
+ * @param outputSize the size of the output
+*/
+void Streaming::Streamer::sendWholeOutput(const int socketID, const std::string& jobID, const char* output, const ssize_t outputSize) {
+
+    sendStartMarker(socketID, jobID);
+
+    if (outputSize > 0) {
+        sendFrame(socketID, output, outputSize);
+    }
+
+    sendEndMarker(socketID, jobID);
+
+}
@@ -0,0 +1,309 @@
+/* Filename: pluginJobs.cpp */
+
+#include <dlfcn.h>
+#include <string.h>
+#include "../../include/pluginJobs.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+#define KNRM  "\x1B[0m"
+#define KRED  "\x1B[31m"
+#define KGRN  "\x1B[32m"
+#define KYEL  "\x1B[33m"
+#define KBLU  "\x1B[34m"
+#define KMAG  "\x1B[35m"
+#define KCYN  "\x1B[36m"
+#define KWHT  "\x1B[37m"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Plugins = Application_Job_Executor_Server::Application_Plugin_Jobs;
+
+// Initialize the static members
+std::map<std::string, void*> Plugins::Registry::libraries;
+std::map<std::string, JobPluginEntry> Plugins::Registry::entries;
+std::set<Plugins::Call*> Plugins::Registry::calls;
+unsigned int Plugins::Registry::runningCalls = 0;
+
+/**
+ * @brief Supporting function that is given to the plugins to write their output. Anything
+ * written after the call has timed out is dropped.
+ * 
+ * @param context the call of the plugin
+ * @param data the data to write
+ * @param size the size of the data
+ * 
+ * @return zero on success, -1 if the call has timed out
+*/
+static int writePluginOutput(void* context, const char* data, size_t size) {
+
+    Plugins::Call* call = (Plugins::Call*)context;
+
+    if (call->timedOut) {
+        return -1;
+    }
+
+    call->output.append(data, size);
+    return 0;
+
+}
+
+/**
+ * @brief Splits the given plugin job string into its library, its entry and its arguments.
+ * 
+ * @param job the plugin job string
+ * @param library the name of the library
+ * @param entry the name of the entry
+ * @param arguments the arguments of the entry, where the first one is the entry itself
+ * 
+ * @return true if the job string was valid, false otherwise
+*/
+bool Plugins::Registry::parsePluginJob(const std::string& job, std::string& library, std::string& entry, std::vector<std::string>& arguments) {
+
+    std::vector<std::string> words;
+    size_t start = job.find_first_not_of(' ');
+
+    while (start != std::string::npos) {
+        size_t end = job.find(' ', start);
+        words.push_back(job.substr(start, end - start));
+        start = job.find_first_not_of(' ', end);
+    }
+
+    if (words.empty() || words[0].compare(0, strlen(PLUGIN_JOB_PREFIX), PLUGIN_JOB_PREFIX) != 0) {
+        return false;
+    }
+
+    // The first word is '@plugin:<library>:<entry>'
+    std::string target = words[0].substr(strlen(PLUGIN_JOB_PREFIX));
+    size_t separator = target.find(':');
+
+    if (separator == std::string::npos) {
+        return false;
+    }
+
+    library = target.substr(0, separator);
+    entry = target.substr(separator + 1);
+
+    // Libraries are loaded only from the plugin directory of the server
+    if (library.empty() || entry.empty() || library.find('/') != std::string::npos) {
+        return false;
+    }
+
+    arguments.assign(words.begin(), words.end());
+    arguments[0] = entry;
+
+    return true;
+
+}
+
+/**
+ * @brief Returns the entry with the given name of the given library, loading the library and
+ * looking up the entry only the first time they are needed.
+ * 
+ * @param library the name of the library
+ * @param entry the name of the entry
+ * 
+ * @return the entry if it was found, nullptr otherwise
+*/
+JobPluginEntry Plugins::Registry::getEntry(const std::string& library, const std::string& entry) {
+
+    pthread_mutex_lock(&Server::Process::mutex_plugins);
+
+    std::string key = library + ":" + entry;
+    std::map<std::string, JobPluginEntry>::iterator found = Plugins::Registry::entries.find(key);
+
+    if (found != Plugins::Registry::entries.end()) {
+        pthread_mutex_unlock(&Server::Process::mutex_plugins);
+        return found->second;
+    }
+
+    // Load the library the first time one of its entries is needed
+    void* handle = Plugins::Registry::libraries[library];
+    if (handle == nullptr) {
+
+        std::string path = Server::Process::getOptions().pluginDirectory + "/" + library;
+
+        if ((handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL)) == nullptr) {
+            std::cerr << "Error loading plugin: " << dlerror() << std::endl;
+            Plugins::Registry::libraries.erase(library);
+            pthread_mutex_unlock(&Server::Process::mutex_plugins);
+            return nullptr;
+        }
+
+        Plugins::Registry::libraries[library] = handle;
+
+    }
+
+    JobPluginEntry function = (JobPluginEntry)dlsym(handle, entry.c_str());
+    if (function == nullptr) {
+        std::cerr << "Error finding plugin entry: " << dlerror() << std::endl;
+    } else {
+        Plugins::Registry::entries[key] = function;
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_plugins);
+
+    return function;
+
+}
+
+/**
+ * @brief Checks if the given job string is a plugin job.
+ * 
+ * @param job the job string
+ * 
+ * @return true if it is a plugin job, false otherwise
+*/
+bool Plugins::Registry::isPluginJob(const std::string& job) {
+    return job.compare(0, strlen(PLUGIN_JOB_PREFIX), PLUGIN_JOB_PREFIX) == 0;
+}
+
+/**
+ * @brief Checks if the given plugin job can be accepted, meaning that plugin jobs are enabled
+ * on the server and that the job string is well formed.
+ * 
+ * @param job the plugin job string
+ * 
+ * @return true if the plugin job is valid, false otherwise
+*/
+bool Plugins::Registry::isValidPluginJob(const std::string& job) {
+
+    std::string library, entry;
+    std::vector<std::string> arguments;
+
+    return !Server::Process::getOptions().pluginDirectory.empty() && Plugins::Registry::parsePluginJob(job, library, entry, arguments);
+
+}
+
+/**
+ * @brief Checks if a plugin slot is free. The caller must hold the worker mutex of the server.
+ * 
+ * @return true if a plugin job can start, false otherwise
+*/
+bool Plugins::Registry::hasFreeSlot(void) {
+    return Plugins::Registry::runningCalls < Server::Process::getOptions().pluginSlots;
+}
+
+/**
+ * @brief Takes a plugin slot. The caller must hold the worker mutex of the server.
+*/
+void Plugins::Registry::reserveSlot(void) {
+    Plugins::Registry::runningCalls++;
+}
+
+/**
+ * @brief Gives back a plugin slot. The caller must hold the worker mutex of the server.
+*/
+void Plugins::Registry::releaseSlot(void) {
+    Plugins::Registry::runningCalls--;
+}
+
+/**
+ * @brief Returns the number of plugin slots in use.
+ * 
+ * @return the number of running plugin jobs
+*/
+unsigned int Plugins::Registry::getRunningCalls(void) {
+    return Plugins::Registry::runningCalls;
+}
+
+/**
+ * @brief Runs the given plugin job on the calling thread.
+ * 
+ * @param triplate the triplate of the plugin job
+ * @param output the output of the job
+ * 
+ * @return true if the entry returned zero in time, false otherwise
+*/
+bool Plugins::Registry::runPluginJob(const CC::JobTriplate& triplate, std::string& output) {
+
+    std::string library, entry;
+    std::vector<std::string> arguments;
+
+    if (!Plugins::Registry::parsePluginJob(triplate.job, library, entry, arguments)) {
+        std::cerr << "Error executing job: invalid plugin job" << std::endl;
+        return false;
+    }
+
+    JobPluginEntry function = Plugins::Registry::getEntry(library, entry);
+    if (function == nullptr) {
+        return false;
+    }
+
+    std::vector<char*> argv;
+    for (unsigned int i = 0; i < arguments.size(); i++) {
+        argv.push_back((char*)arguments[i].c_str());
+    }
+    argv.push_back(NULL);
+
+    // Register the call, so that the watchdog can mark it once its deadline passes
+    Plugins::Call call;
+    call.jobID = triplate.jobID;
+    call.timedOut = 0;
+    clock_gettime(CLOCK_MONOTONIC, &call.deadline);
+    call.deadline.tv_sec += Server::Process::getOptions().pluginTimeout;
+
+    pthread_mutex_lock(&Server::Process::mutex_plugins);
+    Plugins::Registry::calls.insert(&call);
+    pthread_mutex_unlock(&Server::Process::mutex_plugins);
+
+    JobPluginOutput pluginOutput = { &call, writePluginOutput, &call.timedOut };
+    int result = function((int)arguments.size(), argv.data(), &pluginOutput);
+
+    pthread_mutex_lock(&Server::Process::mutex_plugins);
+    Plugins::Registry::calls.erase(&call);
+    pthread_mutex_unlock(&Server::Process::mutex_plugins);
+
+    output.swap(call.output);
+
+    return result == 0 && !call.timedOut;
+
+}
+
+/**
+ * @brief Marks every running call that has run past its deadline as timed out. It is
+ * called on every tick of the timer thread of the server.
+*/
+void Plugins::Registry::checkDeadlines(void) {
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&Server::Process::mutex_plugins);
+
+    for (std::set<Plugins::Call*>::iterator it = Plugins::Registry::calls.begin(); it != Plugins::Registry::calls.end(); it++) {
+
+        Plugins::Call* call = *it;
+
+        if (call->timedOut || now.tv_sec < call->deadline.tv_sec || (now.tv_sec == call->deadline.tv_sec && now.tv_nsec < call->deadline.tv_nsec)) {
+            continue;
+        }
+
+        call->timedOut = 1;
+
+        std::cout << "---[" << KRED << "Plugin  Timeout" << KWHT << "]--- | ";
+        std::cout << "Job ID: " << "[" << KGRN << call->jobID << KWHT << "]" << " | ";
+        std::cout << "Timeout: " << "[" << KYEL << Server::Process::getOptions().pluginTimeout << " sec" << KWHT << "]" << std::endl;
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_plugins);
+
+}
+
+/**
+ * @brief Unloads every loaded library. It must be called only when no plugin job runs.
+*/
+void Plugins::Registry::unloadAll(void) {
+
+    pthread_mutex_lock(&Server::Process::mutex_plugins);
+
+    for (std::map<std::string, void*>::iterator it = Plugins::Registry::libraries.begin(); it != Plugins::Registry::libraries.end(); it++) {
+        dlclose(it->second);
+    }
+
+    Plugins::Registry::libraries.clear();
+    Plugins::Registry::entries.clear();
+
+    pthread_mutex_unlock(&Server::Process::mutex_plugins);
+
+}
@@ -0,0 +1,102 @@
+/* Filename: resourcePool.cpp */
+
+#include "../../include/resourcePool.h"
+
+namespace Resources = Application_Job_Executor_Server::Application_Resource_Pool; // namespace alias
+
+// Initialize the static members
+unsigned int Resources::Pool::totalCpus;
+unsigned long Resources::Pool::totalMemory;
+unsigned int Resources::Pool::usedCpus = 0;
+unsigned long Resources::Pool::usedMemory = 0;
+
+/**
+ * @brief Initializes the capacity of the resource pool.
+ * 
+ * @param cpus the number of CPUs available to the jobs
+ * @param memory the amount of memory in MB available to the jobs
+*/
+void Resources::Pool::init(const unsigned int cpus, const unsigned long memory) {
+
+    Resources::Pool::totalCpus = cpus;
+    Resources::Pool::totalMemory = memory;
+
+}
+
+/**
+ * @brief Returns the number of CPUs that are not reserved by any job.
+ * 
+ * @return the number of free CPUs
+*/
+unsigned int Resources::Pool::getFreeCpus(void) {
+
+    return Resources::Pool::totalCpus - Resources::Pool::usedCpus;
+
+}
+
+/**
+ * @brief Returns the amount of memory in MB that is not reserved by any job.
+ * 
+ * @return the amount of free memory
+*/
+unsigned long Resources::Pool::getFreeMemory(void) {
+
+    return Resources::Pool::totalMemory - Resources::Pool::usedMemory;
+
+}
+
+/**
+ * @brief Returns whether a request of the given resources fits in the free resources
+ * of the pool at this moment.
+ * 
+ * @param cpus the number of CPUs requested
+ * @param memory the amount of memory in MB requested
+ * 
+ * @return true if the request fits, false otherwise
+*/
+bool Resources::Pool::fits(const unsigned int cpus, const unsigned long memory) {
+
+    return cpus <= Resources::Pool::getFreeCpus() && memory <= Resources::Pool::getFreeMemory();
+
+}
+
+/**
+ * @brief Returns whether a request of the given resources could ever fit in the pool,
+ * that is whether it fits when the pool is completely free.
+ * 
+ * @param cpus the number of CPUs requested
+ * @param memory the amount of memory in MB requested
+ * 
+ * @return true if the request can be satisfied, false otherwise
+*/
+bool Resources::Pool::canEverFit(const unsigned int cpus, const unsigned long memory) {
+
+    return cpus <= Resources::Pool::totalCpus && memory <= Resources::Pool::totalMemory;
+
+}
+
+/**
+ * @brief Reserves the given resources for a job that is about to start running.
+ * 
+ * @param cpus the number of CPUs to reserve
+ * @param memory the amount of memory in MB to reserve
+*/
+void Resources::Pool::reserve(const unsigned int cpus, const unsigned long memory) {
+
+    Resources::Pool::usedCpus += cpus;
+    Resources::Pool::usedMemory += memory;
+
+}
+
+/**
+ * @brief Gives back the given resources of a job that has finished running.
+ * 
+ * @param cpus the number of CPUs to release
+ * @param memory the amount of memory in MB to release
+*/
+void Resources::Pool::release(const unsigned int cpus, const unsigned long memory) {
+
+    Resources::Pool::usedCpus -= cpus;
+    Resources::Pool::usedMemory -= memory;
+
+}
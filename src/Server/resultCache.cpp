@@ -0,0 +1,239 @@
+/* Filename: resultCache.cpp */
+
+#include <sys/stat.h>
+#include "../../include/resultCache.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+#define FNV_OFFSET_BASIS (14695981039346656037ULL)
+#define FNV_PRIME        (1099511628211ULL)
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Results = Application_Job_Executor_Server::Application_Result_Cache;
+
+// Initialize the static members
+std::map<uint64_t, Results::CachedResult> Results::Cache::results;
+std::list<uint64_t> Results::Cache::recentlyUsed;
+unsigned long Results::Cache::storedBytes = 0;
+unsigned long Results::Cache::hits = 0;
+unsigned long Results::Cache::misses = 0;
+
+/**
+ * @brief Splits the given job into its arguments and joins them back with a single separator,
+ * so that jobs that differ only in their whitespace get the same result.
+ *
+ * @param job the job string
+ * @param arguments the arguments of the job, where the first one is the executable
+ *
+ * @return the normalized arguments of the job
+*/
+std::string Results::Cache::normalize(const std::string& job, std::vector<std::string>& arguments) {
+
+    std::string normalized;
+    size_t start = job.find_first_not_of(' ');
+
+    while (start != std::string::npos) {
+        size_t end = job.find(' ', start);
+        arguments.push_back(job.substr(start, end - start));
+        start = job.find_first_not_of(' ', end);
+    }
+
+    // A null byte can not be part of an argument, so it separates them unambiguously
+    for (const std::string& argument : arguments) {
+        normalized += argument;
+        normalized += '\0';
+    }
+
+    return normalized;
+
+}
+
+/**
+ * @brief Returns the 64-bit FNV-1a hash of the given normalized arguments.
+ *
+ * @param arguments the normalized arguments
+ *
+ * @return the hash of the arguments
+*/
+uint64_t Results::Cache::hash(const std::string& arguments) {
+
+    uint64_t value = FNV_OFFSET_BASIS;
+
+    for (unsigned char byte : arguments) {
+        value ^= byte;
+        value *= FNV_PRIME;
+    }
+
+    return value;
+
+}
+
+/**
+ * @brief Returns whether the input files of a stored output are still the same files.
+ *
+ * @param result the stored output
+ *
+ * @return true if every input file is unchanged, false otherwise
+*/
+bool Results::Cache::inputsUnchanged(const CachedResult& result) {
+
+    struct stat st;
+
+    for (const InputFile& input : result.inputs) {
+
+        if (stat(input.path.c_str(), &st) == -1 || st.st_dev != input.device || st.st_ino != input.inode || st.st_size != input.size ||
+            st.st_mtim.tv_sec != input.modified.tv_sec || st.st_mtim.tv_nsec != input.modified.tv_nsec) {
+            return false;
+        }
+
+    }
+
+    return true;
+
+}
+
+/**
+ * @brief Drops the stored output with the given hash. The caller must hold the results mutex of the server.
+ *
+ * @param key the hash of the output to drop
+*/
+void Results::Cache::drop(const uint64_t key) {
+
+    std::map<uint64_t, CachedResult>::iterator it = Results::Cache::results.find(key);
+    if (it == Results::Cache::results.end()) {
+        return;
+    }
+
+    Results::Cache::storedBytes -= it->second.output.size();
+    Results::Cache::recentlyUsed.erase(it->second.position);
+    Results::Cache::results.erase(it);
+
+}
+
+/**
+ * @brief Looks up the stored output of the given job. An output that has expired or whose
+ * input files have changed is dropped and not returned.
+ *
+ * @param job the job string
+ * @param output the stored output of the job
+ *
+ * @return true if the output of the job was found, false otherwise
+*/
+bool Results::Cache::lookup(const std::string& job, std::string& output) {
+
+    if (Server::Process::getOptions().resultCacheMemory == 0) {
+        return false;
+    }
+
+    std::vector<std::string> arguments;
+    std::string normalized = Results::Cache::normalize(job, arguments);
+    uint64_t key = Results::Cache::hash(normalized);
+    unsigned long timeToLive = Server::Process::getOptions().resultTimeToLive;
+
+    pthread_mutex_lock(&Server::Process::mutex_results);
+
+    std::map<uint64_t, CachedResult>::iterator it = Results::Cache::results.find(key);
+    bool found = it != Results::Cache::results.end() && it->second.arguments == normalized;
+
+    // An output that is too old, or whose inputs have changed since it was stored, is no longer valid
+    if (found && ((timeToLive > 0 && time(NULL) - it->second.storedAt >= (time_t)timeToLive) || !Results::Cache::inputsUnchanged(it->second))) {
+        Results::Cache::drop(key);
+        found = false;
+    }
+
+    if (found) {
+        output = it->second.output;
+        Results::Cache::recentlyUsed.splice(Results::Cache::recentlyUsed.begin(), Results::Cache::recentlyUsed, it->second.position);
+        Results::Cache::hits++;
+    } else {
+        Results::Cache::misses++;
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_results);
+
+    return found;
+
+}
+
+/**
+ * @brief Stores the output of a cacheable job that has finished successfully. Outputs bigger than the
+ * whole budget are not stored, and neither are outputs of jobs whose input files changed while they ran.
+ *
+ * @param job the job string
+ * @param checkInputs whether the output is only valid while the input files of the job are unchanged
+ * @param startTime the time the job started running at
+ * @param output the output of the job
+ * @param outputSize the size of the output
+*/
+void Results::Cache::store(const std::string& job, const bool checkInputs, const time_t startTime, const char* output, const ssize_t outputSize) {
+
+    unsigned long budget = Server::Process::getOptions().resultCacheMemory * 1024 * 1024;
+    if ((unsigned long)outputSize > budget) {
+        return;
+    }
+
+    std::vector<std::string> arguments;
+    CachedResult result;
+    result.arguments = Results::Cache::normalize(job, arguments);
+    result.storedAt = time(NULL);
+
+    // Every argument that names a file is an input of the job. A file that was modified after the job
+    // started may have been read half old and half new, so such an output is not stored
+    if (checkInputs) {
+
+        struct stat st;
+
+        for (const std::string& argument : arguments) {
+
+            if (stat(argument.c_str(), &st) == -1 || !S_ISREG(st.st_mode)) {
+                continue;
+            }
+            if (st.st_mtim.tv_sec >= startTime) {
+                return;
+            }
+
+            result.inputs.push_back({ argument, st.st_dev, st.st_ino, st.st_size, st.st_mtim });
+
+        }
+
+    }
+
+    result.output.assign(output, outputSize);
+    uint64_t key = Results::Cache::hash(result.arguments);
+
+    pthread_mutex_lock(&Server::Process::mutex_results);
+
+    // Replace an older output of the same job, and make room by dropping the least recently used outputs
+    Results::Cache::drop(key);
+
+    while (Results::Cache::storedBytes + outputSize > budget && !Results::Cache::recentlyUsed.empty()) {
+        Results::Cache::drop(Results::Cache::recentlyUsed.back());
+    }
+
+    Results::Cache::recentlyUsed.push_front(key);
+    result.position = Results::Cache::recentlyUsed.begin();
+    Results::Cache::storedBytes += outputSize;
+    Results::Cache::results[key] = result;
+
+    pthread_mutex_unlock(&Server::Process::mutex_results);
+
+}
+
+/**
+ * @brief Returns the hits and misses of the result cache and the bytes of the stored outputs.
+ *
+ * @param hitCount the cacheable jobs that got a stored output
+ * @param missCount the cacheable jobs that had to run
+ * @param entries the number of stored outputs
+ * @param bytes the bytes the stored outputs take
+*/
+void Results::Cache::getStats(unsigned long& hitCount, unsigned long& missCount, unsigned long& entries, unsigned long& bytes) {
+
+    pthread_mutex_lock(&Server::Process::mutex_results);
+    hitCount = Results::Cache::hits;
+    missCount = Results::Cache::misses;
+    entries = Results::Cache::results.size();
+    bytes = Results::Cache::storedBytes;
+    pthread_mutex_unlock(&Server::Process::mutex_results);
+
+}
@@ -0,0 +1,227 @@
+/* Filename: runningJobsTable.cpp */
+
+#include "../../include/runningJobsTable.h"
+
+namespace RunningJobs = Application_Job_Executor_Server::Application_Running_Jobs; // namespace alias
+
+// Initialize the static members
+std::map<std::string, RunningJobs::RunningJob> RunningJobs::Table::jobs;
+unsigned int RunningJobs::Table::suspendedJobs = 0;
+unsigned int RunningJobs::Table::canceledJobs = 0;
+
+/**
+ * @brief Inserts a job that has just started running to the table.
+ * 
+ * @param job the running job to insert
+*/
+void RunningJobs::Table::insert(const RunningJobs::RunningJob& job) {
+
+    RunningJobs::Table::jobs[job.jobID] = job;
+
+}
+
+/**
+ * @brief Searches for the job with the given job ID and if it is found, it removes it
+ * from the table.
+ * 
+ * @param jobID the job ID of the job to remove
+ * @param job the job that has been removed
+ * 
+ * @return true if the job was found, false otherwise
+*/
+bool RunningJobs::Table::remove(const std::string jobID, RunningJobs::RunningJob& job) {
+
+    std::map<std::string, RunningJobs::RunningJob>::iterator it = RunningJobs::Table::jobs.find(jobID);
+    if (it == RunningJobs::Table::jobs.end()) {
+        return false;
+    }
+
+    job = it->second;
+    if (job.suspended) { RunningJobs::Table::suspendedJobs--; }
+    if (job.canceled) { RunningJobs::Table::canceledJobs--; }
+
+    RunningJobs::Table::jobs.erase(it);
+
+    return true;
+
+}
+
+/**
+ * @brief Searches for the job with the given job ID.
+ * 
+ * @param jobID the job ID of the job to find
+ * 
+ * @return a pointer to the job, nullptr if it is not in the table
+*/
+RunningJobs::RunningJob* RunningJobs::Table::find(const std::string jobID) {
+
+    std::map<std::string, RunningJobs::RunningJob>::iterator it = RunningJobs::Table::jobs.find(jobID);
+
+    return it != RunningJobs::Table::jobs.end() ? &it->second : nullptr;
+
+}
+
+/**
+ * @brief Marks the given job as canceled. A canceled job is no longer suspended, it is never
+ * preempted or resumed, and it is killed if it is still running at the given deadline.
+ * 
+ * @param job the job of the table to mark
+ * @param killDeadline the time the job is killed at
+*/
+void RunningJobs::Table::setCanceled(RunningJobs::RunningJob* job, const struct timespec& killDeadline) {
+
+    if (job->canceled) {
+        return;
+    }
+
+    if (job->suspended) {
+        job->suspended = false;
+        RunningJobs::Table::suspendedJobs--;
+    }
+
+    job->canceled = true;
+    job->killDeadline = killDeadline;
+    RunningJobs::Table::canceledJobs++;
+
+}
+
+/**
+ * @brief Returns the process groups of the canceled jobs that have outlived their grace
+ * period and have not been killed yet, and marks them as killed.
+ * 
+ * @param now the current time
+ * @param processGroups the process groups to kill
+*/
+void RunningJobs::Table::takeOverdueCanceledJobs(const struct timespec& now, std::vector<pid_t>& processGroups) {
+
+    for (auto& entry : RunningJobs::Table::jobs) {
+
+        RunningJobs::RunningJob& job = entry.second;
+
+        if (!job.canceled || job.killed) {
+            continue;
+        }
+        if (now.tv_sec < job.killDeadline.tv_sec || (now.tv_sec == job.killDeadline.tv_sec && now.tv_nsec < job.killDeadline.tv_nsec)) {
+            continue;
+        }
+
+        job.killed = true;
+        processGroups.push_back(job.processGroup);
+
+    }
+
+}
+
+/**
+ * @brief Returns a copy of every job of the table.
+ * 
+ * @param jobs the jobs of the table
+*/
+void RunningJobs::Table::getJobs(std::vector<RunningJobs::RunningJob>& jobs) {
+
+    for (auto& entry : RunningJobs::Table::jobs) {
+        jobs.push_back(entry.second);
+    }
+
+}
+
+/**
+ * @brief Returns the running (not suspended or canceled) job with the lowest priority, that is
+ * lower than the given one and has not reached the maximum number of preemptions.
+ * 
+ * @param priority the priority of the job that needs a slot
+ * @param maxPreemptions the maximum number of times a single job can be preempted
+ * 
+ * @return a pointer to the job to preempt, nullptr if there is no such job
+*/
+RunningJobs::RunningJob* RunningJobs::Table::findPreemptionVictim(const unsigned int priority, const unsigned int maxPreemptions) {
+
+    RunningJobs::RunningJob* victim = nullptr;
+
+    for (auto& entry : RunningJobs::Table::jobs) {
+
+        RunningJobs::RunningJob& job = entry.second;
+
+        // Skip the jobs that cannot be preempted
+        if (job.suspended || job.canceled || job.priority >= priority || job.preemptions >= maxPreemptions) {
+            continue;
+        }
+
+        if (victim == nullptr || job.priority < victim->priority) {
+            victim = &job;
+        }
+
+    }
+
+    return victim;
+
+}
+
+/**
+ * @brief Returns the suspended job with the highest priority, which is the next one
+ * to be resumed.
+ * 
+ * @return a pointer to the job to resume, nullptr if no job is suspended
+*/
+RunningJobs::RunningJob* RunningJobs::Table::findJobToResume(void) {
+
+    RunningJobs::RunningJob* candidate = nullptr;
+
+    for (auto& entry : RunningJobs::Table::jobs) {
+
+        RunningJobs::RunningJob& job = entry.second;
+
+        if (job.suspended && (candidate == nullptr || job.priority > candidate->priority)) {
+            candidate = &job;
+        }
+
+    }
+
+    return candidate;
+
+}
+
+/**
+ * @brief Marks the given job as suspended or not suspended.
+ * 
+ * @param job the job of the table to mark
+ * @param suspended whether the job is now suspended
+*/
+void RunningJobs::Table::setSuspended(RunningJobs::RunningJob* job, const bool suspended) {
+
+    if (job->suspended == suspended) {
+        return;
+    }
+
+    job->suspended = suspended;
+
+    if (suspended) {
+        job->preemptions++;
+        RunningJobs::Table::suspendedJobs++;
+    } else {
+        RunningJobs::Table::suspendedJobs--;
+    }
+
+}
+
+/**
+ * @brief Returns the number of suspended jobs in the table.
+ * 
+ * @return the amount of suspended jobs
+*/
+unsigned int RunningJobs::Table::getSuspendedJobs(void) {
+
+    return RunningJobs::Table::suspendedJobs;
+
+}
+
+/**
+ * @brief Returns the number of canceled jobs in the table, that have not exited yet.
+ * 
+ * @return the amount of canceled jobs
+*/
+unsigned int RunningJobs::Table::getCanceledJobs(void) {
+
+    return RunningJobs::Table::canceledJobs;
+
+}
@@ -11,12 +11,45 @@
 #include "../../include/jobExecutorServerProcess.h"
 #include "../../include/controllerThread.h"
 #include "../../include/workerThread.h"
+#include "../../include/resourcePool.h"
+#include "../../include/runningJobsTable.h"
+#include "../../include/dependencyGraph.h"
+#include "../../include/timerWheel.h"
+#include "../../include/pluginJobs.h"
+#include "../../include/jobSupervisor.h"
+#include "../../include/outputStreamer.h"
+#include "../../include/jobResults.h"
+#include "../../include/completionEvents.h"
+#include "../../include/outputSender.h"
+#include "../../include/clientMonitor.h"
+#include "../../include/inputFeeder.h"
+
+#define KNRM  "\x1B[0m"
+#define KRED  "\x1B[31m"
+#define KGRN  "\x1B[32m"
+#define KYEL  "\x1B[33m"
+#define KBLU  "\x1B[34m"
+#define KMAG  "\x1B[35m"
+#define KCYN  "\x1B[36m"
+#define KWHT  "\x1B[37m"
 
 /* namespace alias */
 namespace Server = Application_Job_Executor_Server;
 namespace Controller = Application_Job_Executor_Server::Application_Controller_Thread;
 namespace Worker = Application_Job_Executor_Server::Application_Worker_Thread;
 namespace WaitingBuffer = Application_Job_Executor_Server::Application_Common_Waiting_Buffer;
+namespace Resources = Application_Job_Executor_Server::Application_Resource_Pool;
+namespace RunningJobs = Application_Job_Executor_Server::Application_Running_Jobs;
+namespace Dependencies = Application_Job_Executor_Server::Application_Job_Dependencies;
+namespace Timers = Application_Job_Executor_Server::Application_Timer_Wheel;
+namespace Plugins = Application_Job_Executor_Server::Application_Plugin_Jobs;
+namespace Supervision = Application_Job_Executor_Server::Application_Job_Supervisor;
+namespace Streaming = Application_Job_Executor_Server::Application_Output_Streamer;
+namespace JobResults = Application_Job_Executor_Server::Application_Job_Results;
+namespace Events = Application_Job_Executor_Server::Application_Completion_Events;
+namespace Sending = Application_Job_Executor_Server::Application_Output_Sender;
+namespace Monitoring = Application_Job_Executor_Server::Application_Client_Monitor;
+namespace Feeding = Application_Job_Executor_Server::Application_Input_Feeder;
 
 /* Declare static variables */
 port_num_t Server::Process::portNum;
@@ -32,6 +65,7 @@ unsigned int Server::Process::busyWorkers = 0;
 pid_t Server::Process::processID;
 
 unsigned int Server::Process::concurrency = 1;
+Server::Options Server::Process::options;
 bool Server::Process::shouldStop = false;
 bool Server::Process::continueExecution;
 
@@ -40,11 +74,29 @@ pthread_mutex_t Server::Process::mutex_worker;
 pthread_mutex_t Server::Process::mutex_jobInsertion;
 pthread_mutex_t Server::Process::mutex_serverContinue;
 pthread_mutex_t Server::Process::mutex_allJobsDone;
+pthread_mutex_t Server::Process::mutex_dependencies;
+pthread_mutex_t Server::Process::mutex_timers;
+pthread_mutex_t Server::Process::mutex_launcher;
+pthread_mutex_t Server::Process::mutex_plugins;
+pthread_mutex_t Server::Process::mutex_supervisor;
+pthread_mutex_t Server::Process::mutex_streams;
+pthread_mutex_t Server::Process::mutex_outputs;
+pthread_mutex_t Server::Process::mutex_results;
+pthread_mutex_t Server::Process::mutex_coalescing;
+pthread_mutex_t Server::Process::mutex_detached;
+pthread_mutex_t Server::Process::mutex_events;
+pthread_mutex_t Server::Process::mutex_sender;
+pthread_mutex_t Server::Process::mutex_clients;
+pthread_mutex_t Server::Process::mutex_inputs;
+pthread_mutex_t Server::Process::mutex_blobs;
 
 pthread_cond_t Server::Process::condVar_controller;
 pthread_cond_t Server::Process::condVar_worker;
 pthread_cond_t Server::Process::condVar_serverContinue;
 pthread_cond_t Server::Process::condVar_allJobsDone;
+pthread_cond_t Server::Process::condVar_launcher;
+pthread_cond_t Server::Process::condVar_supervisor;
+pthread_cond_t Server::Process::condVar_events;
 
 /**
  * @brief Removes the given directory with all the files containing the outputs of the jobs executed
@@ -56,9 +108,10 @@ pthread_cond_t Server::Process::condVar_allJobsDone;
 */
 static bool removeTeporaryDirectory(const std::string& directoryPath) {
 
-    // Open the given directory and check if any error has occured
+    // Open the given directory and check if any error has occured. The directory does not exist if only plugin jobs ran
     DIR* dir = opendir(directoryPath.c_str());
     if (dir == nullptr) {
+        if (errno == ENOENT) return true;
         perror("Error opening temporary directory");
         return false;
     }
@@ -106,6 +159,21 @@ static void initializeServerMutexes(void) {
     pthread_mutex_init(&Server::Process::mutex_jobInsertion, NULL);
     pthread_mutex_init(&Server::Process::mutex_serverContinue, NULL);
     pthread_mutex_init(&Server::Process::mutex_allJobsDone, NULL);
+    pthread_mutex_init(&Server::Process::mutex_dependencies, NULL);
+    pthread_mutex_init(&Server::Process::mutex_timers, NULL);
+    pthread_mutex_init(&Server::Process::mutex_launcher, NULL);
+    pthread_mutex_init(&Server::Process::mutex_plugins, NULL);
+    pthread_mutex_init(&Server::Process::mutex_supervisor, NULL);
+    pthread_mutex_init(&Server::Process::mutex_streams, NULL);
+    pthread_mutex_init(&Server::Process::mutex_outputs, NULL);
+    pthread_mutex_init(&Server::Process::mutex_results, NULL);
+    pthread_mutex_init(&Server::Process::mutex_coalescing, NULL);
+    pthread_mutex_init(&Server::Process::mutex_detached, NULL);
+    pthread_mutex_init(&Server::Process::mutex_events, NULL);
+    pthread_mutex_init(&Server::Process::mutex_sender, NULL);
+    pthread_mutex_init(&Server::Process::mutex_clients, NULL);
+    pthread_mutex_init(&Server::Process::mutex_inputs, NULL);
+    pthread_mutex_init(&Server::Process::mutex_blobs, NULL);
 
 }
 
@@ -119,6 +187,9 @@ static void initializeServerConditionVariables(void) {
     pthread_cond_init(&Server::Process::condVar_worker, NULL);
     pthread_cond_init(&Server::Process::condVar_serverContinue, NULL);
     pthread_cond_init(&Server::Process::condVar_allJobsDone, NULL);
+    pthread_cond_init(&Server::Process::condVar_launcher, NULL);
+    pthread_cond_init(&Server::Process::condVar_supervisor, NULL);
+    pthread_cond_init(&Server::Process::condVar_events, NULL);
 
 }
 
@@ -133,6 +204,21 @@ static void deleteServerMutexes(void) {
     pthread_mutex_destroy(&Server::Process::mutex_jobInsertion);
     pthread_mutex_destroy(&Server::Process::mutex_serverContinue);
     pthread_mutex_destroy(&Server::Process::mutex_allJobsDone);
+    pthread_mutex_destroy(&Server::Process::mutex_dependencies);
+    pthread_mutex_destroy(&Server::Process::mutex_timers);
+    pthread_mutex_destroy(&Server::Process::mutex_launcher);
+    pthread_mutex_destroy(&Server::Process::mutex_plugins);
+    pthread_mutex_destroy(&Server::Process::mutex_supervisor);
+    pthread_mutex_destroy(&Server::Process::mutex_streams);
+    pthread_mutex_destroy(&Server::Process::mutex_outputs);
+    pthread_mutex_destroy(&Server::Process::mutex_results);
+    pthread_mutex_destroy(&Server::Process::mutex_coalescing);
+    pthread_mutex_destroy(&Server::Process::mutex_detached);
+    pthread_mutex_destroy(&Server::Process::mutex_events);
+    pthread_mutex_destroy(&Server::Process::mutex_sender);
+    pthread_mutex_destroy(&Server::Process::mutex_clients);
+    pthread_mutex_destroy(&Server::Process::mutex_inputs);
+    pthread_mutex_destroy(&Server::Process::mutex_blobs);
     
 }   
 
@@ -146,6 +232,9 @@ static void deleteServerConditionVariables(void) {
     pthread_cond_destroy(&Server::Process::condVar_worker); 
     pthread_cond_destroy(&Server::Process::condVar_serverContinue);
     pthread_cond_destroy(&Server::Process::condVar_allJobsDone  ); 
+    pthread_cond_destroy(&Server::Process::condVar_launcher);
+    pthread_cond_destroy(&Server::Process::condVar_supervisor);
+    pthread_cond_destroy(&Server::Process::condVar_events);
     
 }
 
@@ -156,15 +245,18 @@ static void deleteServerConditionVariables(void) {
  * @param portNum the port number of the server
  * @param bufferSize the size of the buffer
  * @param threadPoolSize the size of the thread pool
+ * @param options the optional settings of the server
 */
-void Server::Process::init(const port_num_t portNum, const unsigned int bufferSize, const unsigned int threadPoolSize) {
+void Server::Process::init(const port_num_t portNum, const unsigned int bufferSize, const unsigned int threadPoolSize, const Server::Options& options) {
 
     // Initialize the basic data of the server
     Server::Process::portNum = portNum; Server::Process::bufferSize = bufferSize; Server::Process::threadPoolSize = threadPoolSize;
+    Server::Process::options = options;
 
-    // Assign the process ID and set the capacity of the buffer queue
+    // Assign the process ID and set the capacity of the buffer queue and the resource pool
     Server::Process::processID = getpid();
     WaitingBuffer::Queue::setCapacity(Server::Process::bufferSize);
+    Resources::Pool::init(options.cpus, options.memory);
 
     // Initialize mutexes and condition variables
     initializeServerMutexes();
@@ -212,6 +304,15 @@ unsigned int Server::Process::getConcurrency(void) {
     return Server::Process::concurrency;
 }
 
+/**
+ * @brief Returns the optional settings of the server.
+ * 
+ * @return the options of the server
+*/
+const Server::Options& Server::Process::getOptions(void) {
+    return Server::Process::options;
+}
+
 /**
  * @brief Increases the amount of running jobs by one.
 */
@@ -219,6 +320,68 @@ void Server::Process::increaseRunningJobs(void) {
     Server::Process::runningJobs++;
 }
 
+/**
+ * @brief Decreases the amount of running jobs by one.
+*/
+void Server::Process::decreaseRunningJobs(void) {
+    Server::Process::runningJobs--;
+}
+
+/**
+ * @brief Records the end of a job in the dependency graph. The jobs that were waiting only for
+ * this job are placed in the waiting buffer queue, and if the job failed, the clients of the jobs
+ * depending on it are notified that their jobs were canceled. Either way, the client of the job
+ * is no longer watched once it has got every output it waits for.
+ * 
+ * @param jobID the job ID of the job that ended
+ * @param succeeded whether the job finished successfully
+*/
+void Server::Process::completeJob(const std::string jobID, const bool succeeded) {
+
+    std::vector<CC::JobTriplate> released, canceled;
+    Dependencies::Graph::finishJob(jobID, succeeded, released, canceled);
+    Monitoring::Monitor::release(jobID);
+
+    // Place the released jobs in the waiting buffer queue and wake up the workers to pick them
+    if (!released.empty()) {
+
+        pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
+        for (unsigned int i = 0; i < released.size(); i++) {
+            WaitingBuffer::Queue::appendJobTriplate(released[i]);
+        }
+        pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
+
+        pthread_mutex_lock(&Server::Process::mutex_worker);
+        pthread_cond_broadcast(&Server::Process::condVar_worker);
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+    }
+
+    for (unsigned int i = 0; i < released.size(); i++) {
+        std::cout << "---[" << KCYN << "Job  Release" << KWHT << "]--- | ";
+        std::cout << "Job ID: " << "[" << KGRN << released[i].jobID << KWHT << "]" << " | ";
+        std::cout << "After: " << "[" << KGRN << jobID << KWHT << "]" << std::endl;
+    }
+
+    // Notify the clients of the canceled jobs
+    for (unsigned int i = 0; i < canceled.size(); i++) {
+
+        char notificationMessage[] = "JOB CANCELED BECAUSE A DEPENDENCY FAILED";
+
+        Sending::Sender::sendMessage(canceled[i].socketID, notificationMessage);
+
+        JobResults::Store::discard(canceled[i].jobID, notificationMessage);
+        Monitoring::Monitor::release(canceled[i].jobID);
+        Events::Publisher::publish({ canceled[i].jobID, canceled[i].options.tag, false, false, -1, 0, 0 });
+
+        std::cout << "---[" << KRED << "Job Cancellation" << KWHT << "]--- | ";
+        std::cout << "Job ID: " << "[" << KRED << canceled[i].jobID << KWHT << "]" << " | ";
+        std::cout << "Failed dependency: " << "[" << KRED << jobID << KWHT << "]" << std::endl;
+
+    }
+
+}
+
 /**
  * @brief Sets the concurrency of the server (how many jobs can run at the same time)
  * 
@@ -274,8 +437,8 @@ bool Server::Process::attachSocketToPort(void) {
         return false;
     }
 
-    // Listen on port
-    if (listen(Server::Process::server_fd, 3) < 0) {
+    // Listen on port. Every submitted job keeps its client connected, so many clients may connect at once
+    if (listen(Server::Process::server_fd, SOMAXCONN) < 0) {
         perror("Error listening to port");
         close(Server::Process::server_fd);
         return false;
@@ -296,6 +459,7 @@ bool Server::Process::run(void) {
     int client_socket;
 
     pthread_t worker_threads[Server::Process::threadPoolSize];
+    pthread_t timer_thread;
 
     // Create the worker threads
     for (unsigned int i = 0; i < Server::Process::threadPoolSize; i++) {
@@ -305,6 +469,16 @@ bool Server::Process::run(void) {
         }
     }
 
+    // Create the timer thread, the supervisor of the running jobs, the streamer and the sender of their outputs, the publisher
+    // of their ends, the monitor of their clients and the feeder of their inputs
+    if (pthread_create(&timer_thread, NULL, Server::Process::TimerThread, NULL) != 0) {
+        perror("Error creating timer thread");
+        return false;
+    }
+    if (!Supervision::Supervisor::start() || !Streaming::Streamer::start() || !Sending::Sender::start() || !Events::Publisher::start() || !Monitoring::Monitor::start() || !Feeding::Feeder::start()) {
+        return false;
+    }
+
     // Server listening on port loop
     while(!Server::Process::shouldStop) 
     {
@@ -339,10 +513,19 @@ bool Server::Process::run(void) {
     pthread_cond_broadcast(&Server::Process::condVar_worker);
     pthread_mutex_unlock(&Server::Process::mutex_worker);
 
-    // Join worker threads to ensure proper cleanup
+    // Join worker threads and the timer thread to ensure proper cleanup
     for (unsigned int i = 0; i < Server::Process::threadPoolSize; i++) {
         pthread_join(worker_threads[i], NULL);
     }
+    pthread_join(timer_thread, NULL);
+    Monitoring::Monitor::stop();
+    Feeding::Feeder::stop();
+    Supervision::Supervisor::stop();
+    Streaming::Streamer::stop();
+    Events::Publisher::stop();
+    Sending::Sender::stop();
+
+    Plugins::Registry::unloadAll();
 
     // Delete the temporary directory of all the output files
     if (!removeTeporaryDirectory("temp")) {
@@ -382,47 +565,96 @@ void* Server::Process::ControllerThread(void* socket_desc) {
 */
 void* Server::Process::WorkerThread(void* arg) {
 
-    bool shouldStop = false;
-
     // Main Loop of the Worker Thread
     while (true) {
 
+        Worker::Thread workerThread = Worker::Thread();
+        CC::JobTriplate triplate;
+        bool received = false;
+
+        // Wait until a job of the buffer fits in the free slots and resources of the server, or the server stops
         pthread_mutex_lock(&Server::Process::mutex_worker);
-        while (WaitingBuffer::Queue::isEmpty() || Server::Process::runningJobs == Server::Process::concurrency) {
+        while (!Server::Process::shouldStop && !(received = workerThread.receiveJobFromBuffer(triplate))) {
             pthread_cond_wait(&Server::Process::condVar_worker, &Server::Process::mutex_worker);
-            
-            // Check if the server should stop
-            if (Server::Process::shouldStop) {
-                pthread_mutex_unlock(&Server::Process::mutex_worker);
-                shouldStop = true;
-                break;
-            }
         }
 
+        if (received) { Server::Process::busyWorkers++; }
         pthread_mutex_unlock(&Server::Process::mutex_worker);
 
-        // Check if the server should terminate before creating a Worker Thread object
-        if (shouldStop) { break; } 
-
-        Worker::Thread workerThread = Worker::Thread();
+        // Check if the server should terminate
+        if (!received) { break; } 
 
-        pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
-        CC::JobTriplate triplate = workerThread.receiveJobFromBuffer();
-        pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
-
-        pthread_mutex_lock(&Server::Process::mutex_worker);
+        // A position in the buffer has been freed, so notify a controller thread waiting for it
+        pthread_mutex_lock(&Server::Process::mutex_controller);
         pthread_cond_signal(&Server::Process::condVar_controller);
-        pthread_mutex_unlock(&Server::Process::mutex_worker);
+        pthread_mutex_unlock(&Server::Process::mutex_controller);
         
-        Server::Process::busyWorkers++;
+        // Dispatch the job and go back to the queue. The slot and the resources of the job are given back
+        // when the job is finished, by the supervisor once it exits or right away for a plugin job
         workerThread.executeJob(triplate);
 
         pthread_mutex_lock(&Server::Process::mutex_worker);
-        Server::Process::runningJobs--;
         Server::Process::busyWorkers--;
         pthread_mutex_unlock(&Server::Process::mutex_worker);
+    }
+
+    return nullptr;
+
+}
+
+/**
+ * @brief Timer Thread function of the server. It advances the timer wheel once every tick and
+ * places the delayed and recurring jobs that became due in the waiting buffer queue. On every
+ * tick it also checks the deadlines of the running plugin calls and the wall time limits of
+ * the running jobs.
+ * 
+ * @param arg unused
+ * 
+ * @return anything
+*/
+void* Server::Process::TimerThread(void* arg) {
+
+    struct timespec nextTick;
+    clock_gettime(CLOCK_MONOTONIC, &nextTick);
+
+    while (!Server::Process::shouldStop) {
+
+        // Sleep until the next tick, measured from the previous one so that the wheel does not drift
+        nextTick.tv_nsec += TIMER_TICK_MILLISECONDS * 1000000L;
+        if (nextTick.tv_nsec >= 1000000000L) {
+            nextTick.tv_sec++;
+            nextTick.tv_nsec -= 1000000000L;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &nextTick, NULL);
+
+        // The tick also drives the watchdog of the plugin calls and the wall time limits of the jobs
+        Plugins::Registry::checkDeadlines();
+        Supervision::Supervisor::checkDeadlines();
+
+        std::vector<CC::JobTriplate> dueJobs;
+        Timers::Wheel::advance(dueJobs);
+
+        if (dueJobs.empty()) {
+            continue;
+        }
+
+        // Place the due jobs in the waiting buffer queue, as they were admitted when they were scheduled
+        pthread_mutex_lock(&Server::Process::mutex_jobInsertion);
+        for (unsigned int i = 0; i < dueJobs.size(); i++) {
+            WaitingBuffer::Queue::appendJobTriplate(dueJobs[i]);
+        }
+        pthread_mutex_unlock(&Server::Process::mutex_jobInsertion);
+
+        pthread_mutex_lock(&Server::Process::mutex_worker);
+        pthread_cond_broadcast(&Server::Process::condVar_worker);
+        pthread_mutex_unlock(&Server::Process::mutex_worker);
+
+        for (unsigned int i = 0; i < dueJobs.size(); i++) {
+            std::cout << "---[" << KCYN << "Scheduled Job Due" << KWHT << "]--- | ";
+            std::cout << "Job ID: " << "[" << KGRN << dueJobs[i].jobID << KWHT << "]" << " | ";
+            std::cout << "Job command: " << "'" << KBLU << dueJobs[i].job << KWHT << "'" << std::endl;
+        }
 
-        pthread_cond_signal(&Server::Process::condVar_allJobsDone);
     }
 
     return nullptr;
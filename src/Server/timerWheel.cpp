@@ -0,0 +1,202 @@
+/* Filename: timerWheel.cpp */
+
+#include <ctime>
+#include <functional>
+#include "../../include/timerWheel.h"
+#include "../../include/jobExecutorServerProcess.h"
+
+/* namespace alias */
+namespace Server = Application_Job_Executor_Server;
+namespace Timers = Application_Job_Executor_Server::Application_Timer_Wheel;
+
+// Initialize the static members
+std::vector<Timers::Entry*> Timers::Wheel::slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+std::map<std::string, Timers::Entry*> Timers::Wheel::entries;
+unsigned long Timers::Wheel::currentTick = 0;
+
+/**
+ * @brief Places the given entry in the slot of the level that matches its distance from
+ * the current tick. The caller must hold the timers mutex of the server.
+ * 
+ * @param entry the entry to place
+*/
+void Timers::Wheel::place(Timers::Entry* entry) {
+
+    unsigned long delta = entry->expiry - Timers::Wheel::currentTick;
+    unsigned long expiry = entry->expiry;
+    unsigned int level = 0;
+
+    // Find the lowest level whose turn covers the distance of the entry
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1UL << (TIMER_WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    // Entries beyond the turn of the highest level wait in its furthest slot and are placed again later
+    unsigned long maxDelta = (1UL << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    if (delta > maxDelta) {
+        expiry = Timers::Wheel::currentTick + maxDelta;
+    }
+
+    unsigned int slot = (expiry >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK;
+    Timers::Wheel::slots[level][slot].push_back(entry);
+
+}
+
+/**
+ * @brief Schedules a new job according to its '--at' and '--every' options. A recurring job
+ * gets a phase inside its period derived from its job ID, so that recurring jobs sharing the
+ * same period are spread over different ticks.
+ * 
+ * @param triplate the triplate of the job to schedule
+*/
+void Timers::Wheel::schedule(const CC::JobTriplate& triplate) {
+
+    const unsigned long ticksPerSecond = 1000 / TIMER_TICK_MILLISECONDS;
+
+    Timers::Entry* entry = new Timers::Entry;
+    entry->triplate = triplate;
+    entry->periodTicks = triplate.options.period * ticksPerSecond;
+    entry->firings = 0;
+    entry->canceled = false;
+
+    // Find how many ticks are left until the start time of the job
+    time_t now = time(NULL);
+    unsigned long delay = triplate.options.startTime > now ? (triplate.options.startTime - now) * ticksPerSecond : 0;
+
+    // Spread the recurring jobs over their period
+    if (entry->periodTicks > 0) {
+        delay += std::hash<std::string>()(triplate.jobID) % entry->periodTicks;
+    }
+
+    pthread_mutex_lock(&Server::Process::mutex_timers);
+
+    entry->expiry = Timers::Wheel::currentTick + (delay > 0 ? delay : 1);
+    Timers::Wheel::entries[triplate.jobID] = entry;
+    Timers::Wheel::place(entry);
+
+    pthread_mutex_unlock(&Server::Process::mutex_timers);
+
+}
+
+/**
+ * @brief Advances the wheel by a single tick and returns the jobs that became due. A recurring
+ * job is returned as a new job 'job_N@k', where k counts its firings, and it is placed back in
+ * the wheel for its next period.
+ * 
+ * @param dueJobs the triplates of the jobs that are due on this tick
+*/
+void Timers::Wheel::advance(std::vector<CC::JobTriplate>& dueJobs) {
+
+    pthread_mutex_lock(&Server::Process::mutex_timers);
+
+    unsigned long tick = ++Timers::Wheel::currentTick;
+
+    // Cascade the next slot of every level that the levels below it have completed a turn for
+    for (unsigned int level = TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+
+        if ((tick & ((1UL << (TIMER_WHEEL_SLOT_BITS * level)) - 1)) != 0) {
+            continue;
+        }
+
+        std::vector<Timers::Entry*> cascaded;
+        cascaded.swap(Timers::Wheel::slots[level][(tick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK]);
+
+        for (unsigned int i = 0; i < cascaded.size(); i++) {
+            Timers::Wheel::place(cascaded[i]);
+        }
+
+    }
+
+    // Take every entry of the due slot of the lowest level
+    std::vector<Timers::Entry*> due;
+    due.swap(Timers::Wheel::slots[0][tick & TIMER_WHEEL_SLOT_MASK]);
+
+    for (unsigned int i = 0; i < due.size(); i++) {
+
+        Timers::Entry* entry = due[i];
+
+        if (entry->canceled) {
+            delete entry;
+            continue;
+        }
+
+        CC::JobTriplate job = entry->triplate;
+        job.options.startTime = 0;
+        job.options.period = 0;
+
+        // A job that runs once leaves the wheel, while a recurring one is placed back for its next period
+        if (entry->periodTicks == 0) {
+            Timers::Wheel::entries.erase(entry->triplate.jobID);
+            delete entry;
+        } else {
+            job.jobID += "@" + std::to_string(++entry->firings);
+            entry->expiry += entry->periodTicks;
+            Timers::Wheel::place(entry);
+        }
+
+        dueJobs.push_back(job);
+
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_timers);
+
+}
+
+/**
+ * @brief Searches for the scheduled job with the specific job ID and if it is found, it
+ * removes it from the wheel.
+ * 
+ * @param jobID the job ID of the job to remove
+ * @param triplate the triplate that has been removed
+ * 
+ * @return true if the job ID was found, false otherwise
+*/
+bool Timers::Wheel::cancel(const std::string jobID, CC::JobTriplate& triplate) {
+
+    pthread_mutex_lock(&Server::Process::mutex_timers);
+
+    std::map<std::string, Timers::Entry*>::iterator it = Timers::Wheel::entries.find(jobID);
+    bool found = it != Timers::Wheel::entries.end();
+
+    // The entry is only marked, and it is deleted when its slot is reached
+    if (found) {
+        triplate = it->second->triplate;
+        it->second->canceled = true;
+        Timers::Wheel::entries.erase(it);
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_timers);
+
+    return found;
+
+}
+
+/**
+ * @brief Removes every scheduled job of the wheel.
+ * 
+ * @param triplates the triplates of the jobs that were removed
+*/
+void Timers::Wheel::removeAll(std::vector<CC::JobTriplate>& triplates) {
+
+    pthread_mutex_lock(&Server::Process::mutex_timers);
+
+    for (auto& entry : Timers::Wheel::entries) {
+        triplates.push_back(entry.second->triplate);
+    }
+    Timers::Wheel::entries.clear();
+
+    // Free every entry still placed in a slot, including the canceled ones
+    for (unsigned int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (unsigned int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+
+            for (unsigned int i = 0; i < Timers::Wheel::slots[level][slot].size(); i++) {
+                delete Timers::Wheel::slots[level][slot][i];
+            }
+            Timers::Wheel::slots[level][slot].clear();
+
+        }
+    }
+
+    pthread_mutex_unlock(&Server::Process::mutex_timers);
+
+}
@@ -0,0 +1,258 @@
+/* Filename: lzCodec.cpp */
+
+#include <string.h>
+#include <stdint.h>
+#include <vector>
+#include "../../include/lzCodec.h"
+
+#define LZ_MARKER "\x00LZ1"       // The start of every compressed message
+#define LZ_MARKER_SIZE (4)
+#define LZ_HEADER_SIZE (LZ_MARKER_SIZE + sizeof(uint64_t))
+#define LZ_MIN_MATCH (4)           // The shortest match worth an offset
+#define LZ_MAX_OFFSET (65535)      // The farthest back a match can be
+#define LZ_HASH_BITS (14)
+
+/* namespace alias */
+namespace Lz = Application_Job_Commander_Client::Application_Lz_Codec;
+
+/**
+ * @brief Supporting function that reads four bytes at the given position.
+ *
+ * @param position the position of the bytes
+ *
+ * @return the four bytes as a number
+*/
+static uint32_t read32(const char* position) {
+
+    uint32_t value;
+    memcpy(&value, position, sizeof(uint32_t));
+    return value;
+
+}
+
+/**
+ * @brief Supporting function that writes a length that did not fit in its token, as a run of
+ * 255 bytes followed by the remainder.
+ *
+ * @param length the rest of the length
+ * @param compressed the compressed bytes
+*/
+static void writeLength(size_t length, std::string& compressed) {
+
+    while (length >= 255) {
+        compressed += (char)255;
+        length -= 255;
+    }
+    compressed += (char)length;
+
+}
+
+/**
+ * @brief Supporting function that reads a length that did not fit in its token.
+ *
+ * @param input the compressed bytes
+ * @param inputSize the number of compressed bytes
+ * @param position the position to read from, moved past the length
+ * @param length the length, which the rest of it is added to
+ *
+ * @return true if the length was read, false if the bytes ended before it
+*/
+static bool readLength(const unsigned char* input, const size_t inputSize, size_t& position, size_t& length) {
+
+    unsigned char byte;
+
+    do {
+        if (position >= inputSize) return false;
+        byte = input[position++];
+        length += byte;
+    } while (byte == 255);
+
+    return true;
+
+}
+
+/**
+ * @brief Supporting function that writes a sequence: its token, its literals and, unless it is the
+ * last sequence, the offset and the length of its match.
+ *
+ * @param literals the literal bytes
+ * @param literalCount the number of literal bytes
+ * @param offset the distance back to the match, 0 for the last sequence
+ * @param matchLength the length of the match
+ * @param compressed the compressed bytes
+*/
+static void writeSequence(const char* literals, const size_t literalCount, const size_t offset, const size_t matchLength, std::string& compressed) {
+
+    size_t extraMatch = offset > 0 ? matchLength - LZ_MIN_MATCH : 0;
+
+    compressed += (char)(((literalCount < 15 ? literalCount : 15) << 4) | (extraMatch < 15 ? extraMatch : 15));
+
+    if (literalCount >= 15) writeLength(literalCount - 15, compressed);
+    compressed.append(literals, literalCount);
+
+    if (offset == 0) return;
+
+    compressed += (char)(offset & 0xFF);
+    compressed += (char)(offset >> 8);
+
+    if (extraMatch >= 15) writeLength(extraMatch - 15, compressed);
+
+}
+
+/**
+ * @brief Compresses the given bytes.
+ *
+ * @param input the bytes to compress
+ * @param inputSize the number of bytes
+ * @param compressed the compressed bytes, appended to what it already holds
+*/
+void Lz::Codec::compress(const char* input, const size_t inputSize, std::string& compressed) {
+
+    // The last position every four bytes were seen at, plus one so that zero means never
+    std::vector<uint32_t> table(1 << LZ_HASH_BITS, 0);
+
+    size_t anchor = 0, position = 0;
+
+    while (position + LZ_MIN_MATCH <= inputSize) {
+
+        uint32_t sequence = read32(input + position);
+        uint32_t hash = (sequence * 2654435761U) >> (32 - LZ_HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = position + 1;
+
+        if (candidate == 0 || position - (candidate - 1) > LZ_MAX_OFFSET || read32(input + candidate - 1) != sequence) {
+            position++;
+            continue;
+        }
+        candidate--;
+
+        size_t length = LZ_MIN_MATCH;
+        while (position + length < inputSize && input[candidate + length] == input[position + length]) {
+            length++;
+        }
+
+        writeSequence(input + anchor, position - anchor, position - candidate, length, compressed);
+
+        position += length;
+        anchor = position;
+
+    }
+
+    // The last sequence has only literals, and it is always written so the decoder knows where to stop
+    writeSequence(input + anchor, inputSize - anchor, 0, 0, compressed);
+
+}
+
+/**
+ * @brief Decompresses the given bytes, checking that they are well formed.
+ *
+ * @param input the compressed bytes
+ * @param inputSize the number of compressed bytes
+ * @param originalSize the size of the original bytes
+ * @param output the original bytes
+ *
+ * @return true if the bytes were decompressed, false if they are corrupted
+*/
+bool Lz::Codec::decompress(const char* input, const size_t inputSize, const size_t originalSize, std::string& output) {
+
+    const unsigned char* bytes = (const unsigned char*)input;
+    size_t position = 0;
+
+    // No sequence expands to more than about 255 times its size, so a bigger original size is corrupted
+    if (originalSize / 255 > inputSize) return false;
+
+    output.clear();
+    output.reserve(originalSize);
+
+    while (position < inputSize) {
+
+        unsigned char token = bytes[position++];
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(bytes, inputSize, position, literalCount)) return false;
+        if (literalCount > inputSize - position || output.size() + literalCount > originalSize) return false;
+
+        output.append(input + position, literalCount);
+        position += literalCount;
+
+        // Only the last sequence ends right after its literals
+        if (position == inputSize) break;
+
+        if (position + 2 > inputSize) return false;
+        size_t offset = bytes[position] | (bytes[position + 1] << 8);
+        position += 2;
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !readLength(bytes, inputSize, position, matchLength)) return false;
+        matchLength += LZ_MIN_MATCH;
+
+        if (offset == 0 || offset > output.size() || output.size() + matchLength > originalSize) return false;
+
+        // The match may overlap the bytes it writes, so it is copied one byte at a time
+        size_t from = output.size() - offset;
+        for (size_t i = 0; i < matchLength; i++) {
+            output += output[from + i];
+        }
+
+    }
+
+    return output.size() == originalSize;
+
+}
+
+/**
+ * @brief Compresses a message into a compressed message, if it gets any smaller.
+ *
+ * @param message the message to compress
+ * @param compressed the compressed message
+ *
+ * @return true if the message was compressed, false if it does not get smaller
+*/
+bool Lz::Codec::pack(const std::string& message, std::string& compressed) {
+
+    uint64_t originalSize = message.size();
+
+    compressed.assign(LZ_MARKER, LZ_MARKER_SIZE);
+    compressed.append((const char*)&originalSize, sizeof(uint64_t));
+
+    Lz::Codec::compress(message.data(), message.size(), compressed);
+
+    return compressed.size() < message.size();
+
+}
+
+/**
+ * @brief Returns whether the given message is a compressed message.
+ *
+ * @param message the message received
+ *
+ * @return true if the message is compressed, false otherwise
+*/
+bool Lz::Codec::isPacked(const std::string& message) {
+
+    return message.size() >= LZ_HEADER_SIZE && message.compare(0, LZ_MARKER_SIZE, LZ_MARKER, LZ_MARKER_SIZE) == 0;
+
+}
+
+/**
+ * @brief Replaces a compressed message with the original message.
+ *
+ * @param message the compressed message, which becomes the original message
+ *
+ * @return true if the message was decompressed, false if it is corrupted
+*/
+bool Lz::Codec::unpack(std::string& message) {
+
+    uint64_t originalSize;
+    memcpy(&originalSize, message.data() + LZ_MARKER_SIZE, sizeof(uint64_t));
+
+    std::string original;
+    if (!Lz::Codec::decompress(message.data() + LZ_HEADER_SIZE, message.size() - LZ_HEADER_SIZE, originalSize, original)) {
+        return false;
+    }
+
+    message.swap(original);
+
+    return true;
+
+}
@@ -0,0 +1,187 @@
+/* Filename: sha256.cpp */
+
+#include <string.h>
+#include "../../include/sha256.h"
+
+/* namespace alias */
+namespace Sha = Application_Job_Commander_Client::Application_Sha256;
+
+// The round constants, the first 32 bits of the fractional parts of the cube roots of the first 64 primes
+static const uint32_t ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/**
+ * @brief Supporting function that rotates a word to the right.
+ *
+ * @param value the word
+ * @param bits the number of bits to rotate by
+ *
+ * @return the rotated word
+*/
+static inline uint32_t rotateRight(const uint32_t value, const unsigned int bits) {
+
+    return (value >> bits) | (value << (32 - bits));
+
+}
+
+/**
+ * @brief Mixes a full block of 64 bytes into the state of the given digest.
+ *
+ * @param context the digest
+ * @param block the block
+*/
+void Sha::Digest::transform(Context& context, const unsigned char* block) {
+
+    uint32_t schedule[64];
+
+    // The words of the block are big endian
+    for (unsigned int i = 0; i < 16; i++) {
+        schedule[i] = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16 | (uint32_t)block[4 * i + 2] << 8 | (uint32_t)block[4 * i + 3];
+    }
+
+    for (unsigned int i = 16; i < 64; i++) {
+        uint32_t s0 = rotateRight(schedule[i - 15], 7) ^ rotateRight(schedule[i - 15], 18) ^ (schedule[i - 15] >> 3);
+        uint32_t s1 = rotateRight(schedule[i - 2], 17) ^ rotateRight(schedule[i - 2], 19) ^ (schedule[i - 2] >> 10);
+        schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+    }
+
+    uint32_t a = context.state[0], b = context.state[1], c = context.state[2], d = context.state[3];
+    uint32_t e = context.state[4], f = context.state[5], g = context.state[6], h = context.state[7];
+
+    for (unsigned int i = 0; i < 64; i++) {
+
+        uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+        uint32_t choice = (e & f) ^ (~e & g);
+        uint32_t first = h + s1 + choice + ROUND_CONSTANTS[i] + schedule[i];
+        uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+        uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t second = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + first;
+        d = c;
+        c = b;
+        b = a;
+        a = first + second;
+
+    }
+
+    context.state[0] += a; context.state[1] += b; context.state[2] += c; context.state[3] += d;
+    context.state[4] += e; context.state[5] += f; context.state[6] += g; context.state[7] += h;
+
+}
+
+/**
+ * @brief Starts a new digest.
+ *
+ * @param context the digest
+*/
+void Sha::Digest::init(Context& context) {
+
+    static const uint32_t initialState[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    memcpy(context.state, initialState, sizeof(initialState));
+    context.length = 0;
+    context.blockSize = 0;
+
+}
+
+/**
+ * @brief Adds the given bytes to the given digest.
+ *
+ * @param context the digest
+ * @param data the bytes
+ * @param size the number of bytes
+*/
+void Sha::Digest::update(Context& context, const char* data, size_t size) {
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    context.length += size;
+
+    // Fill the block that is not full yet first, then process the full blocks straight from the data
+    if (context.blockSize > 0) {
+
+        size_t taken = 64 - context.blockSize < size ? 64 - context.blockSize : size;
+        memcpy(context.block + context.blockSize, bytes, taken);
+        context.blockSize += taken;
+        bytes += taken;
+        size -= taken;
+
+        if (context.blockSize < 64) {
+            return;
+        }
+
+        Sha::Digest::transform(context, context.block);
+        context.blockSize = 0;
+
+    }
+
+    while (size >= 64) {
+        Sha::Digest::transform(context, bytes);
+        bytes += 64;
+        size -= 64;
+    }
+
+    memcpy(context.block, bytes, size);
+    context.blockSize = size;
+
+}
+
+/**
+ * @brief Ends the given digest.
+ *
+ * @param context the digest
+ *
+ * @return the digest as 64 lowercase hexadecimal digits
+*/
+std::string Sha::Digest::finish(Context& context) {
+
+    uint64_t bits = context.length * 8;
+
+    // The data is padded with a single set bit, zeros and its length in bits, up to a whole block
+    unsigned char padding[72] = { 0x80 };
+    size_t paddingSize = (context.blockSize < 56 ? 56 : 120) - context.blockSize;
+
+    for (unsigned int i = 0; i < 8; i++) {
+        padding[paddingSize + i] = (unsigned char)(bits >> (56 - 8 * i));
+    }
+
+    Sha::Digest::update(context, (const char*)padding, paddingSize + 8);
+
+    const char* hexDigits = "0123456789abcdef";
+    std::string digest;
+
+    for (unsigned int i = 0; i < 8; i++) {
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            digest += hexDigits[(context.state[i] >> shift) & 0xf];
+        }
+    }
+
+    return digest;
+
+}
+
+/**
+ * @brief Returns whether the given string is a digest, 64 lowercase hexadecimal digits.
+ *
+ * @param digest the string
+ *
+ * @return true if the string is a digest, false otherwise
+*/
+bool Sha::Digest::isValid(const std::string& digest) {
+
+    return digest.size() == 64 && digest.find_first_not_of("0123456789abcdef") == std::string::npos;
+
+}
@@ -1,13 +1,49 @@
 /* Filename waitingBufferQueue.cpp */
 
+#include <string.h>
 #include "../../include/waitingBufferQueue.h"
+#include "../../include/pluginJobs.h"
 
 namespace WaitingBuffer = Application_Job_Executor_Server::Application_Common_Waiting_Buffer; // namespace alias
+namespace Plugins = Application_Job_Executor_Server::Application_Plugin_Jobs; // namespace alias
+
+#define ARRAY_INDEX_PLACEHOLDER "{i}"
+#define HEAD_JOB_MAX_SKIPS (8) // The times the most urgent job may be skipped before the resources are kept for it
 
 // Initialize the static members
 size_t WaitingBuffer::Queue::capacity;
 size_t WaitingBuffer::Queue::size;
 std::vector<CC::JobTriplate> WaitingBuffer::Queue::buffer;
+std::string WaitingBuffer::Queue::headJobID;
+unsigned int WaitingBuffer::Queue::headSkips = 0;
+
+/**
+ * @brief Supporting function that creates the concrete task with the next index of the given
+ * job array. The task gets the job ID 'job_N[i]' and every '{i}' of the job template is replaced
+ * by the index of the task.
+ * 
+ * @param array the job array to expand
+ * 
+ * @return the job triplate of the next task of the job array
+*/
+static CC::JobTriplate expandNextArrayTask(const CC::JobTriplate& array) {
+
+    CC::JobTriplate task = array;
+    std::string index = std::to_string(array.arrayNext);
+
+    task.jobID = array.jobID + "[" + index + "]";
+    task.isArray = false;
+
+    // Replace every placeholder of the template with the index
+    size_t pos = 0;
+    while ((pos = task.job.find(ARRAY_INDEX_PLACEHOLDER, pos)) != std::string::npos) {
+        task.job.replace(pos, strlen(ARRAY_INDEX_PLACEHOLDER), index);
+        pos += index.size();
+    }
+
+    return task;
+
+}
 
 /**
  * @brief Returns the maximum size of the waiting buffer queue.
@@ -50,18 +86,32 @@ void WaitingBuffer::Queue::setCapacity(const size_t capacity) {
  * 
  * @return true if the insertion was successfull, false otherwise
 */
-void WaitingBuffer::Queue::insertJobTriplate(const CC::JobTriplate triplate) {
+bool WaitingBuffer::Queue::insertJobTriplate(const CC::JobTriplate triplate) {
 
     // Try to insert the triplate and check if the buffer is full
-    if (WaitingBuffer::Queue::size < WaitingBuffer::Queue::capacity) {
-
-        WaitingBuffer::Queue::buffer.push_back(triplate);
-        WaitingBuffer::Queue::size++;
-    
-    } else {
-        std::cerr << "Cannot insert job triplate. Waiting Buffer is full." << std::endl;
+    if (WaitingBuffer::Queue::isFull()) {
+        return false;
     }
 
+    WaitingBuffer::Queue::buffer.push_back(triplate);
+    WaitingBuffer::Queue::size++;
+
+    return true;
+
+}
+
+/**
+ * @brief Inserts a job triplate to the very end of the waiting buffer queue, even if
+ * the queue is full. It is used for jobs that have already been admitted by a controller
+ * thread, such as jobs released from the dependency graph.
+ * 
+ * @param triplate the triplate to insert
+*/
+void WaitingBuffer::Queue::appendJobTriplate(const CC::JobTriplate triplate) {
+
+    WaitingBuffer::Queue::buffer.push_back(triplate);
+    WaitingBuffer::Queue::size++;
+
 }
 
 /**
@@ -80,6 +130,123 @@ CC::JobTriplate WaitingBuffer::Queue::getJobTriplate(void) {
     return triplate;
 }
 
+/**
+ * @brief Searches the waiting buffer queue for the job triplate with the highest priority
+ * whose requested resources fit in the given free resources, and if it is found, it removes
+ * it from the queue. Among jobs of the same priority the oldest one is selected. Jobs that do
+ * not fit are skipped, so that smaller jobs behind them can fill the machine, but once the most
+ * urgent process job has been skipped too many times no other process job is selected, so
+ * that the resources it needs are freed for it. If the selected triplate is a job array, its
+ * next task is returned and the array is removed only when its last task has been handed out.
+ * 
+ * @param freeCpus the number of free CPUs
+ * @param freeMemory the amount of free memory in MB
+ * @param processSlotFree true if a process job can start
+ * @param pluginSlotFree true if a plugin job can start, plugin jobs need no other resources
+ * @param jobTriplate the triplate that has been removed
+ * 
+ * @return true if a fitting job triplate was found, false otherwise
+*/
+bool WaitingBuffer::Queue::removeFittingJobTriplate(const unsigned int freeCpus, const unsigned long freeMemory, const bool processSlotFree, const bool pluginSlotFree, CC::JobTriplate& jobTriplate) {
+
+    int selected = -1, head = -1;
+
+    // Find the most urgent process job, whether it fits or not
+    for (unsigned int i = 0; i < WaitingBuffer::Queue::size; i++) {
+        const CC::JobTriplate& triplate = WaitingBuffer::Queue::buffer[i];
+        if (!Plugins::Registry::isPluginJob(triplate.job) && (head == -1 || triplate.options.priority > WaitingBuffer::Queue::buffer[head].options.priority)) {
+            head = i;
+        }
+    }
+
+    // A head job that has been skipped too many times keeps the resources that are freed for itself
+    bool reserved = head != -1 && WaitingBuffer::Queue::buffer[head].jobID == WaitingBuffer::Queue::headJobID &&
+        WaitingBuffer::Queue::headSkips >= HEAD_JOB_MAX_SKIPS;
+
+    // Search for the most urgent job whose request fits in the free resources
+    for (unsigned int i = 0; i < WaitingBuffer::Queue::size; i++) {
+
+        const CC::JobTriplate& triplate = WaitingBuffer::Queue::buffer[i];
+
+        if (Plugins::Registry::isPluginJob(triplate.job)) {
+            if (!pluginSlotFree) continue;
+        }
+        else if (!processSlotFree || triplate.options.cpus > freeCpus || triplate.options.memory > freeMemory || (reserved && (int)i != head)) {
+            continue;
+        }
+
+        if (selected == -1 || triplate.options.priority > WaitingBuffer::Queue::buffer[selected].options.priority) {
+            selected = i;
+        }
+
+    }
+
+    if (selected == -1) {
+        return false;
+    }
+
+    CC::JobTriplate& triplate = WaitingBuffer::Queue::buffer[selected];
+
+    // Count the times the head job is skipped for a process job that fits, until it is selected itself
+    if (selected == head) {
+        WaitingBuffer::Queue::headJobID.clear();
+        WaitingBuffer::Queue::headSkips = 0;
+    }
+    else if (head != -1 && !Plugins::Registry::isPluginJob(triplate.job)) {
+        if (WaitingBuffer::Queue::buffer[head].jobID != WaitingBuffer::Queue::headJobID) {
+            WaitingBuffer::Queue::headJobID = WaitingBuffer::Queue::buffer[head].jobID;
+            WaitingBuffer::Queue::headSkips = 0;
+        }
+        WaitingBuffer::Queue::headSkips++;
+    }
+
+    // A job array stays in the queue until its last task has been handed out
+    if (triplate.isArray) {
+
+        jobTriplate = expandNextArrayTask(triplate);
+        if (++triplate.arrayNext <= triplate.arrayLast) {
+            return true;
+        }
+
+    } else {
+        jobTriplate = triplate;
+    }
+
+    // Otherwise remove it
+    WaitingBuffer::Queue::buffer.erase(WaitingBuffer::Queue::buffer.begin() + selected);
+    WaitingBuffer::Queue::size--;
+
+    return true;
+
+}
+
+/**
+ * @brief Returns the job triplate with the highest priority in the waiting buffer queue,
+ * without removing it. Among jobs of the same priority the oldest one is returned.
+ * 
+ * @param jobTriplate the triplate with the highest priority
+ * 
+ * @return true if the queue is not empty, false otherwise
+*/
+bool WaitingBuffer::Queue::peekHighestPriorityJobTriplate(CC::JobTriplate& jobTriplate) {
+
+    if (WaitingBuffer::Queue::size == 0) {
+        return false;
+    }
+
+    unsigned int selected = 0;
+    for (unsigned int i = 1; i < WaitingBuffer::Queue::size; i++) {
+        if (WaitingBuffer::Queue::buffer[i].options.priority > WaitingBuffer::Queue::buffer[selected].options.priority) {
+            selected = i;
+        }
+    }
+
+    jobTriplate = WaitingBuffer::Queue::buffer[selected];
+
+    return true;
+
+}
+
 /**
  * @brief Searches for the job triplate with the specific job ID and if it is
  * found, it removes it from the waiting buffer queue.
@@ -127,13 +294,14 @@ CC::JobTriplate WaitingBuffer::Queue::at(const unsigned int index) {
 }
 
 /**
- * @brief Returns whether the waiting buffer queue is full or not.
+ * @brief Returns whether the waiting buffer queue is full or not. The jobs appended past the
+ * capacity keep it full until enough of them have been taken out.
  * 
  * @return true if the queue is full, false otherwise
 */
 bool WaitingBuffer::Queue::isFull(void) {
 
-    return WaitingBuffer::Queue::size == WaitingBuffer::Queue::capacity;
+    return WaitingBuffer::Queue::size >= WaitingBuffer::Queue::capacity;
 
 }
 
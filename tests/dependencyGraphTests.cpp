@@ -0,0 +1,167 @@
+/* Filename: dependencyGraphTests.cpp */
+
+#include <algorithm>
+#include "unitTests.h"
+#include "../include/dependencyGraph.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+namespace Dependencies = Application_Job_Executor_Server::Application_Job_Dependencies;
+
+/**
+ * @brief Supporting function that returns the sorted job IDs of the given triplates.
+ * 
+ * @param triplates the triplates
+ * 
+ * @return the job IDs of the triplates
+*/
+static std::vector<std::string> getJobIDs(const std::vector<CC::JobTriplate>& triplates) {
+
+    std::vector<std::string> jobIDs;
+    for (unsigned int i = 0; i < triplates.size(); i++) {
+        jobIDs.push_back(triplates[i].jobID);
+    }
+    std::sort(jobIDs.begin(), jobIDs.end());
+
+    return jobIDs;
+
+}
+
+/**
+ * @brief Supporting function that returns whether the job with the given job ID is in the given state.
+ * 
+ * @param jobID the job ID of the job
+ * @param expected the state the job should be in
+ * 
+ * @return true if the job is in the state, false otherwise
+*/
+static bool isInState(const std::string jobID, const Dependencies::State expected) {
+
+    Dependencies::State state;
+    return Dependencies::Graph::getState(jobID, state) && state == expected;
+
+}
+
+/**
+ * @brief Checks that a job waiting for two others is released by the end of the last of them.
+*/
+static void testDiamond(void) {
+
+    CHECK(Dependencies::Graph::addJob(Tests::createTriplate("job_a", "ls")) == Dependencies::JDA_READY);
+    CHECK(Dependencies::Graph::addJob(Tests::createTriplate("job_b", "--after job_a ls")) == Dependencies::JDA_BLOCKED);
+    CHECK(Dependencies::Graph::addJob(Tests::createTriplate("job_c", "--after job_a ls")) == Dependencies::JDA_BLOCKED);
+    CHECK(Dependencies::Graph::addJob(Tests::createTriplate("job_d", "--after job_b,job_c ls")) == Dependencies::JDA_BLOCKED);
+    CHECK(Dependencies::Graph::addJob(Tests::createTriplate("job_e", "--after job_a,job_unknown ls")) == Dependencies::JDA_UNKNOWN);
+
+    std::vector<CC::JobTriplate> released, canceled;
+    Dependencies::Graph::finishJob("job_a", true, released, canceled);
+    CHECK(getJobIDs(released) == std::vector<std::string>({ "job_b", "job_c" }));
+    CHECK(canceled.empty());
+
+    released.clear();
+    Dependencies::Graph::finishJob("job_b", true, released, canceled);
+    CHECK(released.empty());
+
+    Dependencies::Graph::finishJob("job_c", true, released, canceled);
+    CHECK(getJobIDs(released) == std::vector<std::string>({ "job_d" }));
+    CHECK(isInState("job_c", Dependencies::JDS_SUCCEEDED) && isInState("job_d", Dependencies::JDS_PENDING));
+
+    // A job whose dependencies have all succeeded runs right away
+    CHECK(Dependencies::Graph::addJob(Tests::createTriplate("job_f", "--after job_a,job_c ls")) == Dependencies::JDA_READY);
+
+}
+
+/**
+ * @brief Checks that a failure cancels every job that depends on the failed job, directly or not.
+*/
+static void testFailureCascade(void) {
+
+    Dependencies::Graph::addJob(Tests::createTriplate("job_g", "ls"));
+    Dependencies::Graph::addJob(Tests::createTriplate("job_h", "--after job_g ls"));
+    Dependencies::Graph::addJob(Tests::createTriplate("job_i", "--after job_h ls"));
+    Dependencies::Graph::addJob(Tests::createTriplate("job_j", "ls"));
+    Dependencies::Graph::addJob(Tests::createTriplate("job_k", "--after job_j,job_i ls"));
+
+    std::vector<CC::JobTriplate> released, canceled;
+    Dependencies::Graph::finishJob("job_g", false, released, canceled);
+    CHECK(released.empty());
+    CHECK(getJobIDs(canceled) == std::vector<std::string>({ "job_h", "job_i", "job_k" }));
+    CHECK(isInState("job_g", Dependencies::JDS_FAILED) && isInState("job_k", Dependencies::JDS_FAILED));
+
+    // The canceled jobs are not released by their other dependencies, and nothing new can wait for them
+    canceled.clear();
+    Dependencies::Graph::finishJob("job_j", true, released, canceled);
+    CHECK(released.empty() && canceled.empty());
+    CHECK(Dependencies::Graph::addJob(Tests::createTriplate("job_l", "--after job_i ls")) == Dependencies::JDA_FAILED);
+
+}
+
+/**
+ * @brief Checks that a job array succeeds with its last task and fails with its first failed task.
+*/
+static void testJobArrays(void) {
+
+    CC::JobTriplate array = Tests::createTriplate("job_m", "echo {i}");
+    array.isArray = true;
+    array.arrayNext = 1;
+    array.arrayLast = 3;
+    Dependencies::Graph::addJob(array);
+    Dependencies::Graph::addJob(Tests::createTriplate("job_n", "--after job_m ls"));
+
+    std::vector<CC::JobTriplate> released, canceled;
+    Dependencies::Graph::finishJob("job_m[1]", true, released, canceled);
+    Dependencies::Graph::finishJob("job_m[3]", true, released, canceled);
+    CHECK(released.empty() && isInState("job_m", Dependencies::JDS_PENDING));
+    Dependencies::Graph::finishJob("job_m[2]", true, released, canceled);
+    CHECK(getJobIDs(released) == std::vector<std::string>({ "job_n" }));
+    CHECK(isInState("job_m", Dependencies::JDS_SUCCEEDED));
+
+    array.jobID = "job_o";
+    Dependencies::Graph::addJob(array);
+    Dependencies::Graph::addJob(Tests::createTriplate("job_p", "--after job_o ls"));
+
+    released.clear();
+    Dependencies::Graph::finishJob("job_o[2]", false, released, canceled);
+    CHECK(getJobIDs(canceled) == std::vector<std::string>({ "job_p" }));
+    Dependencies::Graph::finishJob("job_o[1]", true, released, canceled);
+    Dependencies::Graph::finishJob("job_o[3]", true, released, canceled);
+    CHECK(released.empty() && isInState("job_o", Dependencies::JDS_FAILED));
+
+}
+
+/**
+ * @brief Checks that blocked jobs can be removed, one at a time or all together.
+*/
+static void testRemovedJobs(void) {
+
+    Dependencies::Graph::addJob(Tests::createTriplate("job_q", "ls"));
+    Dependencies::Graph::addJob(Tests::createTriplate("job_r", "--after job_q ls"));
+    Dependencies::Graph::addJob(Tests::createTriplate("job_s", "--after job_q ls"));
+
+    CC::JobTriplate removed;
+    CHECK(Dependencies::Graph::removeBlockedJob("job_r", removed) && removed.jobID == "job_r");
+    CHECK(!Dependencies::Graph::removeBlockedJob("job_r", removed));
+    CHECK(!Dependencies::Graph::removeBlockedJob("job_q", removed));
+
+    std::vector<CC::JobTriplate> removedAll;
+    Dependencies::Graph::removeAllBlockedJobs(removedAll);
+    CHECK(getJobIDs(removedAll) == std::vector<std::string>({ "job_s" }));
+
+    // Removed jobs are not released when their dependency succeeds
+    std::vector<CC::JobTriplate> released, canceled;
+    Dependencies::Graph::finishJob("job_q", true, released, canceled);
+    CHECK(released.empty());
+
+}
+
+/**
+ * @brief Runs the tests of the dependency graph.
+*/
+void Tests::testDependencyGraph(void) {
+
+    testDiamond();
+    testFailureCascade();
+    testJobArrays();
+    testRemovedJobs();
+
+}
@@ -0,0 +1,117 @@
+/* Filename: lzCodecTests.cpp */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "unitTests.h"
+#include "../include/lzCodec.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+namespace Lz = Application_Job_Commander_Client::Application_Lz_Codec;
+
+/**
+ * @brief Supporting function that packs and unpacks a message, whether it got smaller or not.
+ * 
+ * @param message the message to pack
+ * 
+ * @return true if the message unpacked is the original message, false otherwise
+*/
+static bool roundTrips(const std::string& message) {
+
+    std::string packed;
+    Lz::Codec::pack(message, packed);
+
+    return Lz::Codec::isPacked(packed) && Lz::Codec::unpack(packed) && packed == message;
+
+}
+
+/**
+ * @brief Checks that repetitive text gets smaller and comes back the same.
+*/
+static void testRepetitiveText(void) {
+
+    std::string message;
+    for (unsigned int i = 0; i < 5000; i++) {
+        message += "line " + std::to_string(i % 100) + " of the output of a job\n";
+    }
+
+    std::string packed;
+    CHECK(Lz::Codec::pack(message, packed));
+    CHECK(packed.size() < message.size() / 4);
+    CHECK(roundTrips(message));
+
+}
+
+/**
+ * @brief Checks the messages that are too short or too random to have any match.
+*/
+static void testWithoutMatches(void) {
+
+    CHECK(roundTrips(""));
+    CHECK(roundTrips("a"));
+    CHECK(roundTrips("abc"));
+
+    std::string random;
+    srand(42);
+    for (unsigned int i = 0; i < 100000; i++) {
+        random += (char)(rand() & 0xFF);
+    }
+    CHECK(roundTrips(random));
+
+}
+
+/**
+ * @brief Checks the matches that overlap the bytes they copy, and the ones at the edge of the window.
+*/
+static void testMatchEdges(void) {
+
+    CHECK(roundTrips(std::string(100000, 'x')));
+    CHECK(roundTrips(std::string(1000, '\0')));
+    CHECK(roundTrips("abababababababababababababababababab"));
+
+    // A match just within the farthest offset, and one just beyond it
+    std::string block;
+    srand(7);
+    for (unsigned int i = 0; i < 1000; i++) {
+        block += (char)(rand() & 0xFF);
+    }
+    CHECK(roundTrips(block + std::string(65535 - block.size(), '-') + block));
+    CHECK(roundTrips(block + std::string(65536 - block.size(), '-') + block));
+    CHECK(roundTrips(block + std::string(200000, '-') + block));
+
+}
+
+/**
+ * @brief Checks that plain messages are told apart from packed ones, and that a corrupted packed
+ * message is rejected.
+*/
+static void testPackedMessages(void) {
+
+    CHECK(!Lz::Codec::isPacked("JOB <job_1, ls> SUBMITTED"));
+    CHECK(!Lz::Codec::isPacked(""));
+
+    std::string message(10000, 'y');
+    std::string packed;
+    CHECK(Lz::Codec::pack(message, packed));
+
+    std::string truncated = packed.substr(0, packed.size() - 2);
+    CHECK(!Lz::Codec::unpack(truncated));
+
+    std::string bigger = packed;
+    uint64_t originalSize = message.size() + 1;
+    bigger.replace(4, sizeof(uint64_t), (const char*)&originalSize, sizeof(uint64_t));
+    CHECK(!Lz::Codec::unpack(bigger));
+
+}
+
+/**
+ * @brief Runs the tests of the LZ codec.
+*/
+void Tests::testLzCodec(void) {
+
+    testRepetitiveText();
+    testWithoutMatches();
+    testMatchEdges();
+    testPackedMessages();
+
+}
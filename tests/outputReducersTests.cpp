@@ -0,0 +1,106 @@
+/* Filename: outputReducersTests.cpp */
+
+#include "unitTests.h"
+#include "../include/outputReducers.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+namespace Reducers = Application_Job_Executor_Server::Application_Output_Reducers;
+
+/**
+ * @brief Supporting function that reduces the given output with the given reducer options.
+ * 
+ * @param options the reducer options, as they are given to a job
+ * @param output the output to reduce
+ * 
+ * @return the reduced output
+*/
+static std::string reduceOutput(const std::string options, const std::string output) {
+
+    std::string reduced;
+    Reducers::Reducer::reduce(Tests::createTriplate("job_reduced", options + " ls").options, output.data(), output.size(), reduced);
+
+    return reduced;
+
+}
+
+/**
+ * @brief Checks the first lines of outputs with and without a final newline.
+*/
+static void testHead(void) {
+
+    CHECK(reduceOutput("--head 2", "a\nb\nc\n") == "a\nb\n");
+    CHECK(reduceOutput("--head 1", "a\nb\nc\n") == "a\n");
+    CHECK(reduceOutput("--head 5", "a\nb\nc\n") == "a\nb\nc\n");
+    CHECK(reduceOutput("--head 5", "a\nb") == "a\nb");
+    CHECK(reduceOutput("--head 2", "") == "");
+
+}
+
+/**
+ * @brief Checks the last lines of outputs with and without a final newline.
+*/
+static void testTail(void) {
+
+    CHECK(reduceOutput("--tail 2", "a\nb\nc\n") == "b\nc\n");
+    CHECK(reduceOutput("--tail 2", "a\nb\nc") == "b\nc");
+    CHECK(reduceOutput("--tail 1", "a\nb\nc\n") == "c\n");
+    CHECK(reduceOutput("--tail 5", "a\nb\nc\n") == "a\nb\nc\n");
+    CHECK(reduceOutput("--tail 2", "\n\n\n") == "\n\n");
+    CHECK(reduceOutput("--tail 2", "") == "");
+
+}
+
+/**
+ * @brief Checks the lines kept by a fixed string and by a regular expression.
+*/
+static void testFilters(void) {
+
+    CHECK(reduceOutput("--grep err", "ok\nerror 1\nok\nerr2") == "error 1\nerr2");
+    CHECK(reduceOutput("--grep missing", "ok\nok\n") == "");
+    CHECK(reduceOutput("--grep-regex ^[0-9]+$", "12\na1\n345\n6b\n") == "12\n345\n");
+
+}
+
+/**
+ * @brief Checks that the reducers apply in order: the filter, then the head or the tail, and then
+ * the byte limit.
+*/
+static void testCombinedReducers(void) {
+
+    std::string output = "line 1 ok\nline 2 error\nline 3 ok\nline 4 error\nline 5 error\n";
+
+    CHECK(reduceOutput("--grep error --head 2", output) == "line 2 error\nline 4 error\n");
+    CHECK(reduceOutput("--grep error --tail 1", output) == "line 5 error\n");
+    CHECK(reduceOutput("--tail 2 --max-bytes 6", output) == "line 4");
+    CHECK(reduceOutput("--max-bytes 3", "abcdef") == "abc");
+    CHECK(reduceOutput("--max-bytes 10", "abc") == "abc");
+
+}
+
+/**
+ * @brief Checks which reducers are enabled and which can be applied.
+*/
+static void testValidReducers(void) {
+
+    CHECK(!Reducers::Reducer::isEnabled(Tests::createTriplate("job_reduced", "ls").options));
+    CHECK(Reducers::Reducer::isEnabled(Tests::createTriplate("job_reduced", "--max-bytes 1 ls").options));
+
+    CHECK(Reducers::Reducer::isValid(Tests::createTriplate("job_reduced", "--grep-regex ^a+ --tail 3 ls").options));
+    CHECK(!Reducers::Reducer::isValid(Tests::createTriplate("job_reduced", "--head 1 --tail 1 ls").options));
+    CHECK(!Reducers::Reducer::isValid(Tests::createTriplate("job_reduced", "--grep-regex ( ls").options));
+
+}
+
+/**
+ * @brief Runs the tests of the output reducers.
+*/
+void Tests::testOutputReducers(void) {
+
+    testHead();
+    testTail();
+    testFilters();
+    testCombinedReducers();
+    testValidReducers();
+
+}
@@ -0,0 +1,158 @@
+/* Filename: resultCacheTests.cpp */
+
+#include <ctime>
+#include <fstream>
+#include <unistd.h>
+#include "unitTests.h"
+#include "../include/resultCache.h"
+#include "../include/jobExecutorServerProcess.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+namespace Server = Application_Job_Executor_Server;
+namespace Results = Application_Job_Executor_Server::Application_Result_Cache;
+
+/**
+ * @brief Supporting function that sets the budget and the time to live of the result cache.
+ * 
+ * @param memory the memory in MB the stored outputs can take
+ * @param timeToLive the seconds an output is reused for
+*/
+static void setCacheOptions(const unsigned long memory, const unsigned long timeToLive) {
+
+    Server::Options options = Server::Options();
+    options.resultCacheMemory = memory;
+    options.resultTimeToLive = timeToLive;
+
+    Server::Process::destroy();
+    Server::Process::init(0, 1, 1, options);
+
+}
+
+/**
+ * @brief Supporting function that stores an output of the given size for a job that started now.
+ * 
+ * @param job the job string
+ * @param size the size of the output
+ * @param fill the byte the output is made of
+*/
+static void storeOutput(const std::string& job, const size_t size, const char fill) {
+
+    std::string output(size, fill);
+    Results::Cache::store(job, false, time(NULL), output.data(), output.size());
+
+}
+
+/**
+ * @brief Checks that jobs are told apart by their arguments but not by their whitespace.
+*/
+static void testLookup(void) {
+
+    setCacheOptions(1, 0);
+
+    storeOutput("  echo   hello world ", 10, 'h');
+
+    std::string output;
+    CHECK(Results::Cache::lookup("echo hello world", output) && output == std::string(10, 'h'));
+    CHECK(!Results::Cache::lookup("echo hello", output));
+    CHECK(!Results::Cache::lookup("echo helloworld", output));
+
+    // A newer output of the same job replaces the older one
+    storeOutput("echo hello world", 5, 'n');
+    CHECK(Results::Cache::lookup("echo hello world", output) && output == std::string(5, 'n'));
+
+}
+
+/**
+ * @brief Checks that the least recently used outputs are dropped first to keep within the budget,
+ * and that an output bigger than the whole budget is not stored at all.
+*/
+static void testLeastRecentlyUsed(void) {
+
+    const size_t third = 400 * 1024;
+    setCacheOptions(1, 0);
+
+    storeOutput("job one", third, '1');
+    storeOutput("job two", third, '2');
+
+    // Using the first output makes the second one the least recently used
+    std::string output;
+    CHECK(Results::Cache::lookup("job one", output));
+    storeOutput("job three", third, '3');
+
+    CHECK(Results::Cache::lookup("job one", output) && output == std::string(third, '1'));
+    CHECK(!Results::Cache::lookup("job two", output));
+    CHECK(Results::Cache::lookup("job three", output) && output == std::string(third, '3'));
+
+    storeOutput("job huge", 2 * 1024 * 1024, 'h');
+    CHECK(!Results::Cache::lookup("job huge", output));
+    CHECK(Results::Cache::lookup("job one", output) && Results::Cache::lookup("job three", output));
+
+    unsigned long hits, misses, entries, bytes;
+    Results::Cache::getStats(hits, misses, entries, bytes);
+    CHECK(bytes <= 1024 * 1024);
+
+}
+
+/**
+ * @brief Checks that an output is no longer used once its time to live has passed.
+*/
+static void testTimeToLive(void) {
+
+    setCacheOptions(1, 1);
+
+    unsigned long hits, misses, entries, bytes, entriesBefore, bytesBefore;
+    Results::Cache::getStats(hits, misses, entriesBefore, bytesBefore);
+
+    storeOutput("job expiring", 10, 'e');
+    sleep(2);
+
+    std::string output;
+    CHECK(!Results::Cache::lookup("job expiring", output));
+
+    // The expired output is dropped as well
+    Results::Cache::getStats(hits, misses, entries, bytes);
+    CHECK(entries == entriesBefore && bytes == bytesBefore);
+
+}
+
+/**
+ * @brief Checks that an output that depends on its input files is only used while they are unchanged.
+*/
+static void testInputFiles(void) {
+
+    setCacheOptions(1, 0);
+
+    char path[] = "/tmp/resultCacheTestsXXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd != -1);
+    close(fd);
+    std::ofstream(path) << "first";
+
+    // The file was written before the job started, so the output is stored
+    std::string job = std::string("cat ") + path, output;
+    Results::Cache::store(job, true, time(NULL) + 1, "first", 5);
+    CHECK(Results::Cache::lookup(job, output) && output == "first");
+
+    std::ofstream(path, std::ios::app) << " and second";
+    CHECK(!Results::Cache::lookup(job, output));
+
+    // The file was written after the job started, so the output may be half old and half new
+    Results::Cache::store(job, true, time(NULL) - 10, "first and second", 16);
+    CHECK(!Results::Cache::lookup(job, output));
+
+    unlink(path);
+
+}
+
+/**
+ * @brief Runs the tests of the result cache.
+*/
+void Tests::testResultCache(void) {
+
+    testLookup();
+    testLeastRecentlyUsed();
+    testTimeToLive();
+    testInputFiles();
+
+}
@@ -0,0 +1,95 @@
+/* Filename: sha256Tests.cpp */
+
+#include <algorithm>
+#include "unitTests.h"
+#include "../include/sha256.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+namespace Sha = Application_Job_Commander_Client::Application_Sha256;
+
+/**
+ * @brief Supporting function that returns the digest of the given message, given to the hash in
+ * pieces of the given size.
+ * 
+ * @param message the message to hash
+ * @param pieceSize the size of every piece
+ * 
+ * @return the digest of the message
+*/
+static std::string getDigest(const std::string& message, const size_t pieceSize) {
+
+    Sha::Context context;
+    Sha::Digest::init(context);
+
+    for (size_t i = 0; i < message.size(); i += pieceSize) {
+        Sha::Digest::update(context, message.data() + i, std::min(pieceSize, message.size() - i));
+    }
+
+    return Sha::Digest::finish(context);
+
+}
+
+/**
+ * @brief Checks the test vectors of FIPS 180-2.
+*/
+static void testVectors(void) {
+
+    CHECK(getDigest("", 1) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    CHECK(getDigest("abc", 3) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    CHECK(getDigest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56) ==
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    CHECK(getDigest(std::string(1000000, 'a'), 1000000) == "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+
+}
+
+/**
+ * @brief Checks that the digest does not depend on how the message is split, including pieces that
+ * end right at, just before and just after a block and its padding.
+*/
+static void testPieces(void) {
+
+    std::string message;
+    for (unsigned int i = 0; i < 1000; i++) {
+        message += (char)(i * 31);
+    }
+
+    std::string whole = getDigest(message, message.size());
+    CHECK(getDigest(message, 1) == whole);
+    CHECK(getDigest(message, 55) == whole);
+    CHECK(getDigest(message, 56) == whole);
+    CHECK(getDigest(message, 63) == whole);
+    CHECK(getDigest(message, 64) == whole);
+    CHECK(getDigest(message, 65) == whole);
+
+    // The padding takes a block of its own when fewer than 9 bytes of the last block are left
+    CHECK(getDigest(std::string(55, 'a'), 55) == "9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318");
+    CHECK(getDigest(std::string(56, 'a'), 56) == "b35439a4ac6f0948b6d6f9e3c6af0f5f590ce20f1bde7090ef7970686ec6738a");
+    CHECK(getDigest(std::string(64, 'a'), 64) == "ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb");
+
+}
+
+/**
+ * @brief Checks which strings are well formed digests.
+*/
+static void testValidDigests(void) {
+
+    CHECK(Sha::Digest::isValid("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    CHECK(!Sha::Digest::isValid("BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD"));
+    CHECK(!Sha::Digest::isValid("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015a"));
+    CHECK(!Sha::Digest::isValid("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015az"));
+    CHECK(!Sha::Digest::isValid("../../etc/passwd"));
+    CHECK(!Sha::Digest::isValid(""));
+
+}
+
+/**
+ * @brief Runs the tests of the SHA-256 digest.
+*/
+void Tests::testSha256(void) {
+
+    testVectors();
+    testPieces();
+    testValidDigests();
+
+}
@@ -0,0 +1,132 @@
+/* Filename: timerWheelTests.cpp */
+
+#include <ctime>
+#include "unitTests.h"
+#include "../include/timerWheel.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+namespace Timers = Application_Job_Executor_Server::Application_Timer_Wheel;
+
+/**
+ * @brief Supporting function that advances the wheel by the given number of ticks and returns the
+ * ticks, counted from the first one, on which the job with the given job ID became due.
+ * 
+ * @param ticks the number of ticks to advance
+ * @param jobID the job ID to look for, where a firing 'job_N@k' counts as 'job_N'
+ * @param dueJobs the jobs that became due, in order
+ * 
+ * @return the ticks the job became due on
+*/
+static std::vector<unsigned long> advanceBy(const unsigned long ticks, const std::string jobID, std::vector<CC::JobTriplate>& dueJobs) {
+
+    std::vector<unsigned long> dueTicks;
+
+    for (unsigned long tick = 1; tick <= ticks; tick++) {
+
+        std::vector<CC::JobTriplate> due;
+        Timers::Wheel::advance(due);
+
+        for (unsigned int i = 0; i < due.size(); i++) {
+            if (due[i].jobID.compare(0, jobID.size(), jobID) == 0) {
+                dueTicks.push_back(tick);
+            }
+            dueJobs.push_back(due[i]);
+        }
+
+    }
+
+    return dueTicks;
+
+}
+
+/**
+ * @brief Checks that a delayed job becomes due once, on the tick of its start time, on every level
+ * of the wheel. The start time is in seconds, so the job may be due up to a second early if the clock
+ * moves on while it is scheduled.
+*/
+static void testDelayedJobs(void) {
+
+    const unsigned long ticksPerSecond = 1000 / TIMER_TICK_MILLISECONDS;
+    const unsigned long delays[] = { 1, 5, 60, 1000, 30000 };
+
+    for (unsigned int i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+
+        std::string jobID = "job_delayed" + std::to_string(i);
+        CC::JobTriplate triplate = Tests::createTriplate(jobID, "--at +" + std::to_string(delays[i]) + " ls");
+        Timers::Wheel::schedule(triplate);
+
+        std::vector<CC::JobTriplate> dueJobs;
+        std::vector<unsigned long> dueTicks = advanceBy(delays[i] * ticksPerSecond + 1, jobID, dueJobs);
+
+        CHECK(dueTicks.size() == 1);
+        CHECK(dueTicks.size() == 1 && dueTicks[0] <= delays[i] * ticksPerSecond && dueTicks[0] + ticksPerSecond >= delays[i] * ticksPerSecond);
+        CHECK(dueJobs.size() == 1 && dueJobs[0].jobID == jobID && dueJobs[0].options.startTime == 0);
+
+    }
+
+}
+
+/**
+ * @brief Checks that a recurring job becomes due once in every period, as a new job every time.
+*/
+static void testRecurringJobs(void) {
+
+    const unsigned long ticksPerSecond = 1000 / TIMER_TICK_MILLISECONDS;
+
+    CC::JobTriplate triplate = Tests::createTriplate("job_recurring", "--every 2 ls");
+    Timers::Wheel::schedule(triplate);
+
+    std::vector<CC::JobTriplate> dueJobs;
+    std::vector<unsigned long> dueTicks = advanceBy(10 * 2 * ticksPerSecond, "job_recurring", dueJobs);
+
+    CHECK(dueTicks.size() == 10);
+    for (unsigned int i = 1; i < dueTicks.size(); i++) {
+        CHECK(dueTicks[i] - dueTicks[i - 1] == 2 * ticksPerSecond);
+    }
+    for (unsigned int i = 0; i < dueJobs.size(); i++) {
+        CHECK(dueJobs[i].jobID == "job_recurring@" + std::to_string(i + 1) && dueJobs[i].options.period == 0);
+    }
+
+    CC::JobTriplate canceled;
+    CHECK(Timers::Wheel::cancel("job_recurring", canceled) && canceled.jobID == "job_recurring");
+    CHECK(advanceBy(4 * ticksPerSecond, "job_recurring", dueJobs).empty());
+
+}
+
+/**
+ * @brief Checks that canceled jobs never become due, and that the jobs left are all removed.
+*/
+static void testCanceledJobs(void) {
+
+    const unsigned long ticksPerSecond = 1000 / TIMER_TICK_MILLISECONDS;
+
+    Timers::Wheel::schedule(Tests::createTriplate("job_canceled", "--at +3 ls"));
+    Timers::Wheel::schedule(Tests::createTriplate("job_kept", "--at +100 ls"));
+
+    CC::JobTriplate canceled;
+    CHECK(Timers::Wheel::cancel("job_canceled", canceled) && canceled.job == "ls");
+    CHECK(!Timers::Wheel::cancel("job_canceled", canceled));
+    CHECK(!Timers::Wheel::cancel("job_unknown", canceled));
+
+    std::vector<CC::JobTriplate> dueJobs;
+    CHECK(advanceBy(4 * ticksPerSecond, "job_canceled", dueJobs).empty());
+    CHECK(dueJobs.empty());
+
+    std::vector<CC::JobTriplate> removed;
+    Timers::Wheel::removeAll(removed);
+    CHECK(removed.size() == 1 && removed[0].jobID == "job_kept");
+    CHECK(advanceBy(100 * ticksPerSecond, "job_kept", dueJobs).empty());
+
+}
+
+/**
+ * @brief Runs the tests of the timer wheel.
+*/
+void Tests::testTimerWheel(void) {
+
+    testDelayedJobs();
+    testRecurringJobs();
+    testCanceledJobs();
+
+}
@@ -0,0 +1,86 @@
+/* Filename: unitTests.cpp */
+
+#include "unitTests.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+
+// Initialize the static members
+unsigned int Tests::Runner::checks = 0;
+unsigned int Tests::Runner::failures = 0;
+
+/**
+ * @brief Records a check and reports it if it failed.
+ * 
+ * @param passed whether the condition of the check holds
+ * @param condition the condition of the check, as it was written
+ * @param file the file of the check
+ * @param line the line of the check
+*/
+void Tests::Runner::check(const bool passed, const char* condition, const char* file, const int line) {
+
+    Tests::Runner::checks++;
+
+    if (!passed) {
+        Tests::Runner::failures++;
+        std::cout << "    FAILED: " << condition << " (" << file << ":" << line << ")" << std::endl;
+    }
+
+}
+
+/**
+ * @brief Runs a single test and reports its name.
+ * 
+ * @param name the name of the test
+ * @param test the test to run
+*/
+void Tests::Runner::run(const std::string name, void (*test)(void)) {
+
+    std::cout << "Running " << name << std::endl;
+    test();
+
+}
+
+/**
+ * @brief Reports the number of checks that were made and that failed.
+ * 
+ * @return true if every check passed, false otherwise
+*/
+bool Tests::Runner::report(void) {
+
+    std::cout << Tests::Runner::checks << " CHECKS, " << Tests::Runner::failures << " FAILED" << std::endl;
+
+    return Tests::Runner::failures == 0;
+
+}
+
+/**
+ * @brief Creates the triplate of a job, as a controller thread would for the given command.
+ * 
+ * @param jobID the job ID of the job
+ * @param job the job, along with its options
+ * 
+ * @return the triplate of the job
+*/
+CC::JobTriplate Tests::createTriplate(const std::string jobID, std::string job) {
+
+    CC::JobOptions options;
+    parseJobOptions(job, options);
+
+    return { jobID, job, -1, options, false, 0, 0, time(NULL) };
+
+}
+
+int main(void) {
+
+    Tests::Runner::run("LZ codec", Tests::testLzCodec);
+    Tests::Runner::run("SHA-256", Tests::testSha256);
+    Tests::Runner::run("Timer wheel", Tests::testTimerWheel);
+    Tests::Runner::run("Dependency graph", Tests::testDependencyGraph);
+    Tests::Runner::run("Waiting buffer queue", Tests::testWaitingBufferQueue);
+    Tests::Runner::run("Result cache", Tests::testResultCache);
+    Tests::Runner::run("Output reducers", Tests::testOutputReducers);
+
+    return Tests::Runner::report() ? 0 : 1;
+
+}
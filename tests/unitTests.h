@@ -0,0 +1,82 @@
+/* Filename: unitTests.h */
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include "../include/clientCommands.h"
+
+/* Namespace Alias */
+namespace CC = Application_Job_Commander_Client::Application_Client_Commands;
+
+/**
+ * @brief Checks that the given condition holds, and records a failure along with the place of the
+ * check if it does not. The test goes on either way, so that every failure of a run is reported.
+*/
+#define CHECK(condition) Application_Unit_Tests::Runner::check((condition), #condition, __FILE__, __LINE__)
+
+
+namespace Application_Unit_Tests {
+
+    /**
+     * @brief Public Static class that runs the unit tests of the modules of the job executor and
+     * counts the checks that failed.
+     * 
+     * @author Antonis Zikas sdi2100038
+    */
+    class Runner {
+
+    private:
+
+        static unsigned int checks;   // The checks made so far
+        static unsigned int failures; // The checks that failed so far
+
+    public:
+
+        /**
+         * @brief Records a check and reports it if it failed.
+         * 
+         * @param passed whether the condition of the check holds
+         * @param condition the condition of the check, as it was written
+         * @param file the file of the check
+         * @param line the line of the check
+        */
+        static void check(const bool passed, const char* condition, const char* file, const int line);
+
+        /**
+         * @brief Runs a single test and reports its name.
+         * 
+         * @param name the name of the test
+         * @param test the test to run
+        */
+        static void run(const std::string name, void (*test)(void));
+
+        /**
+         * @brief Reports the number of checks that were made and that failed.
+         * 
+         * @return true if every check passed, false otherwise
+        */
+        static bool report(void);
+
+    };
+
+    /**
+     * @brief Creates the triplate of a job, as a controller thread would for the given command.
+     * 
+     * @param jobID the job ID of the job
+     * @param job the job, along with its options
+     * 
+     * @return the triplate of the job
+    */
+    CC::JobTriplate createTriplate(const std::string jobID, std::string job);
+
+    /* The tests of every module */
+    void testLzCodec(void);
+    void testSha256(void);
+    void testTimerWheel(void);
+    void testDependencyGraph(void);
+    void testWaitingBufferQueue(void);
+    void testResultCache(void);
+    void testOutputReducers(void);
+
+}
@@ -0,0 +1,105 @@
+/* Filename: waitingBufferQueueTests.cpp */
+
+#include "unitTests.h"
+#include "../include/waitingBufferQueue.h"
+
+/* namespace alias */
+namespace Tests = Application_Unit_Tests;
+namespace WaitingBuffer = Application_Job_Executor_Server::Application_Common_Waiting_Buffer;
+
+/**
+ * @brief Supporting function that empties the waiting buffer queue.
+*/
+static void emptyQueue(void) {
+
+    while (!WaitingBuffer::Queue::isEmpty()) {
+        WaitingBuffer::Queue::getJobTriplate();
+    }
+
+}
+
+/**
+ * @brief Checks that the jobs released past the capacity keep the queue full, and that no job is
+ * inserted into a full queue, until enough jobs have been taken out.
+*/
+static void testOverfilledQueue(void) {
+
+    WaitingBuffer::Queue::setCapacity(2);
+
+    CHECK(WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_1", "ls")));
+    WaitingBuffer::Queue::appendJobTriplate(Tests::createTriplate("job_2", "ls"));
+    WaitingBuffer::Queue::appendJobTriplate(Tests::createTriplate("job_3", "ls"));
+
+    CHECK(WaitingBuffer::Queue::getSize() == 3 && WaitingBuffer::Queue::isFull());
+    CHECK(!WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_4", "ls")));
+    CHECK(WaitingBuffer::Queue::getSize() == 3);
+
+    CHECK(WaitingBuffer::Queue::getJobTriplate().jobID == "job_1");
+    CHECK(WaitingBuffer::Queue::isFull());
+    CHECK(WaitingBuffer::Queue::getJobTriplate().jobID == "job_2");
+    CHECK(!WaitingBuffer::Queue::isFull());
+    CHECK(WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_5", "ls")));
+    CHECK(WaitingBuffer::Queue::isFull());
+
+    emptyQueue();
+
+}
+
+/**
+ * @brief Checks that the most urgent job is selected among the jobs that fit, the oldest first.
+*/
+static void testFittingJobs(void) {
+
+    WaitingBuffer::Queue::setCapacity(10);
+    WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_low", "--cpus 1 ls"));
+    WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_urgent", "--cpus 2 --priority 5 ls"));
+    WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_urgent_late", "--cpus 1 --priority 5 ls"));
+
+    CC::JobTriplate triplate;
+    CHECK(!WaitingBuffer::Queue::removeFittingJobTriplate(2, 0, false, false, triplate));
+    CHECK(WaitingBuffer::Queue::removeFittingJobTriplate(2, 0, true, false, triplate) && triplate.jobID == "job_urgent");
+    CHECK(WaitingBuffer::Queue::removeFittingJobTriplate(2, 0, true, false, triplate) && triplate.jobID == "job_urgent_late");
+    CHECK(WaitingBuffer::Queue::removeFittingJobTriplate(2, 0, true, false, triplate) && triplate.jobID == "job_low");
+    CHECK(WaitingBuffer::Queue::isEmpty());
+
+}
+
+/**
+ * @brief Checks that a job that does not fit is skipped only so many times, and then no other job
+ * takes the resources that are freed for it.
+*/
+static void testSkippedHeadJob(void) {
+
+    WaitingBuffer::Queue::setCapacity(20);
+    WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_big", "--cpus 4 ls"));
+    for (unsigned int i = 0; i < 12; i++) {
+        WaitingBuffer::Queue::insertJobTriplate(Tests::createTriplate("job_small" + std::to_string(i), "--cpus 1 ls"));
+    }
+
+    // Smaller jobs fill the machine while the big one does not fit, but not forever
+    CC::JobTriplate triplate;
+    unsigned int skips = 0;
+    while (WaitingBuffer::Queue::removeFittingJobTriplate(1, 0, true, false, triplate)) {
+        CHECK(triplate.jobID != "job_big");
+        skips++;
+    }
+    CHECK(skips > 0 && skips < 12);
+
+    // The big job is the first to start once enough resources are free, and then the rest go on
+    CHECK(WaitingBuffer::Queue::removeFittingJobTriplate(4, 0, true, false, triplate) && triplate.jobID == "job_big");
+    CHECK(WaitingBuffer::Queue::removeFittingJobTriplate(1, 0, true, false, triplate) && triplate.jobID != "job_big");
+
+    emptyQueue();
+
+}
+
+/**
+ * @brief Runs the tests of the waiting buffer queue.
+*/
+void Tests::testWaitingBufferQueue(void) {
+
+    testOverfilledQueue();
+    testFittingJobs();
+    testSkippedHeadJob();
+
+}